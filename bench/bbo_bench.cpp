@@ -0,0 +1,1065 @@
+/**
+ * bbo_bench - Replay benchmark for the Project 36 hot path
+ *
+ * Loads a capture into mbufs (classic pcap file, a net_pcap vdev, or a
+ * synthetic feed) and pushes it through DPDKReceiver::inject_burst(), i.e.
+ * the same process_burst() code the poll loop runs, at a configurable rate
+ * and burst shape. No NIC required:
+ *
+ *   sudo ./bbo_bench --no-pci -l 14 -- -f feed.pcap -u 5000 -N -r 2000000
+ *   sudo ./bbo_bench --no-pci -l 14 --vdev=net_pcap0,rx_pcap=feed.pcap -- -I 0 -N
+ *
+ * Reports throughput, hot-path ns/packet and the receiver's per-stage
+ * latency histograms. Also the profiling run for ENABLE_PGO_GENERATE.
+ *
+ * --loopback sends the same frames' payloads over 127.0.0.1 instead and
+ * runs the socket RX backend's poll loop, so the kernel datagram path is
+ * measured against the injection baseline (-k; AF_XDP and the DPDK PMD
+ * need a live NIC, compare those with bbo_stat):
+ *
+ *   sudo ./bbo_bench --no-pci -l 14 -- -k -K 15 -r 1000000
+ */
+
+#include "dpdk_receiver.h"
+#include "likely.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr uint32_t BENCH_MAX_FRAMES = 65536;
+constexpr uint16_t BENCH_MAX_FRAME_LEN = 2048;
+
+// Classic pcap headers (pcapng is not supported)
+struct PcapFileHeader
+{
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+};
+
+struct PcapRecordHeader
+{
+    uint32_t ts_sec;
+    uint32_t ts_frac;
+    uint32_t incl_len;
+    uint32_t orig_len;
+};
+
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4D;
+constexpr uint32_t PCAP_LINKTYPE_ETHERNET = 1;
+
+struct BenchOptions
+{
+    const char *pcap_file = nullptr;
+    int load_port = -1;             // net_pcap vdev port to drain instead of a file
+    uint32_t synthetic_symbols = 64;
+    uint32_t synthetic_frames = 4096;
+    uint64_t packets = 10000000;    // Total packets to inject
+    uint64_t rate_pps = 0;          // 0 = as fast as possible
+    uint16_t burst = 32;
+    bool random_bursts = false;     // Burst sizes uniform in 1..burst
+    uint32_t seed = 1;
+    int warmup = 1000;
+    std::vector<uint16_t> sweep_bursts;     // --sweep: calibration instead of one run
+    std::vector<uint16_t> sweep_rings;      // Modelled RX ring sizes (needs --rate)
+    bool loopback = false;          // --loopback: send over UDP, receive with the socket backend
+    int sender_core = -1;           // Loopback sender CPU (-1 = any but the poll lcore's)
+};
+
+// One calibration point: a burst size against a modelled RX descriptor ring
+struct SweepPoint
+{
+    uint16_t burst = 0;
+    uint16_t ring = 0;              // 0 = not modelled (unpaced)
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;           // Arrivals that found the ring full (imissed)
+    uint64_t ring_full = 0;         // Receiver's ring_buffer_full
+    double seconds = 0.0;
+    uint64_t hot_cycles = 0;
+    ultra_ll::LatencyHistogram wait;    // Arrival -> publish, TSC cycles
+    bool frontier = false;
+};
+
+// "a,b,c" -> values in 1..65535
+bool parse_u16_list(const char *text, std::vector<uint16_t> &out)
+{
+    const char *p = text;
+    while (*p)
+    {
+        char *end = nullptr;
+        const unsigned long v = std::strtoul(p, &end, 10);
+        if (end == p || v == 0 || v > 65535 || (*end != ',' && *end != '\0'))
+        {
+            return false;
+        }
+        out.push_back(static_cast<uint16_t>(v));
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return !out.empty();
+}
+
+// Copy one Ethernet frame into a fresh mbuf
+rte_mbuf *frame_to_mbuf(rte_mempool *pool, const uint8_t *frame, uint32_t len)
+{
+    rte_mbuf *m = rte_pktmbuf_alloc(pool);
+    if (!m)
+    {
+        return nullptr;
+    }
+    char *data = rte_pktmbuf_append(m, static_cast<uint16_t>(len));
+    if (!data)
+    {
+        rte_pktmbuf_free(m);
+        return nullptr;
+    }
+    std::memcpy(data, frame, len);
+    return m;
+}
+
+bool load_pcap_file(const char *path, rte_mempool *pool, std::vector<rte_mbuf *> &frames)
+{
+    FILE *f = std::fopen(path, "rb");
+    if (!f)
+    {
+        std::fprintf(stderr, "Error: Cannot open capture '%s': %s\n", path, std::strerror(errno));
+        return false;
+    }
+
+    PcapFileHeader fh;
+    if (std::fread(&fh, sizeof(fh), 1, f) != 1)
+    {
+        std::fprintf(stderr, "Error: '%s' is too short for a pcap header\n", path);
+        std::fclose(f);
+        return false;
+    }
+
+    const bool swapped = (fh.magic == __builtin_bswap32(PCAP_MAGIC_US) ||
+                          fh.magic == __builtin_bswap32(PCAP_MAGIC_NS));
+    const uint32_t magic = swapped ? __builtin_bswap32(fh.magic) : fh.magic;
+    const uint32_t linktype = swapped ? __builtin_bswap32(fh.linktype) : fh.linktype;
+    if (magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS)
+    {
+        std::fprintf(stderr, "Error: '%s' is not a classic pcap file (pcapng unsupported)\n", path);
+        std::fclose(f);
+        return false;
+    }
+    if (linktype != PCAP_LINKTYPE_ETHERNET)
+    {
+        std::fprintf(stderr, "Error: '%s' link type %u is not Ethernet\n", path, linktype);
+        std::fclose(f);
+        return false;
+    }
+
+    uint8_t buf[BENCH_MAX_FRAME_LEN];
+    uint64_t skipped = 0;
+    PcapRecordHeader rh;
+    while (frames.size() < BENCH_MAX_FRAMES && std::fread(&rh, sizeof(rh), 1, f) == 1)
+    {
+        const uint32_t len = swapped ? __builtin_bswap32(rh.incl_len) : rh.incl_len;
+        if (len > sizeof(buf))
+        {
+            std::fseek(f, len, SEEK_CUR);
+            ++skipped;
+            continue;
+        }
+        if (std::fread(buf, len, 1, f) != 1)
+        {
+            break;  // Truncated last record
+        }
+
+        rte_mbuf *m = frame_to_mbuf(pool, buf, len);
+        if (!m)
+        {
+            std::fprintf(stderr, "Error: Bench mbuf pool exhausted at frame %zu\n", frames.size());
+            std::fclose(f);
+            return false;
+        }
+        frames.push_back(m);
+    }
+    std::fclose(f);
+
+    if (skipped > 0)
+    {
+        std::fprintf(stderr, "Warning: Skipped %lu frames larger than %u bytes\n",
+                     skipped, BENCH_MAX_FRAME_LEN);
+    }
+    return true;
+}
+
+// Drain a net_pcap (or any) port until it stops returning packets
+bool load_from_port(uint16_t port_id, rte_mempool *pool, std::vector<rte_mbuf *> &frames)
+{
+    rte_eth_conf port_conf{};
+    int ret = rte_eth_dev_configure(port_id, 1, 0, &port_conf);
+    if (ret == 0)
+    {
+        ret = rte_eth_rx_queue_setup(port_id, 0, ultra_ll::RX_RING_SIZE,
+                                     rte_eth_dev_socket_id(port_id), nullptr, pool);
+    }
+    if (ret == 0)
+    {
+        ret = rte_eth_dev_start(port_id);
+    }
+    if (ret != 0)
+    {
+        std::fprintf(stderr, "Error: Failed to start capture port %u: %s\n",
+                     port_id, rte_strerror(-ret));
+        return false;
+    }
+
+    rte_mbuf *pkts[ultra_ll::BURST_SIZE];
+    int idle = 0;
+    while (frames.size() < BENCH_MAX_FRAMES && idle < 1000)
+    {
+        const uint16_t n = rte_eth_rx_burst(port_id, 0, pkts, ultra_ll::BURST_SIZE);
+        if (n == 0)
+        {
+            ++idle;
+            continue;
+        }
+        idle = 0;
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            pkts[i]->ol_flags = 0;  // Replay as plain frames
+            if (frames.size() < BENCH_MAX_FRAMES)
+            {
+                frames.push_back(pkts[i]);
+            }
+            else
+            {
+                rte_pktmbuf_free(pkts[i]);
+            }
+        }
+    }
+
+    rte_eth_dev_stop(port_id);
+    return true;
+}
+
+// Synthetic feed: round-robin symbols, random-walk prices, full 44-byte BBOs
+bool load_synthetic(const BenchOptions &opt, uint16_t udp_port, rte_mempool *pool,
+                    std::vector<rte_mbuf *> &frames)
+{
+    constexpr size_t ETH_SIZE = sizeof(rte_ether_hdr);
+    constexpr size_t IP_SIZE = sizeof(rte_ipv4_hdr);
+    constexpr size_t UDP_SIZE = sizeof(rte_udp_hdr);
+    constexpr size_t TOTAL_SIZE = ETH_SIZE + IP_SIZE + UDP_SIZE + ultra_ll::BBO_FULL_SIZE;
+
+    uint32_t rng = opt.seed | 1;
+    auto next = [&rng]()
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    std::vector<uint32_t> mid(opt.synthetic_symbols, 1500000);  // $150.0000
+    uint32_t fpga_clock = 0;
+
+    for (uint32_t i = 0; i < opt.synthetic_frames && frames.size() < BENCH_MAX_FRAMES; ++i)
+    {
+        uint8_t frame[TOTAL_SIZE] = {};
+
+        auto *eth = reinterpret_cast<rte_ether_hdr *>(frame);
+        eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+        auto *ip = reinterpret_cast<rte_ipv4_hdr *>(frame + ETH_SIZE);
+        ip->version_ihl = 0x45;
+        ip->total_length = rte_cpu_to_be_16(IP_SIZE + UDP_SIZE + ultra_ll::BBO_FULL_SIZE);
+        ip->next_proto_id = IPPROTO_UDP;
+
+        auto *udp = reinterpret_cast<rte_udp_hdr *>(frame + ETH_SIZE + IP_SIZE);
+        udp->dst_port = rte_cpu_to_be_16(udp_port);
+        udp->dgram_len = rte_cpu_to_be_16(UDP_SIZE + ultra_ll::BBO_FULL_SIZE);
+
+        uint8_t *bbo = frame + ETH_SIZE + IP_SIZE + UDP_SIZE;
+        const uint32_t sym = i % opt.synthetic_symbols;
+        std::snprintf(reinterpret_cast<char *>(bbo), 9, "S%06u ", sym);
+
+        mid[sym] += (next() % 201) - 100;
+        const uint32_t spread = 100 + next() % 900;
+        const uint32_t fields[5] = {
+            mid[sym] - spread / 2, 100 * (1 + next() % 50),
+            mid[sym] - spread / 2 + spread, 100 * (1 + next() % 50),
+            spread};
+        for (int k = 0; k < 5; ++k)
+        {
+            const uint32_t be = __builtin_bswap32(fields[k]);
+            std::memcpy(bbo + 8 + 4 * k, &be, 4);
+        }
+
+        // T1..T4 at 125 MHz with a few cycles per FPGA stage
+        fpga_clock += 50 + next() % 50;
+        const uint32_t ts[4] = {fpga_clock, fpga_clock + 20 + next() % 8,
+                                fpga_clock + 40 + next() % 8, fpga_clock + 50 + next() % 8};
+        for (int k = 0; k < 4; ++k)
+        {
+            const uint32_t be = __builtin_bswap32(ts[k]);
+            std::memcpy(bbo + ultra_ll::T1_OFFSET + 4 * k, &be, 4);
+        }
+
+        rte_mbuf *m = frame_to_mbuf(pool, frame, TOTAL_SIZE);
+        if (!m)
+        {
+            return false;
+        }
+        frames.push_back(m);
+    }
+    return true;
+}
+
+// Native ring consumer, standing in for the downstream process
+void drain_native_ring(const std::string &shm_name, const std::string &hugepage_dir,
+                       std::atomic<bool> &run, std::atomic<uint64_t> &consumed)
+{
+    ultra_ll::ShmBacking backing;
+    if (!backing.init(hugepage_dir))
+    {
+        return;
+    }
+    const std::string name = "/bbo_fast_" + shm_name;
+    int fd = backing.open(name, O_RDWR);
+    if (fd == -1)
+    {
+        std::fprintf(stderr, "Warning: Consumer cannot open '%s'\n", backing.path(name).c_str());
+        return;
+    }
+    const size_t bytes = backing.round(sizeof(ultra_ll::BboFastRing));
+    void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+    {
+        return;
+    }
+
+    auto *ring = static_cast<ultra_ll::BboFastRing *>(ptr);
+    uint64_t n = 0;
+    while (run.load(std::memory_order_relaxed))
+    {
+        if (ring->peek())
+        {
+            ring->advance();
+            ++n;
+        }
+    }
+    while (ring->peek())
+    {
+        ring->advance();
+        ++n;
+    }
+    consumed.store(n, std::memory_order_relaxed);
+    munmap(ptr, bytes);
+}
+
+// Loopback sender: the frames' UDP payloads to 127.0.0.1:udp_port with
+// sendmmsg(), paced like the injection loop. Returns the seconds spent.
+double send_loopback(const std::vector<rte_mbuf *> &frames, const BenchOptions &opt,
+                     uint16_t udp_port, double cycles_per_pkt, double tsc_hz,
+                     std::atomic<uint64_t> &sent)
+{
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (opt.sender_core >= 0)
+    {
+        CPU_SET(opt.sender_core, &cpuset);
+    }
+    else
+    {
+        // Inherited the poll lcore's affinity: move off it
+        const int poll_cpu = sched_getcpu();
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long c = 0; c < cpus && c < CPU_SETSIZE; ++c)
+        {
+            if (c != poll_cpu)
+            {
+                CPU_SET(c, &cpuset);
+            }
+        }
+    }
+    if (CPU_COUNT(&cpuset) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0)
+    {
+        std::fprintf(stderr, "Warning: Loopback sender shares the poll core\n");
+    }
+
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    dst.sin_port = htons(udp_port);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&dst), sizeof(dst)) != 0)
+    {
+        std::fprintf(stderr, "Error: Loopback sender socket: %s\n", std::strerror(errno));
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return 0.0;
+    }
+
+    mmsghdr msgs[ultra_ll::MAX_BURST_SIZE] = {};
+    iovec iov[ultra_ll::MAX_BURST_SIZE];
+    size_t cursor = 0;
+    uint64_t total = 0;
+
+    const uint64_t start = rdtscp();
+    double deadline = static_cast<double>(start);
+    while (total < opt.packets)
+    {
+        uint16_t n = static_cast<uint16_t>(std::min<uint64_t>(opt.burst, opt.packets - total));
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            const rte_mbuf *m = frames[cursor];
+            if (++cursor == frames.size())
+            {
+                cursor = 0;
+            }
+            const size_t hdr = ultra_ll::SocketRx::HEADERS_SIZE;
+            iov[i].iov_base = rte_pktmbuf_mtod_offset(m, uint8_t *, hdr);
+            iov[i].iov_len = m->data_len > hdr ? m->data_len - hdr : 0;
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        if (cycles_per_pkt > 0)
+        {
+            deadline += cycles_per_pkt * n;
+            while (static_cast<double>(rdtsc()) < deadline)
+            {
+                __builtin_ia32_pause();
+            }
+        }
+
+        // Loopback never backpressures a UDP sender: overruns are drops
+        // at the receiver's socket buffer
+        const int done = sendmmsg(fd, msgs, n, 0);
+        if (done <= 0)
+        {
+            std::fprintf(stderr, "Error: sendmmsg: %s\n", std::strerror(errno));
+            break;
+        }
+        total += static_cast<uint64_t>(done);
+        sent.store(total, std::memory_order_relaxed);
+    }
+    const uint64_t elapsed = rdtscp() - start;
+    ::close(fd);
+    return static_cast<double>(elapsed) / tsc_hz;
+}
+
+// Socket backend end to end: sender thread -> loopback -> poll_loop()
+int run_loopback(ultra_ll::DPDKReceiver &receiver, const std::vector<rte_mbuf *> &frames,
+                 const BenchOptions &opt, uint16_t udp_port, double cycles_per_pkt)
+{
+    std::printf("Sending %lu packets over loopback UDP port %u, bursts of %u, %s\n",
+                opt.packets, udp_port, opt.burst, opt.rate_pps ? "paced" : "unpaced");
+
+    const double tsc_hz = receiver.get_tsc().get_ghz() * 1e9;
+    std::atomic<uint64_t> sent{0};
+    double send_seconds = 0.0;
+    std::thread sender([&]
+    {
+        send_seconds = send_loopback(frames, opt, udp_port, cycles_per_pkt, tsc_hz, sent);
+        // Let the receiver drain its socket buffer
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        receiver.stop();
+    });
+
+    receiver.poll_loop();
+    sender.join();
+
+    const uint64_t total_sent = sent.load(std::memory_order_relaxed);
+    const uint64_t received = receiver.get_stats().packets_received.load();
+    std::printf("\n=== bbo_bench (loopback socket) ===\n");
+    std::printf("  Sent:              %lu in %.3f s\n", total_sent, send_seconds);
+    std::printf("  Received:          %lu (%lu lost in the socket buffer)\n", received,
+                total_sent > received ? total_sent - received : 0);
+    if (send_seconds > 0)
+    {
+        std::printf("  Throughput:        %.3f Mpps\n",
+                    static_cast<double>(received) / send_seconds / 1e6);
+    }
+    receiver.print_stats();
+    return total_sent == opt.packets ? 0 : 1;
+}
+
+// Replay `packets` frames as a NIC would deliver them at a fixed rate:
+// arrivals enter a ring of p.ring descriptors (dropped when it is full, as
+// imissed), each poll takes up to p.burst of them. Unpaced, every poll
+// finds a full burst and the wait is the service time alone.
+void run_sweep_point(ultra_ll::DPDKReceiver &receiver, const std::vector<rte_mbuf *> &frames,
+                     size_t &cursor, uint64_t packets, double cycles_per_pkt, SweepPoint &p)
+{
+    std::vector<uint64_t> ring(p.ring ? p.ring : p.burst);     // Arrival TSC per descriptor
+    size_t ring_head = 0;
+    size_t ring_used = 0;
+    uint64_t next_arrival = 0;      // Index of the next packet to arrive
+    rte_mbuf *burst[ultra_ll::MAX_BURST_SIZE];
+
+    receiver.reset_stats();
+    const uint64_t start = rdtscp();
+
+    while (p.delivered + p.dropped < packets)
+    {
+        const uint64_t now = rdtsc();
+
+        // Arrivals since the last poll
+        uint64_t arrived = packets;
+        if (cycles_per_pkt > 0.0)
+        {
+            arrived = std::min<uint64_t>(packets,
+                                         static_cast<uint64_t>((now - start) / cycles_per_pkt) + 1);
+        }
+        else
+        {
+            arrived = std::min<uint64_t>(packets, next_arrival + p.burst - ring_used);
+        }
+        for (; next_arrival < arrived; ++next_arrival)
+        {
+            if (ring_used == ring.size())
+            {
+                ++p.dropped;
+                continue;
+            }
+            const uint64_t at = cycles_per_pkt > 0.0
+                ? start + static_cast<uint64_t>(static_cast<double>(next_arrival) * cycles_per_pkt)
+                : now;
+            ring[(ring_head + ring_used) % ring.size()] = at;
+            ++ring_used;
+        }
+
+        const uint16_t n = static_cast<uint16_t>(std::min<size_t>(ring_used, p.burst));
+        if (n == 0)
+        {
+            __builtin_ia32_pause();
+            continue;
+        }
+
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            burst[i] = frames[cursor];
+            rte_mbuf_refcnt_update(burst[i], 1);
+            if (++cursor == frames.size())
+            {
+                cursor = 0;
+            }
+        }
+
+        const uint64_t t0 = rdtsc();
+        receiver.inject_burst(0, burst, n);
+        const uint64_t done = rdtsc();
+        p.hot_cycles += done - t0;
+
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            p.wait.record(done - ring[ring_head]);
+            ring_head = (ring_head + 1) % ring.size();
+        }
+        ring_used -= n;
+        p.delivered += n;
+    }
+
+    p.seconds = static_cast<double>(rdtscp() - start) / (receiver.get_tsc().get_ghz() * 1e9);
+    p.ring_full = receiver.get_stats(0).ring_buffer_full.load();
+}
+
+// Latency/throughput frontier: a point is on it unless another point drops
+// no more, publishes no slower and has a lower or equal p99 (one strictly)
+void mark_frontier(std::vector<SweepPoint> &points)
+{
+    for (SweepPoint &p : points)
+    {
+        const double p_rate = static_cast<double>(p.delivered) / p.seconds;
+        const uint64_t p_p99 = p.wait.value_at_percentile(99.0);
+        p.frontier = true;
+        for (const SweepPoint &o : points)
+        {
+            const double o_rate = static_cast<double>(o.delivered) / o.seconds;
+            const uint64_t o_p99 = o.wait.value_at_percentile(99.0);
+            const bool no_worse = o.dropped <= p.dropped && o_rate >= p_rate && o_p99 <= p_p99;
+            const bool better = o.dropped < p.dropped || o_rate > p_rate || o_p99 < p_p99;
+            if (&o != &p && no_worse && better)
+            {
+                p.frontier = false;
+                break;
+            }
+        }
+    }
+}
+
+int run_sweep(ultra_ll::DPDKReceiver &receiver, const std::vector<rte_mbuf *> &frames,
+              const BenchOptions &opt, double cycles_per_pkt)
+{
+    std::vector<uint16_t> rings = opt.sweep_rings;
+    if (rings.empty())
+    {
+        rings.push_back(opt.rate_pps ? ultra_ll::RX_RING_SIZE : 0);
+    }
+
+    std::vector<SweepPoint> points;
+    points.reserve(opt.sweep_bursts.size() * rings.size());
+    size_t cursor = 0;
+    for (uint16_t b : opt.sweep_bursts)
+    {
+        for (uint16_t r : rings)
+        {
+            points.emplace_back();
+            SweepPoint &p = points.back();
+            p.burst = b;
+            p.ring = r;
+            run_sweep_point(receiver, frames, cursor, opt.packets, cycles_per_pkt, p);
+            std::printf("  burst %2u ring %5u: %.3f Mpps, %lu dropped\n", b, r,
+                        static_cast<double>(p.delivered) / p.seconds / 1e6, p.dropped);
+        }
+    }
+    mark_frontier(points);
+
+    const auto &tsc = receiver.get_tsc();
+    std::printf("\n=== Burst / RX ring sweep (%lu packets per point, %s) ===\n", opt.packets,
+                opt.rate_pps ? "paced" : "unpaced");
+    std::printf("  burst  ring     Mpps   drop %%   ns/pkt  wait p50   p99  p99.9   ring full\n");
+    for (const SweepPoint &p : points)
+    {
+        const uint64_t offered = p.delivered + p.dropped;
+        std::printf("%c %5u %5u %8.3f %8.4f %8.1f %9lu %5lu %6lu %11lu\n",
+                    p.frontier ? '*' : ' ', p.burst, p.ring,
+                    static_cast<double>(p.delivered) / p.seconds / 1e6,
+                    offered ? 100.0 * static_cast<double>(p.dropped) / offered : 0.0,
+                    p.delivered ? static_cast<double>(tsc.cycles_to_ns(p.hot_cycles)) /
+                                      static_cast<double>(p.delivered) : 0.0,
+                    tsc.cycles_to_ns(p.wait.value_at_percentile(50.0)),
+                    tsc.cycles_to_ns(p.wait.value_at_percentile(99.0)),
+                    tsc.cycles_to_ns(p.wait.value_at_percentile(99.9)),
+                    p.ring_full);
+    }
+    std::printf("  * = on the frontier (no other point is at least as good on drops, "
+                "rate and p99)\n");
+    std::printf("  Apply with network_handler -- -z <burst> -r <ring>\n");
+    return 0;
+}
+
+void print_usage(const char *prog)
+{
+    std::printf(
+        "bbo_bench - Project 36 hot-path replay benchmark\n"
+        "\n"
+        "Usage: %s [DPDK_EAL_OPTIONS] -- [OPTIONS]\n"
+        "\n"
+        "Input (default: synthetic feed):\n"
+        "  -f, --pcap <file>      Classic pcap capture (Ethernet link type)\n"
+        "  -I, --load-port <id>   Drain frames from a port, e.g. --vdev=net_pcap0,rx_pcap=<file>\n"
+        "  -Y, --symbols <n>      Synthetic symbols (default: 64)\n"
+        "  -F, --frames <n>       Synthetic frames (default: 4096)\n"
+        "\n"
+        "Replay:\n"
+        "  -n, --packets <n>      Packets to inject, capture is looped (default: 10000000)\n"
+        "  -r, --rate <pps>       Target rate, 0 = as fast as possible (default: 0)\n"
+        "  -b, --burst <n>        Burst size 1..%u (default: %u)\n"
+        "  -j, --random-bursts    Uniform burst sizes in 1..burst\n"
+        "  -x, --seed <n>         Seed for synthetic feed and burst shape (default: 1)\n"
+        "  -w, --warmup <count>   Warm-up packet count, 0 = none (default: 1000)\n"
+        "  -k, --loopback         Send over 127.0.0.1 and receive with the socket backend\n"
+        "                         (recvmmsg + SO_BUSY_POLL) instead of injecting\n"
+        "  -K, --sender-core <n>  CPU of the loopback sender (default: any but the poll core)\n"
+        "\n"
+        "Calibration:\n"
+        "  -z, --sweep <b,..>[/<r,..>] Run every burst size against every RX ring size\n"
+        "                         (rings need --rate: arrivals beyond a full ring are\n"
+        "                         dropped) and print the latency/throughput frontier\n"
+        "\n"
+        "Receiver (as network_handler):\n"
+        "  -u, --udp-port <port>  UDP port the frames are addressed to (default: 12345)\n"
+        "  -s, --shm <name>       Shared memory name (default: bbo_bench)\n"
+        "  -H, --hugepage-dir <d> Rings on this hugetlbfs mount (e.g. /dev/hugepages)\n"
+        "  -N, --native           Native ring, drained by a consumer thread\n"
+        "  -B, --batch            With -N: one ring commit per burst\n"
+        "  -C, --conflate         Conflation cache\n"
+        "  -V, --simd [isa]       Vectorized burst parser, optional ISA cap\n"
+        "  -h, --help             Show this help\n"
+        "\n",
+        prog, ultra_ll::MAX_BURST_SIZE, ultra_ll::BURST_SIZE);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    ultra_ll::DPDKReceiver::Config config;
+    config.replay = true;
+    config.latency_histograms = true;
+    config.shm_name = "bbo_bench";
+    BenchOptions opt;
+
+    int dpdk_argc = argc;
+    int separator_idx = -1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--") == 0)
+        {
+            separator_idx = i;
+            dpdk_argc = i;
+            break;
+        }
+    }
+
+    if (separator_idx > 0)
+    {
+        static struct option long_options[] = {
+            {"pcap", required_argument, 0, 'f'},
+            {"load-port", required_argument, 0, 'I'},
+            {"symbols", required_argument, 0, 'Y'},
+            {"frames", required_argument, 0, 'F'},
+            {"packets", required_argument, 0, 'n'},
+            {"rate", required_argument, 0, 'r'},
+            {"burst", required_argument, 0, 'b'},
+            {"random-bursts", no_argument, 0, 'j'},
+            {"seed", required_argument, 0, 'x'},
+            {"warmup", required_argument, 0, 'w'},
+            {"loopback", no_argument, 0, 'k'},
+            {"sender-core", required_argument, 0, 'K'},
+            {"sweep", required_argument, 0, 'z'},
+            {"udp-port", required_argument, 0, 'u'},
+            {"shm", required_argument, 0, 's'},
+            {"hugepage-dir", required_argument, 0, 'H'},
+            {"native", no_argument, 0, 'N'},
+            {"batch", no_argument, 0, 'B'},
+            {"conflate", no_argument, 0, 'C'},
+            {"simd", optional_argument, 0, 'V'},
+            {"help", no_argument, 0, 'h'},
+            {0, 0, 0, 0}};
+
+        int opt_argc = argc - separator_idx;
+        char **opt_argv = argv + separator_idx;
+        int o;
+        optind = 1;
+        while ((o = getopt_long(opt_argc, opt_argv, "f:I:Y:F:n:r:b:jx:w:kK:z:u:s:H:NBCV::h",
+                                long_options, nullptr)) != -1)
+        {
+            switch (o)
+            {
+            case 'f':
+                opt.pcap_file = optarg;
+                break;
+            case 'I':
+                opt.load_port = std::atoi(optarg);
+                break;
+            case 'Y':
+                opt.synthetic_symbols = static_cast<uint32_t>(std::clamp(std::atoi(optarg), 1, 999999));
+                break;
+            case 'F':
+                opt.synthetic_frames = static_cast<uint32_t>(std::max(1, std::atoi(optarg)));
+                break;
+            case 'n':
+                opt.packets = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'r':
+                opt.rate_pps = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'b':
+                opt.burst = static_cast<uint16_t>(std::atoi(optarg));
+                break;
+            case 'j':
+                opt.random_bursts = true;
+                break;
+            case 'x':
+                opt.seed = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'w':
+                opt.warmup = std::atoi(optarg);
+                break;
+            case 'k':
+                opt.loopback = true;
+                break;
+            case 'K':
+                opt.sender_core = std::atoi(optarg);
+                break;
+            case 'z':
+            {
+                // bursts[/rings]
+                std::string spec = optarg;
+                const size_t slash = spec.find('/');
+                const bool ok = parse_u16_list(spec.substr(0, slash).c_str(), opt.sweep_bursts) &&
+                                (slash == std::string::npos ||
+                                 parse_u16_list(spec.c_str() + slash + 1, opt.sweep_rings));
+                if (!ok)
+                {
+                    std::fprintf(stderr, "Error: Invalid sweep '%s' (e.g. 8,16,32/512,1024)\n",
+                                 optarg);
+                    return 1;
+                }
+                break;
+            }
+            case 'u':
+                config.udp_port = static_cast<uint16_t>(std::atoi(optarg));
+                break;
+            case 's':
+                config.shm_name = optarg;
+                break;
+            case 'H':
+                config.hugepage_dir = optarg;
+                break;
+            case 'N':
+                config.publish_mode = ultra_ll::PublishMode::NATIVE;
+                break;
+            case 'B':
+                config.batch_publish = true;
+                break;
+            case 'C':
+                config.conflate = true;
+                break;
+            case 'V':
+                config.simd_parse = true;
+                if (optarg)
+                {
+                    if (std::strcmp(optarg, "scalar") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::SCALAR;
+                    else if (std::strcmp(optarg, "sse4") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::SSE4;
+                    else if (std::strcmp(optarg, "avx2") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::AVX2;
+                    else if (std::strcmp(optarg, "avx512") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::AVX512;
+                    else
+                    {
+                        std::fprintf(stderr, "Error: Unknown SIMD ISA '%s'\n", optarg);
+                        return 1;
+                    }
+                }
+                break;
+            case 'h':
+            default:
+                print_usage(argv[0]);
+                return (o == 'h') ? 0 : 1;
+            }
+        }
+    }
+
+    if (opt.burst == 0 || opt.burst > ultra_ll::MAX_BURST_SIZE)
+    {
+        std::fprintf(stderr, "Error: Burst size must be 1..%u\n", ultra_ll::MAX_BURST_SIZE);
+        return 1;
+    }
+    for (uint16_t b : opt.sweep_bursts)
+    {
+        if (b > ultra_ll::MAX_BURST_SIZE)
+        {
+            std::fprintf(stderr, "Error: Sweep burst %u exceeds %u\n", b, ultra_ll::MAX_BURST_SIZE);
+            return 1;
+        }
+    }
+    if (!opt.sweep_rings.empty() && opt.rate_pps == 0)
+    {
+        std::fprintf(stderr, "Error: Sweeping RX ring sizes needs a rate (-r): "
+                     "unpaced, the ring never fills\n");
+        return 1;
+    }
+    if (opt.loopback)
+    {
+        if (!opt.sweep_bursts.empty() || opt.random_bursts)
+        {
+            std::fprintf(stderr, "Error: --loopback sends fixed bursts (no -z, -j)\n");
+            return 1;
+        }
+        // A live receive path: the socket backend instead of injection
+        config.replay = false;
+        config.backend.backend = ultra_ll::RxBackend::SOCKET;
+        config.burst_size = opt.burst;
+    }
+
+    ultra_ll::DPDKReceiver receiver(config);
+    if (!receiver.initialize(dpdk_argc, argv))
+    {
+        std::fprintf(stderr, "Error: Failed to initialize receiver\n");
+        return 1;
+    }
+
+    // Frames stay resident: each injection takes an extra reference, which
+    // the hot path's free drops again
+    rte_mempool *pool = rte_pktmbuf_pool_create("BENCH_POOL", BENCH_MAX_FRAMES + 1023, 256, 0,
+                                                RTE_PKTMBUF_HEADROOM + BENCH_MAX_FRAME_LEN,
+                                                rte_socket_id());
+    if (!pool)
+    {
+        std::fprintf(stderr, "Error: Failed to create bench mbuf pool: %s\n",
+                     rte_strerror(rte_errno));
+        return 1;
+    }
+
+    std::vector<rte_mbuf *> frames;
+    frames.reserve(BENCH_MAX_FRAMES);
+    bool loaded;
+    if (opt.pcap_file)
+    {
+        loaded = load_pcap_file(opt.pcap_file, pool, frames);
+    }
+    else if (opt.load_port >= 0)
+    {
+        loaded = load_from_port(static_cast<uint16_t>(opt.load_port), pool, frames);
+    }
+    else
+    {
+        loaded = load_synthetic(opt, config.udp_port, pool, frames);
+    }
+    if (!loaded || frames.empty())
+    {
+        std::fprintf(stderr, "Error: No frames to replay\n");
+        return 1;
+    }
+    std::printf("Loaded %zu frames\n", frames.size());
+
+    std::atomic<bool> consumer_run{true};
+    std::atomic<uint64_t> consumed{0};
+    std::thread consumer;
+    if (config.publish_mode == ultra_ll::PublishMode::NATIVE)
+    {
+        consumer = std::thread(drain_native_ring, config.shm_name, config.hugepage_dir,
+                               std::ref(consumer_run), std::ref(consumed));
+    }
+    else
+    {
+        std::printf("Note: gateway ring '%s' needs an external consumer, "
+                    "otherwise it fills and counts ring_buffer_full\n", config.shm_name.c_str());
+    }
+
+    if (opt.warmup > 0)
+    {
+        receiver.warm_up(opt.warmup);
+    }
+    receiver.reset_stats();
+
+    const double tsc_hz = receiver.get_tsc().get_ghz() * 1e9;
+    const double cycles_per_pkt = opt.rate_pps ? tsc_hz / static_cast<double>(opt.rate_pps) : 0.0;
+
+    if (!opt.sweep_bursts.empty() || opt.loopback)
+    {
+        const int rc = opt.loopback
+            ? run_loopback(receiver, frames, opt, config.udp_port, cycles_per_pkt)
+            : run_sweep(receiver, frames, opt, cycles_per_pkt);
+        consumer_run.store(false, std::memory_order_relaxed);
+        if (consumer.joinable())
+        {
+            consumer.join();
+        }
+        for (rte_mbuf *m : frames)
+        {
+            rte_pktmbuf_free(m);
+        }
+        return rc;
+    }
+
+    std::printf("Replaying %lu packets, %s bursts of %s%u, %s\n",
+                opt.packets, opt.random_bursts ? "random" : "fixed",
+                opt.random_bursts ? "1.." : "", opt.burst,
+                opt.rate_pps ? "paced" : "unpaced");
+
+    uint32_t rng = opt.seed | 1;
+    rte_mbuf *burst[ultra_ll::MAX_BURST_SIZE];
+    size_t cursor = 0;
+    uint64_t injected = 0;
+    uint64_t hot_cycles = 0;
+    uint64_t late_bursts = 0;
+
+    const uint64_t start = rdtscp();
+    double deadline = static_cast<double>(start);
+
+    while (injected < opt.packets)
+    {
+        uint16_t n = opt.burst;
+        if (opt.random_bursts)
+        {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            n = static_cast<uint16_t>(1 + rng % opt.burst);
+        }
+        if (n > opt.packets - injected)
+        {
+            n = static_cast<uint16_t>(opt.packets - injected);
+        }
+
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            burst[i] = frames[cursor];
+            rte_mbuf_refcnt_update(burst[i], 1);
+            if (++cursor == frames.size())
+            {
+                cursor = 0;
+            }
+        }
+
+        // Open-loop pacing: the burst is due once its packets have "arrived"
+        if (opt.rate_pps)
+        {
+            deadline += cycles_per_pkt * n;
+            if (static_cast<double>(rdtsc()) > deadline)
+            {
+                ++late_bursts;
+            }
+            while (static_cast<double>(rdtsc()) < deadline)
+            {
+                __builtin_ia32_pause();
+            }
+        }
+
+        const uint64_t t0 = rdtsc();
+        receiver.inject_burst(0, burst, n);
+        hot_cycles += rdtsc() - t0;
+
+        injected += n;
+    }
+
+    const uint64_t elapsed = rdtscp() - start;
+
+    consumer_run.store(false, std::memory_order_relaxed);
+    if (consumer.joinable())
+    {
+        consumer.join();
+    }
+
+    const double seconds = static_cast<double>(elapsed) / tsc_hz;
+    std::printf("\n=== bbo_bench ===\n");
+    std::printf("  Packets:           %lu in %.3f s\n", injected, seconds);
+    std::printf("  Throughput:        %.3f Mpps\n", static_cast<double>(injected) / seconds / 1e6);
+    std::printf("  Hot path:          %.1f ns/packet\n",
+                static_cast<double>(receiver.get_tsc().cycles_to_ns(hot_cycles)) /
+                    static_cast<double>(injected));
+    if (opt.rate_pps)
+    {
+        std::printf("  Late bursts:       %lu (target %lu pps)\n", late_bursts, opt.rate_pps);
+    }
+    if (config.publish_mode == ultra_ll::PublishMode::NATIVE)
+    {
+        std::printf("  Consumed:          %lu\n", consumed.load(std::memory_order_relaxed));
+    }
+    receiver.print_stats();
+
+    for (rte_mbuf *m : frames)
+    {
+        rte_pktmbuf_free(m);
+    }
+    return 0;
+}
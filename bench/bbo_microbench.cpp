@@ -0,0 +1,664 @@
+/**
+ * bbo_microbench - Per-component microbenchmarks for the Project 36 hot path
+ *
+ * Times each building block of the receive path in isolation on the
+ * calling core. No NIC, no EAL:
+ * - BBOParserFast::parse on valid, short (rejected) and full-timestamp payloads,
+ *   and with FPGA deltas packed
+ * - BBOPool::acquire, with and without hugepages, at L2 and at dTLB-bound sizes;
+ *   OWNED acquire + fill + publish against a reader thread, which must never
+ *   accept a torn entry (exit status 1 if it does)
+ * - the gateway::BBOData conversion behind convert_and_publish()
+ * - rdtsc / rdtscp / cycles_to_ns / tsc_to_ns (clock_gettime for reference)
+ * - native ring publish against a consumer thread on another core
+ *
+ *   ./bbo_microbench -c 14 -C 15
+ *   ./bbo_microbench -c 14 -f parse -n 10000000
+ *
+ * Every case reports the best of its repetitions as TSC cycles per op
+ * (ScopedTimer around the whole loop) and ns per op. It also reports L1D
+ * read misses, branch misses and instructions per op from perf_event_open,
+ * counting this thread in user space only. That needs
+ * kernel.perf_event_paranoid <= 2, and the columns print n/a without it.
+ * Run it before and after a parser or pool change.
+ */
+
+#include "dpdk_receiver.h"
+#include "likely.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <immintrin.h>
+
+namespace
+{
+
+constexpr size_t PAYLOADS = 256;            // Distinct payloads cycled through (power of 2)
+constexpr uint32_t RING_BATCH = 32;         // claim_batch() size, as one rx burst
+
+struct MicroOptions
+{
+    uint64_t ops = 1000000;         // Ops per repetition
+    int reps = 5;                   // Repetitions, best one reported
+    const char *filter = nullptr;   // Substring of the case names to run
+    int core = -1;                  // Pin the benchmark thread
+    int consumer_core = -1;         // Pin the ring consumer thread
+};
+
+// Keep a result alive without a store the compiler could sink out of the loop
+template<typename T>
+FORCE_INLINE void keep(const T &value)
+{
+    __asm__ volatile("" : : "r,m"(value) : "memory");
+}
+
+bool pin_thread(int core, const char *what)
+{
+    if (core < 0)
+    {
+        return true;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0)
+    {
+        std::fprintf(stderr, "Warning: Failed to pin %s to core %d\n", what, core);
+        return false;
+    }
+    return true;
+}
+
+// Per-thread hardware counters (user space only), one fd per event so
+// that a PMU lacking one event still reports the others
+class PerfCounters
+{
+public:
+    enum Counter
+    {
+        L1D_MISSES,
+        BRANCH_MISSES,
+        INSTRUCTIONS,
+        NUM_COUNTERS
+    };
+
+    PerfCounters()
+    {
+        fds_[L1D_MISSES] = open_event(PERF_TYPE_HW_CACHE,
+                                      PERF_COUNT_HW_CACHE_L1D |
+                                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        fds_[BRANCH_MISSES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds_[INSTRUCTIONS] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        if (!available(L1D_MISSES) && !available(BRANCH_MISSES) && !available(INSTRUCTIONS))
+        {
+            std::fprintf(stderr, "Warning: perf counters unavailable (%s), "
+                         "check kernel.perf_event_paranoid\n", std::strerror(errno));
+        }
+    }
+
+    ~PerfCounters()
+    {
+        for (int fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available(Counter c) const { return fds_[c] >= 0; }
+
+    void start()
+    {
+        for (int fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void stop(uint64_t (&values)[NUM_COUNTERS])
+    {
+        for (int c = 0; c < NUM_COUNTERS; ++c)
+        {
+            values[c] = 0;
+            if (fds_[c] >= 0)
+            {
+                ioctl(fds_[c], PERF_EVENT_IOC_DISABLE, 0);
+                if (::read(fds_[c], &values[c], sizeof(values[c])) != sizeof(values[c]))
+                {
+                    values[c] = 0;
+                }
+            }
+        }
+    }
+
+private:
+    int fds_[NUM_COUNTERS];
+
+    static int open_event(uint32_t type, uint64_t config)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+};
+
+class MicroBench
+{
+public:
+    MicroBench(const MicroOptions &opt, const TSCCalibrator &tsc)
+        : opt_(opt), tsc_(tsc)
+    {
+    }
+
+    void print_header() const
+    {
+        std::printf("\n=== bbo_microbench (%.3f GHz TSC, best of %d x %lu ops) ===\n",
+                    tsc_.get_ghz(), opt_.reps, opt_.ops);
+        std::printf("  %-42s %8s %8s %10s %10s %8s\n", "case", "cyc/op", "ns/op",
+                    "L1D mis/op", "br mis/op", "insn/op");
+    }
+
+    // body(n) runs n ops; a warm-up pass first (icache, predictors, pages)
+    template<typename Body>
+    void run(const std::string &name, Body &&body)
+    {
+        if (opt_.filter != nullptr && name.find(opt_.filter) == std::string::npos)
+        {
+            return;
+        }
+        body(opt_.ops / 16 + 1);
+
+        uint64_t best_cycles = ~uint64_t{0};
+        uint64_t best_counters[PerfCounters::NUM_COUNTERS] = {};
+        for (int r = 0; r < opt_.reps; ++r)
+        {
+            uint64_t cycles;
+            uint64_t counters[PerfCounters::NUM_COUNTERS];
+            perf_.start();
+            {
+                ScopedTimer timer(&cycles);
+                body(opt_.ops);
+            }
+            perf_.stop(counters);
+            if (cycles < best_cycles)
+            {
+                best_cycles = cycles;
+                std::memcpy(best_counters, counters, sizeof(counters));
+            }
+        }
+
+        const double ops = static_cast<double>(opt_.ops);
+        std::printf("  %-42s %8.2f %8.2f", name.c_str(), best_cycles / ops,
+                    tsc_.cycles_to_ns(best_cycles) / ops);
+        print_counter(PerfCounters::L1D_MISSES, best_counters, ops, 10, 3);
+        print_counter(PerfCounters::BRANCH_MISSES, best_counters, ops, 10, 3);
+        print_counter(PerfCounters::INSTRUCTIONS, best_counters, ops, 8, 1);
+        std::printf("\n");
+    }
+
+private:
+    const MicroOptions &opt_;
+    const TSCCalibrator &tsc_;
+    PerfCounters perf_;
+
+    void print_counter(PerfCounters::Counter c, const uint64_t (&values)[PerfCounters::NUM_COUNTERS],
+                       double ops, int width, int precision) const
+    {
+        if (perf_.available(c))
+        {
+            std::printf(" %*.*f", width, precision, values[c] / ops);
+        }
+        else
+        {
+            std::printf(" %*s", width, "n/a");
+        }
+    }
+};
+
+// PAYLOADS synthetic full-size BBO payloads (T1-T4 present), random walk
+// over 64 symbols as in bbo_bench's synthetic feed
+std::vector<std::vector<uint8_t>> make_payloads()
+{
+    uint32_t rng = 1;
+    auto next = [&rng]()
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    std::vector<std::vector<uint8_t>> payloads(PAYLOADS);
+    uint32_t mid = 1500000;     // $150.0000
+    for (size_t i = 0; i < PAYLOADS; ++i)
+    {
+        std::vector<uint8_t> &bbo = payloads[i];
+        bbo.assign(ultra_ll::BBO_FULL_SIZE, 0);
+        char symbol[9];
+        std::snprintf(symbol, sizeof(symbol), "S%06zu ", i % 64);
+        std::memcpy(bbo.data(), symbol, 8);
+
+        mid += (next() % 201) - 100;
+        const uint32_t spread = 100 + next() % 900;
+        const uint32_t fields[9] = {
+            mid - spread / 2, 100 * (1 + next() % 50),
+            mid - spread / 2 + spread, 100 * (1 + next() % 50),
+            spread,
+            static_cast<uint32_t>(i * 100), static_cast<uint32_t>(i * 100 + 20),
+            static_cast<uint32_t>(i * 100 + 40), static_cast<uint32_t>(i * 100 + 50)};
+        for (int k = 0; k < 9; ++k)
+        {
+            const uint32_t be = __builtin_bswap32(fields[k]);
+            std::memcpy(bbo.data() + ultra_ll::BID_PRICE_OFFSET + 4 * k, &be, 4);
+        }
+    }
+    return payloads;
+}
+
+void bench_parser(MicroBench &bench, const std::vector<std::vector<uint8_t>> &payloads)
+{
+    using ultra_ll::BBOParserFast;
+    ultra_ll::DefaultBBOPool pool;
+
+    const auto parse_case = [&](const char *name, size_t len)
+    {
+        bench.run(name, [&](uint64_t n)
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                const uint8_t *p = payloads[i & (PAYLOADS - 1)].data();
+                keep(BBOParserFast::parse(p, len, pool, i, static_cast<uint32_t>(i)));
+            }
+        });
+    };
+    parse_case("parse/valid (28 B)", ultra_ll::BBO_MIN_SIZE);
+    parse_case("parse/short (24 B, rejected)", ultra_ll::BBO_MIN_SIZE - 4);
+    parse_case("parse/full timestamps (44 B)", ultra_ll::BBO_FULL_SIZE);
+
+    // Same payload with T1-T4 packed into the padding (-f / fpga_deltas)
+    bench.run("parse/full + FPGA deltas (44 B)", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            const uint8_t *p = payloads[i & (PAYLOADS - 1)].data();
+            keep(BBOParserFast::parse<true>(p, ultra_ll::BBO_FULL_SIZE, pool, i,
+                                           static_cast<uint32_t>(i)));
+        }
+    });
+}
+
+// acquire() plus one store into the entry, as the parser does: hugepages
+// only show up once the pool outgrows the 4 KB-page dTLB reach
+template<size_t N>
+void bench_pool_size(MicroBench &bench, const char *size_name)
+{
+    for (const bool hugepages : {true, false})
+    {
+        auto pool = std::make_unique<ultra_ll::BBOPool<N>>(ultra_ll::NUMA_NODE_ANY, hugepages);
+        std::string name = std::string("pool/acquire ") + size_name;
+        if (pool->is_using_hugepages())
+        {
+            name += " hugepages";
+        }
+        else
+        {
+            name += hugepages ? " heap (no hugepages)" : " heap";
+        }
+        bench.run(name, [&](uint64_t n)
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                ultra_ll::BBODataFast *bbo = pool->acquire();
+                bbo->timestamp_ns = i;
+                keep(bbo);
+            }
+        });
+    }
+}
+
+// Entry filled one 8-byte word at a time, every word = v (a torn copy
+// mixes values)
+FORCE_INLINE void fill_words(ultra_ll::BBODataFast *bbo, uint64_t v)
+{
+    volatile uint64_t *w = reinterpret_cast<volatile uint64_t *>(bbo);
+    for (size_t k = 0; k < sizeof(*bbo) / sizeof(uint64_t); ++k)
+    {
+        w[k] = v;
+    }
+}
+
+// OWNED seqlock: a reader holding no reference races acquire + fill +
+// publish + release on every slot. Returns the torn copies is_current()
+// accepted (must be 0).
+uint64_t bench_pool_race(MicroBench &bench, const MicroOptions &opt)
+{
+    ultra_ll::OwnedBBOPool owned;
+    std::atomic<bool> run{true};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> torn{0};
+    std::thread reader([&]
+    {
+        pin_thread(opt.consumer_core, "pool reader");
+        uint64_t ok = 0, bad = 0;
+        for (size_t i = 0; run.load(std::memory_order_relaxed); ++i)
+        {
+            const ultra_ll::BBODataFast *bbo = &owned[i & (owned.size() - 1)];
+            const uint32_t gen = owned.generation(bbo);
+            uint64_t copy[sizeof(*bbo) / sizeof(uint64_t)];
+            const volatile uint64_t *w = reinterpret_cast<const volatile uint64_t *>(bbo);
+            for (size_t k = 0; k < sizeof(copy) / sizeof(copy[0]); ++k)
+            {
+                copy[k] = w[k];
+            }
+            if (!owned.is_current(bbo, gen))
+            {
+                continue;
+            }
+            ++ok;
+            for (size_t k = 1; k < sizeof(copy) / sizeof(copy[0]); ++k)
+            {
+                if (copy[k] != copy[0])
+                {
+                    ++bad;
+                    break;
+                }
+            }
+        }
+        accepted.store(ok, std::memory_order_relaxed);
+        torn.store(bad, std::memory_order_relaxed);
+    });
+
+    uint64_t v = 0;
+    bench.run("pool/acquire+fill+publish owned (reader)", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ultra_ll::BBODataFast *bbo = owned.acquire();
+            fill_words(bbo, ++v);
+            owned.publish(bbo);
+            owned.release(bbo);
+        }
+    });
+
+    run.store(false, std::memory_order_relaxed);
+    reader.join();
+    if (v != 0)
+    {
+        std::printf("    reader: %lu copies accepted, %lu torn\n",
+                    accepted.load(), torn.load());
+    }
+    return torn.load();
+}
+
+uint64_t bench_pool(MicroBench &bench, const MicroOptions &opt)
+{
+    bench_pool_size<1024>(bench, "64 KB");
+    bench_pool_size<32768>(bench, "2 MB");
+
+    ultra_ll::OwnedBBOPool owned;
+    bench.run("pool/acquire+release owned 64 KB", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ultra_ll::BBODataFast *bbo = owned.acquire();
+            bbo->timestamp_ns = i;
+            owned.publish(bbo);
+            keep(bbo);
+            owned.release(bbo);
+        }
+    });
+
+    return bench_pool_race(bench, opt);
+}
+
+void bench_convert(MicroBench &bench, const std::vector<std::vector<uint8_t>> &payloads)
+{
+    std::vector<ultra_ll::BBODataFast> bbos(PAYLOADS);
+    for (size_t i = 0; i < PAYLOADS; ++i)
+    {
+        ultra_ll::BBOParserFast::parse_into(payloads[i].data(), ultra_ll::BBO_MIN_SIZE,
+                                            bbos[i], i);
+    }
+
+    bench.run("convert/to_gateway", [&](uint64_t n)
+    {
+        gateway::BBOData out;
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ultra_ll::DPDKReceiver::to_gateway(bbos[i & (PAYLOADS - 1)], out);
+            keep(out);
+        }
+    });
+}
+
+void bench_clock(MicroBench &bench, const TSCCalibrator &tsc)
+{
+    bench.run("clock/rdtsc", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            keep(rdtsc());
+        }
+    });
+    bench.run("clock/rdtscp", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            keep(rdtscp());
+        }
+    });
+    bench.run("clock/cycles_to_ns", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            keep(tsc.cycles_to_ns(i * 977));
+        }
+    });
+    bench.run("clock/tsc_to_ns (seqlock epoch)", [&](uint64_t n)
+    {
+        const uint64_t base = rdtsc();
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            keep(tsc.tsc_to_ns(base + i * 977));
+        }
+    });
+    bench.run("clock/clock_gettime REALTIME", [&](uint64_t n)
+    {
+        timespec ts;
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            clock_gettime(CLOCK_REALTIME, &ts);
+            keep(ts);
+        }
+    });
+}
+
+// Producer here, consumer on its own core copying every slot out: the
+// cursor and slot lines bounce between the two cores as in production
+void bench_ring(MicroBench &bench, const MicroOptions &opt,
+                const std::vector<std::vector<uint8_t>> &payloads)
+{
+    auto ring = std::make_unique<ultra_ll::BboFastRing>();
+    for (size_t i = 0; i < ring->capacity(); ++i)
+    {
+        ring->slot(i).clear();      // Prefault before timing
+    }
+
+    std::atomic<bool> run{true};
+    std::thread consumer([&]
+    {
+        pin_thread(opt.consumer_core, "ring consumer");
+        ultra_ll::BBODataFast out;
+        while (run.load(std::memory_order_relaxed))
+        {
+            if (!ring->try_consume(out))
+            {
+                _mm_pause();
+            }
+        }
+    });
+
+    bench.run("ring/claim+parse+commit (consumer)", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ultra_ll::BBODataFast *slot;
+            while (unlikely((slot = ring->claim()) == nullptr))
+            {
+                _mm_pause();    // Consumer behind: back-pressure is part of the cost
+            }
+            ultra_ll::BBOParserFast::parse_into(payloads[i & (PAYLOADS - 1)].data(),
+                                                ultra_ll::BBO_MIN_SIZE, *slot, i);
+            ring->commit();
+        }
+    });
+
+    bench.run("ring/batch of 32 parse+commit (consumer)", [&](uint64_t n)
+    {
+        for (uint64_t i = 0; i < n;)
+        {
+            const uint64_t want = n - i < RING_BATCH ? n - i : RING_BATCH;
+            const uint32_t got = ring->claim_batch(static_cast<uint32_t>(want));
+            if (unlikely(got == 0))
+            {
+                _mm_pause();
+                continue;
+            }
+            for (uint32_t j = 0; j < got; ++j)
+            {
+                ultra_ll::BBOParserFast::parse_into(payloads[(i + j) & (PAYLOADS - 1)].data(),
+                                                    ultra_ll::BBO_MIN_SIZE,
+                                                    *ring->batch_slot(j), i + j);
+            }
+            ring->commit_batch(got);
+            i += got;
+        }
+    });
+
+    run.store(false, std::memory_order_relaxed);
+    consumer.join();
+}
+
+void print_usage(const char *prog)
+{
+    std::printf(
+        "bbo_microbench - Project 36 per-component microbenchmarks\n"
+        "\n"
+        "Usage: %s [OPTIONS]\n"
+        "\n"
+        "  -n, --ops <n>          Ops per repetition (default: 1000000)\n"
+        "  -r, --reps <n>         Repetitions per case, best reported (default: 5)\n"
+        "  -f, --filter <text>    Only cases whose name contains text (parse, pool,\n"
+        "                         convert, clock, ring)\n"
+        "  -c, --core <id>        Pin the benchmark thread (an isolated core)\n"
+        "  -C, --consumer-core <id> Pin the ring consumer and pool reader (ideally the\n"
+        "                         same socket)\n"
+        "  -h, --help             Show this help\n"
+        "\n",
+        prog);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    MicroOptions opt;
+
+    static struct option long_options[] = {
+        {"ops", required_argument, 0, 'n'},
+        {"reps", required_argument, 0, 'r'},
+        {"filter", required_argument, 0, 'f'},
+        {"core", required_argument, 0, 'c'},
+        {"consumer-core", required_argument, 0, 'C'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
+
+    int o;
+    while ((o = getopt_long(argc, argv, "n:r:f:c:C:h", long_options, nullptr)) != -1)
+    {
+        switch (o)
+        {
+        case 'n':
+            opt.ops = std::strtoull(optarg, nullptr, 10);
+            break;
+        case 'r':
+            opt.reps = std::atoi(optarg);
+            break;
+        case 'f':
+            opt.filter = optarg;
+            break;
+        case 'c':
+            opt.core = std::atoi(optarg);
+            break;
+        case 'C':
+            opt.consumer_core = std::atoi(optarg);
+            break;
+        case 'h':
+            print_usage(argv[0]);
+            return 0;
+        default:
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (opt.ops == 0 || opt.reps <= 0)
+    {
+        std::fprintf(stderr, "Error: --ops and --reps must be positive\n");
+        return 1;
+    }
+    if (opt.core >= 0 && opt.core == opt.consumer_core)
+    {
+        std::fprintf(stderr, "Warning: Benchmark and ring consumer share core %d, "
+                     "ring cases measure time slicing\n", opt.core);
+    }
+
+    pin_thread(opt.core, "benchmark");
+    const TSCCalibrator tsc;
+    const std::vector<std::vector<uint8_t>> payloads = make_payloads();
+
+    MicroBench bench(opt, tsc);
+    bench.print_header();
+    bench_parser(bench, payloads);
+    const uint64_t torn = bench_pool(bench, opt);
+    bench_convert(bench, payloads);
+    bench_clock(bench, tsc);
+    bench_ring(bench, opt, payloads);
+    std::printf("\n");
+
+    if (torn != 0)
+    {
+        std::fprintf(stderr, "Error: OwnedBBOPool accepted %lu torn reads\n", torn);
+        return 1;
+    }
+    return 0;
+}
@@ -1,31 +1,111 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <string>
 
 namespace ultra_ll {
 
+// Wire prices are unsigned integers in 1/10000 units
+// Using multiplication instead of division for better performance
+constexpr double PRICE_MULTIPLIER = 0.0001;  // 1/10000 for 4 decimal places
+
+// Price representation policies for BBODataT / BBOParserT
+//
+// FloatPrice: prices converted to double at parse time (gateway-compatible)
+// TickPrice:  raw wire ticks kept end to end - no int->double on the hot
+//             path, 12 bytes of the line freed for additional fields
+//
+struct FloatPrice {
+    using type = double;
+    static constexpr size_t PADDING = 8;
+
+    static constexpr type from_raw(uint32_t raw) noexcept { return raw * PRICE_MULTIPLIER; }
+    static constexpr double to_double(type v) noexcept { return v; }
+};
+
+struct TickPrice {
+    using type = uint32_t;
+    static constexpr size_t PADDING = 16;
+
+    static constexpr type from_raw(uint32_t raw) noexcept { return raw; }
+    static constexpr double to_double(type v) noexcept { return v * PRICE_MULTIPLIER; }
+};
+
+// FPGA stage timings carried in BBODataT::padding (DPDKReceiver::Config::fpga_deltas)
+//
+// T1-T4 differences in 125 MHz cycles, saturated at 0xFFFF (524 us).
+// The absolute counters are not kept: 8 bytes is all the FloatPrice line
+// has left. Set when flags has BboFlags::HAS_FPGA_DELTAS.
+struct FpgaDeltas {
+    uint16_t parse_to_cdc;   // T2 - T1: ITCH parse -> CDC FIFO write
+    uint16_t cdc_to_fifo;    // T3 - T2: CDC FIFO write -> BBO FIFO read
+    uint16_t fifo_to_tx;     // T4 - T3: BBO FIFO read -> TX start
+    uint16_t reserved;       // 0
+
+    // From the wire T1-T4 (big-endian u32 each); unsigned differences, so
+    // counter wrap is harmless
+    static FpgaDeltas from_wire(const uint8_t* t) noexcept {
+        uint32_t v[4];
+        std::memcpy(v, t, sizeof(v));
+        const uint32_t t1 = __builtin_bswap32(v[0]);
+        const uint32_t t2 = __builtin_bswap32(v[1]);
+        const uint32_t t3 = __builtin_bswap32(v[2]);
+        const uint32_t t4 = __builtin_bswap32(v[3]);
+        return {saturate(t2 - t1), saturate(t3 - t2), saturate(t4 - t3), 0};
+    }
+
+    // T4 - T1 (saturated stages sum to a lower bound)
+    uint32_t total() const noexcept {
+        return uint32_t{parse_to_cdc} + cdc_to_fifo + fifo_to_tx;
+    }
+
+    static constexpr uint16_t saturate(uint32_t cycles) noexcept {
+        return cycles < 0xFFFF ? static_cast<uint16_t>(cycles) : uint16_t{0xFFFF};
+    }
+};
+
+static_assert(sizeof(FpgaDeltas) <= FloatPrice::PADDING &&
+              sizeof(FpgaDeltas) <= TickPrice::PADDING,
+              "FpgaDeltas must fit the BBO line's padding");
+
 // Cache-line aligned BBO structure for ultra-low-latency processing
 // Exactly 64 bytes = 1 cache line for optimal memory access patterns
 //
 // Design decisions:
 // - Fixed 8-byte symbol (vs 16 in gateway::BBOData) - most symbols fit
-// - No FPGA timestamps in hot path (can be extracted separately)
+// - FPGA T1-T4 only as stage deltas in the padding (FpgaDeltas, optional)
 // - All data needed for trading decision in single cache line fetch
+// - Price representation chosen at compile time (FloatPrice / TickPrice)
+//
+// Layout (FloatPrice)              Layout (TickPrice)
+//   0 symbol[8]                      0 symbol[8]
+//   8 bid_price   (double)           8 bid_price (u32)  12 ask_price (u32)
+//  16 ask_price   (double)          16 bid_shares       20 ask_shares
+//  24 bid_shares  28 ask_shares     24 spread (u32)     28 (hole)
+//  32 spread      (double)          32 timestamp_ns
+//  40 timestamp_ns                  40 sequence  44 valid  45 flags
+//  48 sequence  52 valid  53 flags  46 instrument_id  48 padding[16]
+//  54 instrument_id  56 padding[8]
+//  (padding starts with FpgaDeltas when flags has HAS_FPGA_DELTAS)
 //
-struct alignas(64) BBODataFast {
+template<typename Price>
+struct alignas(64) BBODataT {
+    using price_type = typename Price::type;
+
     char symbol[8];          // 8 bytes: Stock ticker (space-padded)
-    double bid_price;        // 8 bytes: Best bid price
-    double ask_price;        // 8 bytes: Best ask price
+    price_type bid_price;    // Best bid price
+    price_type ask_price;    // Best ask price
     uint32_t bid_shares;     // 4 bytes: Total bid shares
     uint32_t ask_shares;     // 4 bytes: Total ask shares
-    double spread;           // 8 bytes: Ask - Bid
+    price_type spread;       // Ask - Bid
     uint64_t timestamp_ns;   // 8 bytes: Reception timestamp (RDTSC-based)
     uint32_t sequence;       // 4 bytes: Packet sequence number
     uint8_t valid;           // 1 byte: Data validity flag
     uint8_t flags;           // 1 byte: Status flags (bit 0: has_timestamps)
-    uint8_t padding[10];     // 10 bytes: Pad to exactly 64 bytes
+    uint16_t instrument_id;  // 2 bytes: Dense ID from InstrumentMap (0 = not interned)
+    uint8_t padding[Price::PADDING];  // Pad to exactly 64 bytes
     // Total: 64 bytes
 
     void clear() noexcept {
@@ -50,9 +130,39 @@ struct alignas(64) BBODataFast {
         }
         return std::string(symbol, len);
     }
+
+    // FPGA stage deltas: meaningful when flags has HAS_FPGA_DELTAS
+    FpgaDeltas fpga_deltas() const noexcept {
+        FpgaDeltas d;
+        std::memcpy(&d, padding, sizeof(d));
+        return d;
+    }
+    void set_fpga_deltas(const FpgaDeltas& d) noexcept {
+        std::memcpy(padding, &d, sizeof(d));
+    }
+
+    // Prices as double regardless of representation (cold/export paths)
+    double bid_price_f() const noexcept { return Price::to_double(bid_price); }
+    double ask_price_f() const noexcept { return Price::to_double(ask_price); }
+    double spread_f() const noexcept { return Price::to_double(spread); }
 };
 
+// Build-wide price representation (CMake: -DENABLE_TICK_PRICES=ON)
+#if defined(BBO_TICK_PRICES) && BBO_TICK_PRICES
+using BBOPrice = TickPrice;
+#else
+using BBOPrice = FloatPrice;
+#endif
+
+using BBODataFast = BBODataT<BBOPrice>;
+
 // Compile-time checks
+static_assert(sizeof(BBODataT<FloatPrice>) == 64, "BBODataT<FloatPrice> must be exactly 64 bytes");
+static_assert(sizeof(BBODataT<TickPrice>) == 64, "BBODataT<TickPrice> must be exactly 64 bytes");
+static_assert(offsetof(BBODataT<FloatPrice>, padding) + FloatPrice::PADDING == 64,
+              "FloatPrice padding must end the line");
+static_assert(offsetof(BBODataT<TickPrice>, padding) + TickPrice::PADDING == 64,
+              "TickPrice padding must end the line");
 static_assert(sizeof(BBODataFast) == 64, "BBODataFast must be exactly 64 bytes (1 cache line)");
 static_assert(alignof(BBODataFast) == 64, "BBODataFast must be cache-line aligned");
 
@@ -85,6 +195,7 @@ namespace BboFlags {
     constexpr uint8_t HAS_FPGA_TIMESTAMPS = 0x01;
     constexpr uint8_t IS_SYNTHETIC = 0x02;  // Warm-up packet
     constexpr uint8_t IS_STALE = 0x04;      // Data may be outdated
+    constexpr uint8_t HAS_FPGA_DELTAS = 0x08;  // padding holds FpgaDeltas
 }
 
 }  // namespace ultra_ll
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "likely.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ultra_ll {
+
+// Native BBODataFast ring for shared-memory export
+//
+// Single-producer / single-consumer ring of 64-byte BBODataFast slots.
+// Unlike disruptor::BboRingBuffer (by-value try_publish of gateway::BBOData),
+// the producer claims a slot, parses straight into it and commits, so the
+// common path is exactly one cache-line write plus the cursor release.
+// claim_batch()/commit_batch() publish a whole rx burst with one release.
+//
+// Memory layout (placed in shared memory by the producer):
+// - Line 0: header (magic, capacity) - read-only after creation
+// - Line 1: write cursor + producer's cached read cursor (producer-written)
+// - Line 2: read cursor + consumer's cached write cursor (consumer-written)
+// - Slots:  CAPACITY x 64 bytes
+//
+// Consumers map the same segment and use try_consume()/peek()+advance().
+//
+template<size_t CAPACITY = 16384>
+class FastBboRing {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be power of 2");
+
+public:
+    static constexpr uint64_t MAGIC = 0x4242'4F46'4153'5431ULL;  // "BBOFAST1"
+    static constexpr uint64_t MASK = CAPACITY - 1;
+
+    FastBboRing() noexcept {
+        magic_ = MAGIC;
+        capacity_ = CAPACITY;
+        slot_size_ = sizeof(BBODataFast);
+    }
+
+    // Non-copyable (lives in shared memory)
+    FastBboRing(const FastBboRing&) = delete;
+    FastBboRing& operator=(const FastBboRing&) = delete;
+
+    // Validate a mapping created by another process
+    bool is_valid() const noexcept {
+        return magic_ == MAGIC && capacity_ == CAPACITY &&
+               slot_size_ == sizeof(BBODataFast);
+    }
+
+    // ---- Producer side ----
+
+    // Claim the next slot for in-place writing
+    // Returns nullptr when the ring is full (consumer behind)
+    HOT_FUNC
+    BBODataFast* claim() noexcept {
+        const uint64_t seq = write_cursor_.load(std::memory_order_relaxed);
+        if (unlikely(seq - cached_read_ >= CAPACITY)) {
+            cached_read_ = read_cursor_.load(std::memory_order_acquire);
+            if (seq - cached_read_ >= CAPACITY) {
+                return nullptr;
+            }
+        }
+        return &slots_[seq & MASK];
+    }
+
+    // Publish the slot returned by the last claim()
+    HOT_FUNC
+    void commit() noexcept {
+        const uint64_t seq = write_cursor_.load(std::memory_order_relaxed);
+        write_cursor_.store(seq + 1, std::memory_order_release);
+    }
+
+    // Claim up to n consecutive slots for a whole burst
+    // Returns how many are free (0..n); fill them via batch_slot(i) and
+    // publish with one commit_batch() - a single release store per burst
+    HOT_FUNC
+    uint32_t claim_batch(uint32_t n) noexcept {
+        const uint64_t seq = write_cursor_.load(std::memory_order_relaxed);
+        uint64_t free_slots = CAPACITY - (seq - cached_read_);
+        if (unlikely(free_slots < n)) {
+            cached_read_ = read_cursor_.load(std::memory_order_acquire);
+            free_slots = CAPACITY - (seq - cached_read_);
+        }
+        return free_slots < n ? static_cast<uint32_t>(free_slots) : n;
+    }
+
+    // i-th slot of the current batch claim (i < value returned by claim_batch)
+    HOT_FUNC
+    BBODataFast* batch_slot(uint32_t i) noexcept {
+        const uint64_t seq = write_cursor_.load(std::memory_order_relaxed);
+        return &slots_[(seq + i) & MASK];
+    }
+
+    // Publish the first n slots of the current batch claim
+    HOT_FUNC
+    void commit_batch(uint32_t n) noexcept {
+        const uint64_t seq = write_cursor_.load(std::memory_order_relaxed);
+        write_cursor_.store(seq + n, std::memory_order_release);
+    }
+
+    // ---- Consumer side ----
+
+    // Peek at the next unread slot, nullptr if empty
+    const BBODataFast* peek() noexcept {
+        const uint64_t seq = read_cursor_.load(std::memory_order_relaxed);
+        if (seq == cached_write_) {
+            cached_write_ = write_cursor_.load(std::memory_order_acquire);
+            if (seq == cached_write_) {
+                return nullptr;
+            }
+        }
+        return &slots_[seq & MASK];
+    }
+
+    // Release the slot returned by peek()
+    void advance() noexcept {
+        const uint64_t seq = read_cursor_.load(std::memory_order_relaxed);
+        read_cursor_.store(seq + 1, std::memory_order_release);
+    }
+
+    // Copy out the next BBO
+    bool try_consume(BBODataFast& out) noexcept {
+        const BBODataFast* slot = peek();
+        if (!slot) {
+            return false;
+        }
+        out = *slot;
+        advance();
+        return true;
+    }
+
+    // ---- Metadata ----
+
+    static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    uint64_t published() const noexcept {
+        return write_cursor_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t consumed() const noexcept {
+        return read_cursor_.load(std::memory_order_relaxed);
+    }
+
+    // Slots at [index] for warm-up / prefaulting
+    BBODataFast& slot(size_t i) noexcept { return slots_[i & MASK]; }
+
+private:
+    // Line 0: immutable header
+    alignas(64) uint64_t magic_;
+    uint32_t capacity_;
+    uint32_t slot_size_;
+
+    // Line 1: producer
+    alignas(64) std::atomic<uint64_t> write_cursor_{0};
+    uint64_t cached_read_ = 0;
+
+    // Line 2: consumer
+    alignas(64) std::atomic<uint64_t> read_cursor_{0};
+    uint64_t cached_write_ = 0;
+
+    // Slots (each exactly one cache line)
+    alignas(64) BBODataFast slots_[CAPACITY];
+};
+
+// Default ring matching shared_memory.ring_size in config.json
+using BboFastRing = FastBboRing<16384>;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "FastBboRing cursors must be lock-free for cross-process use");
+
+}  // namespace ultra_ll
@@ -3,14 +3,14 @@
 #include "bbo_data.h"
 #include "bbo_pool.h"
 #include "likely.h"
+#include <cstddef>
 #include <cstring>
 #include <cstdint>
 
 namespace ultra_ll {
 
 // Compile-time constants for BBO parsing
-// Using multiplication instead of division for better performance
-constexpr double PRICE_MULTIPLIER = 0.0001;  // 1/10000 for 4 decimal places
+// (PRICE_MULTIPLIER lives in bbo_data.h with the price policies)
 constexpr size_t BBO_MIN_SIZE = 28;          // Symbol(8) + prices/shares(20)
 constexpr size_t BBO_FULL_SIZE = 44;         // With 4-point timestamps
 
@@ -28,37 +28,54 @@ constexpr size_t T4_OFFSET = 40;
 
 // Fast BBO parser - optimized for ultra-low latency
 // No string operations, no exceptions, minimal branching
-class BBOParserFast {
+// Price policy (FloatPrice / TickPrice) selects the output representation
+template<typename Price = BBOPrice>
+class BBOParserT {
 public:
-    // Parse BBO data from raw UDP payload
-    // Returns pointer to pool-allocated BBODataFast, or nullptr on failure
+    using Data = BBODataT<Price>;
+
+    // Parse BBO data from raw UDP payload directly into caller-owned storage
+    // (e.g. a claimed ring slot) - no pool, no intermediate copy
+    // Writes every byte of the 64-byte line, padding included
+    // FPGA_DELTAS: T1-T4 packed into the padding in the same pass
+    // Rejects what is_valid_bbo() rejects, as the -V burst kernels do
     //
     // @param data     Pointer to UDP payload (BBO at start)
     // @param len      Length of payload
-    // @param pool     Pre-allocated BBO object pool
+    // @param out      Destination BBO (typically FastBboRing::claim())
     // @param ts_ns    Reception timestamp (from RDTSC)
     // @param sequence Packet sequence number
     //
-    template<size_t PoolSize>
+    template<bool FPGA_DELTAS = false>
     HOT_FUNC
-    static BBODataFast* parse(
+    static bool parse_into(
         const uint8_t* data,
         size_t len,
-        BBOPool<PoolSize>& pool,
+        Data& out,
         uint64_t ts_ns,
         uint32_t sequence = 0
     ) noexcept {
-        // Fast reject for undersized packets
-        if (unlikely(len < BBO_MIN_SIZE)) {
-            return nullptr;
+        // Fast reject for undersized packets and non-ASCII symbols
+        if (unlikely(!is_valid_bbo(data, len))) {
+            return false;
         }
+        fill<FPGA_DELTAS>(data, len, out, ts_ns, sequence);
+        return true;
+    }
 
-        // Acquire slot from pool (zero allocation)
-        BBODataFast* bbo = pool.acquire();
-
+    // parse_into() past validation: the burst kernels check symbols vectorized
+    template<bool FPGA_DELTAS = false>
+    FORCE_INLINE
+    static void fill(
+        const uint8_t* data,
+        size_t len,
+        Data& out,
+        uint64_t ts_ns,
+        uint32_t sequence
+    ) noexcept {
         // Symbol: 8 bytes at offset 0
         // Single 64-bit load (assuming aligned or unaligned load is fast)
-        std::memcpy(bbo->symbol, data + SYMBOL_OFFSET, 8);
+        std::memcpy(out.symbol, data + SYMBOL_OFFSET, 8);
 
         // Price data: all big-endian uint32_t
         // Using __builtin_bswap32 for efficient byte swap
@@ -70,30 +87,88 @@ public:
         uint32_t ask_shares = __builtin_bswap32(prices[3]);
         uint32_t spread_raw = __builtin_bswap32(prices[4]);
 
-        // Convert to doubles using multiplication (faster than division)
-        bbo->bid_price = bid_raw * PRICE_MULTIPLIER;
-        bbo->ask_price = ask_raw * PRICE_MULTIPLIER;
-        bbo->spread = spread_raw * PRICE_MULTIPLIER;
+        // FloatPrice: multiply by PRICE_MULTIPLIER; TickPrice: store raw ticks
+        out.bid_price = Price::from_raw(bid_raw);
+        out.ask_price = Price::from_raw(ask_raw);
+        out.spread = Price::from_raw(spread_raw);
 
-        bbo->bid_shares = bid_shares;
-        bbo->ask_shares = ask_shares;
+        out.bid_shares = bid_shares;
+        out.ask_shares = ask_shares;
 
-        bbo->timestamp_ns = ts_ns;
-        bbo->sequence = sequence;
-        bbo->valid = 1;
+        out.timestamp_ns = ts_ns;
+        out.sequence = sequence;
+        out.valid = 1;
 
         // Check if packet has FPGA timestamps
-        if (len >= BBO_FULL_SIZE) {
-            bbo->flags = BboFlags::HAS_FPGA_TIMESTAMPS;
-        } else {
-            bbo->flags = 0;
+        out.flags = (len >= BBO_FULL_SIZE) ? BboFlags::HAS_FPGA_TIMESTAMPS : 0;
+
+        // Slot may hold a stale BBO - keep the exported line deterministic
+        // (the receiver stamps instrument_id after parse when interning)
+        out.instrument_id = 0;
+        std::memset(out.padding, 0, sizeof(out.padding));
+        if constexpr (FPGA_DELTAS) {
+            pack_fpga_deltas(data, len, out);
+        }
+        clear_alignment_hole(out);
+    }
+
+    // FpgaDeltas into a parsed BBO's (zeroed) padding when the payload has T1-T4
+    FORCE_INLINE
+    static void pack_fpga_deltas(const uint8_t* data, size_t len, Data& out) noexcept {
+        if (likely(len >= BBO_FULL_SIZE)) {
+            out.set_fpga_deltas(FpgaDeltas::from_wire(data + T1_OFFSET));
+            out.flags |= BboFlags::HAS_FPGA_DELTAS;
+        }
+    }
+
+    // TickPrice leaves a 4-byte hole between spread and timestamp_ns
+    FORCE_INLINE
+    static void clear_alignment_hole(Data& out) noexcept {
+        constexpr size_t hole_begin = offsetof(Data, spread) + sizeof(out.spread);
+        constexpr size_t hole_size = offsetof(Data, timestamp_ns) - hole_begin;
+        if constexpr (hole_size > 0) {
+            std::memset(reinterpret_cast<char*>(&out) + hole_begin, 0, hole_size);
+        }
+    }
+
+    // Parse BBO data from raw UDP payload
+    // Returns pointer to pool-allocated BBO, or nullptr on failure
+    // (short payload, non-ASCII symbol, or an OWNED pool with every slot held)
+    //
+    // @param data     Pointer to UDP payload (BBO at start)
+    // @param len      Length of payload
+    // @param pool     Pre-allocated BBO object pool
+    // @param ts_ns    Reception timestamp (from RDTSC)
+    // @param sequence Packet sequence number
+    //
+    template<bool FPGA_DELTAS = false, size_t PoolSize, PoolMode Mode>
+    HOT_FUNC
+    static Data* parse(
+        const uint8_t* data,
+        size_t len,
+        BBOPool<PoolSize, Data, Mode>& pool,
+        uint64_t ts_ns,
+        uint32_t sequence = 0
+    ) noexcept {
+        // Fast reject before touching the pool
+        if (unlikely(!is_valid_bbo(data, len))) {
+            return nullptr;
         }
 
+        // Acquire slot from pool (zero allocation)
+        Data* bbo = pool.acquire();
+        if constexpr (Mode == PoolMode::OWNED) {
+            if (unlikely(bbo == nullptr)) {
+                return nullptr;
+            }
+        }
+        fill<FPGA_DELTAS>(data, len, *bbo, ts_ns, sequence);
+        pool.publish(bbo);
         return bbo;
     }
 
     // Extract FPGA timestamps from packet (separate from hot path)
-    // Only call this when detailed timing analysis is needed
+    // Absolute T1-T4 for offline analysis; the hot path keeps FpgaDeltas
     COLD_FUNC
     static FPGATimestamps extract_timestamps(const uint8_t* data, size_t len) noexcept {
         FPGATimestamps ts;
@@ -122,14 +197,23 @@ public:
         }
 
         // Check symbol is printable ASCII (basic validation)
-        for (size_t i = 0; i < 8; ++i) {
-            uint8_t c = data[i];
-            if (unlikely(c < 0x20 || c > 0x7E)) {
-                return false;
-            }
-        }
+        return symbol_is_printable(data + SYMBOL_OFFSET);
+    }
 
-        return true;
+    // All 8 symbol bytes in 0x20..0x7E, checked as one 64-bit word (SWAR)
+    // Per byte: (c - 0x20) borrows into bit 7 when c < 0x20,
+    //           (c + 0x01) carries into bit 7 when c > 0x7E
+    HOT_FUNC
+    static bool symbol_is_printable(const uint8_t* sym) noexcept {
+        constexpr uint64_t ONES = 0x0101010101010101ULL;
+        constexpr uint64_t HIGH = 0x8080808080808080ULL;
+
+        uint64_t x;
+        std::memcpy(&x, sym, 8);
+
+        const uint64_t below = (x - ONES * 0x20) & ~x;
+        const uint64_t above = (x + ONES * (0x7F - 0x7E)) | x;
+        return ((below | above) & HIGH) == 0;
     }
 
     // Quick symbol check without full parse
@@ -145,13 +229,16 @@ public:
     }
 };
 
+// Parser for the build-wide price representation
+using BBOParserFast = BBOParserT<BBOPrice>;
+
 // Inline helper for common case: parse with default pool
-template<size_t PoolSize>
+template<size_t PoolSize, PoolMode Mode>
 HOT_FUNC
 inline BBODataFast* parse_bbo(
     const uint8_t* data,
     size_t len,
-    BBOPool<PoolSize>& pool,
+    BBOPool<PoolSize, BBODataFast, Mode>& pool,
     uint64_t ts_ns
 ) noexcept {
     return BBOParserFast::parse(data, len, pool, ts_ns);
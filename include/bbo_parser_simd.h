@@ -0,0 +1,63 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "bbo_parser_fast.h"
+#include "likely.h"
+#include <cstdint>
+
+namespace ultra_ll {
+
+// Instruction set used by the burst parser
+// Ordered: a higher value implies the lower ones are available
+enum class SimdIsa : uint8_t {
+    SCALAR = 0,     // SWAR symbol check + __builtin_bswap32
+    SSE4 = 1,       // PSHUFB byte swap, PCMPGTB symbol check
+    AVX2 = 2,       // Masked 28-byte load, full line built in two YMM stores
+    AVX512 = 3,     // AVX-512F/VL/BW: native u32->double, one ZMM store per BBO
+};
+
+// One packet queued for burst parsing
+struct BurstParseInput {
+    const uint8_t* data;     // UDP payload (BBO at start)
+    uint32_t len;            // Payload length
+    uint32_t sequence;       // Sequence number to stamp into the BBO
+    uint64_t ts_ns;          // Reception timestamp
+};
+
+// Parse n payloads, writing the k-th valid BBO to *out[k]
+// Invalid packets (short, or non-printable symbol) are skipped without
+// consuming an output slot. Returns the number of valid BBOs written.
+// out[0..n) must all be writable: a slot may be scribbled by a rejected
+// packet before the next valid one overwrites it.
+using BurstParseFn = uint32_t (*)(const BurstParseInput* in, uint32_t n,
+                                  BBODataFast* const* out) noexcept;
+
+// Vectorized BBO burst parser with startup ISA dispatch
+//
+// Kernels are compiled with per-function target attributes, so the binary
+// runs on any x86-64 host regardless of -march; the widest kernel the CPU
+// supports is picked once at initialization and called once per rx burst,
+// amortizing the indirect call over the whole burst.
+//
+class BBOParserSimd {
+public:
+    // Widest ISA supported by the running CPU
+    static SimdIsa detect() noexcept;
+
+    // Kernel for a given ISA (caller clamps to detect())
+    static BurstParseFn select(SimdIsa isa) noexcept;
+
+    static const char* isa_name(SimdIsa isa) noexcept;
+
+    // Per-ISA kernels (exposed for benchmarking)
+    static uint32_t parse_burst_scalar(const BurstParseInput* in, uint32_t n,
+                                       BBODataFast* const* out) noexcept;
+    static uint32_t parse_burst_sse4(const BurstParseInput* in, uint32_t n,
+                                     BBODataFast* const* out) noexcept;
+    static uint32_t parse_burst_avx2(const BurstParseInput* in, uint32_t n,
+                                     BBODataFast* const* out) noexcept;
+    static uint32_t parse_burst_avx512(const BurstParseInput* in, uint32_t n,
+                                       BBODataFast* const* out) noexcept;
+};
+
+}  // namespace ultra_ll
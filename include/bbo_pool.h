@@ -2,46 +2,94 @@
 
 #include "bbo_data.h"
 #include "likely.h"
+#include "numa_util.h"
 #include <atomic>
 #include <cstdlib>
 #include <cstdio>
+#include <new>
 #include <sys/mman.h>
 
 namespace ultra_ll {
 
+// Slot reuse policy
+enum class PoolMode : uint8_t {
+    CIRCULAR,   // acquire() takes the next slot; valid for POOL_SIZE more acquires
+    OWNED,      // Per-slot refcount + generation: a slot is reused only once released
+};
+
 // Pre-allocated BBO object pool with optional hugepage backing
+// Element type defaults to BBODataFast (any 64-byte BBODataT<Price> works)
+// Pages are placed on numa_node (the NIC's node) before prefault
+// hugepages = false skips straight to the heap (bbo_microbench baseline)
 // Uses lock-free circular buffer for zero-allocation hot path
 //
 // Memory layout:
-// - POOL_SIZE BBODataFast entries (64 bytes each)
+// - POOL_SIZE entries (64 bytes each)
 // - 1024 entries = 64 KB (fits entirely in L2 cache)
-// - Circular reuse - no explicit release needed
+// - OWNED: POOL_SIZE x 8-byte slot words after the entries, same mapping
+//
+// CIRCULAR: no explicit release needed, a slot is silently overwritten
+// POOL_SIZE acquires later. Fine while the BBO dies within the burst.
 //
-template<size_t POOL_SIZE = 1024>
+// OWNED: for stages that hold a BBO across bursts (conflation, batching,
+// a tap thread). Each slot word is {generation:32, refs:32}:
+// - acquire() (owner lcore only) claims the next slot with refs == 0,
+//   makes its generation odd (being filled) and returns it with refs = 1;
+//   nullptr when every slot is held (counted in exhausted()). Held slots
+//   are stepped over out of line (skipped()), so the common case is one
+//   load + one store.
+// - publish() (owner, after filling, before handing the entry over) makes
+//   the generation even again with a release store.
+// - retain() / release() may run on any thread; retain() only by a thread
+//   that already holds a reference (the owner hands one over).
+// - generation() + is_current(): a reader that holds no reference reads
+//   the entry, then checks it was neither being filled nor recycled
+//   meanwhile (seqlock: an odd generation is never current).
+//
+template<size_t POOL_SIZE = 1024, typename T = BBODataFast, PoolMode MODE = PoolMode::CIRCULAR>
 class BBOPool {
+    static_assert(sizeof(T) == 64, "Pool entries must be exactly one cache line");
     static_assert((POOL_SIZE & (POOL_SIZE - 1)) == 0, "POOL_SIZE must be power of 2");
     static_assert(POOL_SIZE >= 64, "POOL_SIZE should be at least 64 for burst handling");
 
+    static constexpr bool OWNED = (MODE == PoolMode::OWNED);
+    static constexpr size_t ENTRY_BYTES = POOL_SIZE * sizeof(T);
+    static constexpr size_t SLOT_BYTES = OWNED ? POOL_SIZE * sizeof(uint64_t) : 0;
+    static constexpr size_t ALLOC_BYTES = ENTRY_BYTES + SLOT_BYTES;
+    static constexpr uint64_t REFS_MASK = 0xFFFFFFFFULL;
+
     // Pool storage - either on hugepages or aligned heap
-    BBODataFast* pool_;
+    T* pool_;
+    std::atomic<uint64_t>* slots_;  // OWNED: {generation, refs} per entry
     bool using_hugepages_;
+    int numa_node_;                 // Node the pages landed on (NUMA_NODE_ANY if unknown)
 
     // Lock-free head pointer (only incremented, wraps via mask)
+    // OWNED: owner-private, plain load + store
     alignas(64) std::atomic<uint32_t> head_{0};
+    uint32_t exhausted_ = 0;        // OWNED: acquire() found every slot held
+    uint64_t skipped_ = 0;          // OWNED: held slots stepped over
 
     // Padding to prevent false sharing with other data
-    char padding_[64 - sizeof(std::atomic<uint32_t>)];
+    char padding_[64 - 2 * sizeof(uint32_t) - sizeof(uint64_t)];
 
 public:
-    BBOPool() : pool_(nullptr), using_hugepages_(false) {
-        allocate_pool();
+    static constexpr PoolMode mode = MODE;
+
+    explicit BBOPool(int numa_node = NUMA_NODE_ANY, bool hugepages = true)
+        : pool_(nullptr), slots_(nullptr), using_hugepages_(false), numa_node_(numa_node) {
+        allocate_pool(hugepages);
+        numa_prefer(pool_, ALLOC_BYTES, numa_node);
         prefault_pool();
+        if (numa_node != NUMA_NODE_ANY) {
+            numa_node_ = numa_node_of(pool_);
+        }
     }
 
     ~BBOPool() {
         if (pool_) {
             if (using_hugepages_) {
-                munmap(pool_, POOL_SIZE * sizeof(BBODataFast));
+                munmap(pool_, ALLOC_BYTES);
             } else {
                 std::free(pool_);
             }
@@ -53,18 +101,82 @@ public:
     BBOPool& operator=(const BBOPool&) = delete;
 
     // Acquire a BBO slot from the pool
-    // Always succeeds (circular buffer overwrites old entries)
-    // Returns pointer valid until POOL_SIZE more acquires
+    // CIRCULAR: always succeeds, pointer valid until POOL_SIZE more acquires
+    // OWNED: owner lcore only; valid until released, nullptr if all are held
     HOT_FUNC
-    BBODataFast* acquire() noexcept {
-        uint32_t idx = head_.fetch_add(1, std::memory_order_relaxed) & (POOL_SIZE - 1);
-        return &pool_[idx];
+    T* acquire() noexcept {
+        if constexpr (!OWNED) {
+            uint32_t idx = head_.fetch_add(1, std::memory_order_relaxed) & (POOL_SIZE - 1);
+            return &pool_[idx];
+        } else {
+            const uint32_t head = head_.load(std::memory_order_relaxed);
+            const uint32_t idx = head & (POOL_SIZE - 1);
+            const uint64_t word = slots_[idx].load(std::memory_order_acquire);
+            if (unlikely((word & REFS_MASK) != 0)) {
+                return acquire_held(head);
+            }
+            claim(idx, word);
+            head_.store(head + 1, std::memory_order_relaxed);
+            return &pool_[idx];
+        }
+    }
+
+    // CIRCULAR: no-op, the slot is reused automatically (zero-overhead hot path)
+    // OWNED: drop one reference; the slot is free again at zero (any thread)
+    void release(const T* entry) noexcept {
+        if constexpr (OWNED) {
+            slots_[index_of(entry)].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // CIRCULAR: no-op
+    // OWNED: the entry is filled; readers may accept it from now on. Owner
+    // only, before any other thread holds a reference (plain release store)
+    void publish(const T* entry) noexcept {
+        if constexpr (OWNED) {
+            const size_t idx = index_of(entry);
+            const uint64_t word = slots_[idx].load(std::memory_order_relaxed);
+            slots_[idx].store(word + (1ULL << 32), std::memory_order_release);
+        }
+    }
+
+    // OWNED: add a reference for a deferred stage (caller already holds one)
+    void retain(const T* entry) noexcept {
+        static_assert(OWNED, "retain() needs PoolMode::OWNED");
+        slots_[index_of(entry)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // OWNED: generation of the entry's current use; read it before the entry
+    // (odd while the owner is filling it: is_current() then always fails)
+    uint32_t generation(const T* entry) const noexcept {
+        static_assert(OWNED, "generation() needs PoolMode::OWNED");
+        return static_cast<uint32_t>(
+            slots_[index_of(entry)].load(std::memory_order_acquire) >> 32);
+    }
+
+    // OWNED: the entry was published at gen and not reacquired since;
+    // call after reading it (data read unreferenced is valid only if true)
+    bool is_current(const T* entry, uint32_t gen) const noexcept {
+        static_assert(OWNED, "is_current() needs PoolMode::OWNED");
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (gen & 1) == 0 &&
+               static_cast<uint32_t>(
+                   slots_[index_of(entry)].load(std::memory_order_relaxed) >> 32) == gen;
     }
 
-    // No explicit release needed - circular buffer reuses automatically
-    // This is intentional for zero-overhead hot path
-    void release(BBODataFast*) noexcept {
-        // No-op - circular reuse
+    // OWNED: acquire() failures / held slots stepped over (owner-written)
+    uint32_t exhausted() const noexcept { return exhausted_; }
+    uint64_t skipped() const noexcept { return skipped_; }
+
+    // OWNED: entries with at least one reference (slow scan, stats only)
+    size_t in_use() const noexcept {
+        size_t n = 0;
+        if constexpr (OWNED) {
+            for (size_t i = 0; i < POOL_SIZE; ++i) {
+                n += (slots_[i].load(std::memory_order_relaxed) & REFS_MASK) != 0;
+            }
+        }
+        return n;
     }
 
     // Pre-warm all cache lines in the pool
@@ -82,13 +194,14 @@ public:
     }
 
     // Access pool entry by index (for warm-up and testing)
-    BBODataFast& operator[](size_t i) noexcept { return pool_[i]; }
-    const BBODataFast& operator[](size_t i) const noexcept { return pool_[i]; }
+    T& operator[](size_t i) noexcept { return pool_[i]; }
+    const T& operator[](size_t i) const noexcept { return pool_[i]; }
 
     // Pool metadata
     constexpr size_t size() const noexcept { return POOL_SIZE; }
-    constexpr size_t bytes() const noexcept { return POOL_SIZE * sizeof(BBODataFast); }
+    constexpr size_t bytes() const noexcept { return ALLOC_BYTES; }
     bool is_using_hugepages() const noexcept { return using_hugepages_; }
+    int numa_node() const noexcept { return numa_node_; }
 
     // Current head position (for debugging)
     uint32_t current_head() const noexcept {
@@ -96,39 +209,72 @@ public:
     }
 
 private:
-    void allocate_pool() {
-        const size_t alloc_size = POOL_SIZE * sizeof(BBODataFast);
-
-        // Try hugepages first (2MB pages for lower TLB pressure)
-        pool_ = static_cast<BBODataFast*>(mmap(
-            nullptr,
-            alloc_size,
-            PROT_READ | PROT_WRITE,
-            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
-            -1, 0
-        ));
-
-        if (pool_ != MAP_FAILED) {
-            using_hugepages_ = true;
-            return;
+    size_t index_of(const T* entry) const noexcept {
+        return static_cast<size_t>(entry - pool_);
+    }
+
+    // New use of a free slot: generation + 1 (odd: filling), refs = 1. Only
+    // the owner moves a slot off zero refs, so a plain store suffices; the
+    // fence orders it before the caller's writes to the entry (is_current()).
+    // A slot released without publish() is still odd: step to the next odd.
+    FORCE_INLINE void claim(uint32_t idx, uint64_t word) noexcept {
+        slots_[idx].store(((word >> 32) + 1 + ((word >> 32) & 1)) << 32 | 1,
+                          std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    // Next slot is still held by a deferred stage: scan for a free one
+    NEVER_INLINE T* acquire_held(uint32_t head) noexcept {
+        for (uint32_t n = 1; n <= POOL_SIZE; ++n) {
+            const uint32_t idx = (head + n) & (POOL_SIZE - 1);
+            const uint64_t word = slots_[idx].load(std::memory_order_acquire);
+            if ((word & REFS_MASK) == 0) {
+                skipped_ += n;
+                claim(idx, word);
+                head_.store(head + n + 1, std::memory_order_relaxed);
+                return &pool_[idx];
+            }
         }
+        skipped_ += POOL_SIZE;
+        ++exhausted_;
+        return nullptr;
+    }
 
-        // Fallback: try hugepages with explicit 2MB size
-        pool_ = static_cast<BBODataFast*>(mmap(
-            nullptr,
-            alloc_size,
-            PROT_READ | PROT_WRITE,
-            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT),
-            -1, 0
-        ));
-
-        if (pool_ != MAP_FAILED) {
-            using_hugepages_ = true;
-            return;
+    void allocate_pool(bool hugepages) {
+        const size_t alloc_size = ALLOC_BYTES;
+
+        if (hugepages) {
+            // Try hugepages first (2MB pages for lower TLB pressure)
+            pool_ = static_cast<T*>(mmap(
+                nullptr,
+                alloc_size,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                -1, 0
+            ));
+
+            if (pool_ != MAP_FAILED) {
+                using_hugepages_ = true;
+                return;
+            }
+
+            // Fallback: try hugepages with explicit 2MB size
+            pool_ = static_cast<T*>(mmap(
+                nullptr,
+                alloc_size,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT),
+                -1, 0
+            ));
+
+            if (pool_ != MAP_FAILED) {
+                using_hugepages_ = true;
+                return;
+            }
         }
 
-        // Final fallback: aligned heap allocation (64-byte for cache line)
-        pool_ = static_cast<BBODataFast*>(aligned_alloc(64, alloc_size));
+        // Final fallback: page-aligned heap allocation (mbind granularity)
+        pool_ = static_cast<T*>(aligned_alloc(NUMA_PAGE_SIZE, alloc_size));
         using_hugepages_ = false;
 
         if (!pool_) {
@@ -143,20 +289,34 @@ private:
         for (size_t i = 0; i < POOL_SIZE; ++i) {
             pool_[i].clear();
         }
+        if constexpr (OWNED) {
+            slots_ = reinterpret_cast<std::atomic<uint64_t>*>(
+                reinterpret_cast<char*>(pool_) + ENTRY_BYTES);
+            for (size_t i = 0; i < POOL_SIZE; ++i) {
+                new (&slots_[i]) std::atomic<uint64_t>(0);
+            }
+        }
     }
 };
 
 // Default pool size for typical use
 using DefaultBBOPool = BBOPool<1024>;
 
+// Reference-counted slots for stages that hold BBOs across bursts
+using OwnedBBOPool = BBOPool<1024, BBODataFast, PoolMode::OWNED>;
+
 // Statistics helper
-template<size_t N>
-inline void print_pool_stats(const BBOPool<N>& pool) {
+template<size_t N, typename T, PoolMode M>
+inline void print_pool_stats(const BBOPool<N, T, M>& pool) {
     std::printf("BBOPool: %zu entries, %zu KB, hugepages=%s, head=%u\n",
                 pool.size(),
                 pool.bytes() / 1024,
                 pool.is_using_hugepages() ? "yes" : "no",
                 pool.current_head());
+    if constexpr (M == PoolMode::OWNED) {
+        std::printf("  owned: %zu in use, %lu held slots skipped, %u exhausted\n",
+                    pool.in_use(), pool.skipped(), pool.exhausted());
+    }
 }
 
 }  // namespace ultra_ll
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "likely.h"
+#include "numa_util.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+
+namespace ultra_ll {
+
+// Per-symbol latest-value cache for ring backpressure
+//
+// When the consumer falls behind, BBOs that cannot be published are folded
+// into this table instead of being dropped: one 64-byte BBODataFast line per
+// instrument, overwritten in place, with a dirty bit per slot. Once the ring
+// has space again the dirty entries are flushed, so the consumer always ends
+// up with the latest book state for every symbol.
+//
+// Memory layout:
+// - CAPACITY BBODataFast entries, open-addressed on the 8-byte symbol
+//   (the entry's own symbol field is the key, all-zero = empty slot)
+// - Dirty bitmap: CAPACITY / 64 words, scanned with ctz on flush
+// - 4096 entries = 256 KB + 512 B bitmap, hugepage-backed when possible
+//
+// Single-threaded: owned by one poll lcore, like BBOPool.
+//
+template<size_t CAPACITY = 4096>
+class ConflationCache {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be power of 2");
+    static_assert(CAPACITY >= 64, "CAPACITY must cover at least one bitmap word");
+
+    static constexpr size_t MASK = CAPACITY - 1;
+    static constexpr size_t WORDS = CAPACITY / 64;
+    static constexpr size_t MAX_SYMBOLS = CAPACITY - CAPACITY / 8;  // Bound probe length
+    static constexpr int HASH_SHIFT = 64 - __builtin_ctzll(CAPACITY);
+
+    BBODataFast* table_;
+    bool using_hugepages_;
+
+    uint64_t dirty_[WORDS];
+    uint32_t dirty_count_ = 0;
+    uint32_t symbols_ = 0;
+    uint32_t flush_word_ = 0;   // Rotating start so flush never starves high slots
+
+public:
+    explicit ConflationCache(int numa_node = NUMA_NODE_ANY)
+        : table_(nullptr), using_hugepages_(false) {
+        allocate_table();
+        numa_prefer(table_, bytes(), numa_node);
+        std::memset(table_, 0, bytes());
+        std::memset(dirty_, 0, sizeof(dirty_));
+    }
+
+    ~ConflationCache() {
+        if (table_) {
+            if (using_hugepages_) {
+                munmap(table_, bytes());
+            } else {
+                std::free(table_);
+            }
+        }
+    }
+
+    // Non-copyable
+    ConflationCache(const ConflationCache&) = delete;
+    ConflationCache& operator=(const ConflationCache&) = delete;
+
+    // Store bbo as the latest value for its symbol and mark it dirty
+    // Returns false if the symbol is new and the table is at its load limit
+    // (or the symbol is all-zero) - caller counts that as a drop
+    HOT_FUNC
+    bool update(const BBODataFast& bbo) noexcept {
+        const uint64_t key = symbol_key(bbo.symbol);
+        if (unlikely(key == 0)) {
+            return false;
+        }
+
+        size_t idx = (key * 0x9E3779B97F4A7C15ULL) >> HASH_SHIFT;
+        for (;;) {
+            const uint64_t slot_key = symbol_key(table_[idx].symbol);
+            if (likely(slot_key == key)) {
+                break;
+            }
+            if (slot_key == 0) {
+                if (unlikely(symbols_ >= MAX_SYMBOLS)) {
+                    return false;
+                }
+                ++symbols_;
+                break;
+            }
+            idx = (idx + 1) & MASK;
+        }
+
+        table_[idx] = bbo;
+
+        const uint64_t bit = uint64_t{1} << (idx & 63);
+        uint64_t& word = dirty_[idx >> 6];
+        dirty_count_ += (word & bit) == 0;
+        word |= bit;
+        return true;
+    }
+
+    bool has_dirty() const noexcept { return dirty_count_ != 0; }
+    uint32_t dirty_count() const noexcept { return dirty_count_; }
+    uint32_t symbols() const noexcept { return symbols_; }
+
+    // Publish dirty entries through publish(const BBODataFast&) -> bool
+    // Stops at the first false (sink full); remaining entries stay dirty
+    // Returns the number of entries flushed
+    template<typename PublishFn>
+    uint32_t flush(PublishFn&& publish) noexcept {
+        uint32_t flushed = 0;
+
+        for (size_t n = 0; n < WORDS && dirty_count_ != 0; ++n) {
+            const size_t w = (flush_word_ + n) & (WORDS - 1);
+            while (dirty_[w] != 0) {
+                const unsigned b = static_cast<unsigned>(__builtin_ctzll(dirty_[w]));
+                if (!publish(table_[(w << 6) | b])) {
+                    flush_word_ = static_cast<uint32_t>(w);
+                    return flushed;
+                }
+                dirty_[w] &= dirty_[w] - 1;
+                --dirty_count_;
+                ++flushed;
+            }
+        }
+
+        flush_word_ = 0;
+        return flushed;
+    }
+
+    // Pre-warm all cache lines in the table
+    void warm_cache() noexcept {
+        volatile uint64_t sink = 0;
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            sink = sink + *reinterpret_cast<volatile uint64_t*>(&table_[i]);
+        }
+        compiler_barrier();
+    }
+
+    static constexpr size_t capacity() noexcept { return CAPACITY; }
+    static constexpr size_t bytes() noexcept { return CAPACITY * sizeof(BBODataFast); }
+    bool is_using_hugepages() const noexcept { return using_hugepages_; }
+
+private:
+    FORCE_INLINE static uint64_t symbol_key(const char* sym) noexcept {
+        uint64_t key;
+        std::memcpy(&key, sym, 8);
+        return key;
+    }
+
+    void allocate_table() {
+        // Hugepages first (same policy as BBOPool)
+        void* p = mmap(nullptr, bytes(), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            table_ = static_cast<BBODataFast*>(p);
+            using_hugepages_ = true;
+            return;
+        }
+
+        table_ = static_cast<BBODataFast*>(aligned_alloc(NUMA_PAGE_SIZE, bytes()));
+        using_hugepages_ = false;
+
+        if (!table_) {
+            std::fprintf(stderr, "ConflationCache: Failed to allocate %zu bytes\n", bytes());
+            std::abort();
+        }
+    }
+};
+
+// Default: 4096 instruments, 256 KB per queue
+using DefaultConflationCache = ConflationCache<4096>;
+
+}  // namespace ultra_ll
@@ -1,8 +1,28 @@
 #pragma once
 
 #include "bbo_data.h"
+#include "bbo_fast_ring.h"
+#include "conflation_cache.h"
+#include "feed_arbiter.h"
+#include "feed_protocol.h"
+#include "itch_decoder.h"
+#include "sbe_decoder.h"
+#include "idle_backoff.h"
+#include "instrument_map.h"
+#include "flow_rules.h"
+#include "latency_histogram.h"
+#include "nic_clock.h"
+#include "publish_router.h"
+#include "replay_source.h"
+#include "rx_backend.h"
+#include "shm_segment.h"
+#include "symbol_filter.h"
+#include "telemetry.h"
+#include "tick_journal.h"
+#include "tsc_sync.h"
 #include "bbo_pool.h"
 #include "bbo_parser_fast.h"
+#include "bbo_parser_simd.h"
 #include "likely.h"
 #include "rdtsc.h"
 
@@ -23,43 +43,238 @@
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
+#include <memory>
 #include <string>
+#include <type_traits>
 
 namespace ultra_ll {
 
-// Configuration constants
+// Configuration defaults (Config overrides them at runtime)
 constexpr uint16_t BURST_SIZE = 32;         // Smaller burst = lower latency variance
+constexpr uint16_t MAX_BURST_SIZE = 64;     // Largest burst a poll loop is instantiated for
+static_assert(SocketRx::MAX_BURST == MAX_BURST_SIZE, "SocketRx reserve must cover a burst");
 constexpr uint16_t RX_RING_SIZE = 1024;     // RX descriptor ring size
-constexpr uint16_t MBUF_POOL_SIZE = 8191;   // Number of mbufs
+constexpr uint32_t MBUF_POOL_SIZE = 8191;   // Number of mbufs
 constexpr uint16_t MBUF_CACHE_SIZE = 250;   // Cache size per core
+constexpr uint16_t MAX_RX_QUEUES = 16;      // Upper bound for multi-queue mode
+static_assert(MAX_RX_QUEUES <= TELEMETRY_MAX_QUEUES, "telemetry segment has a slot per queue");
 
-// DPDK Receiver - Ultra Low Latency Single-Threaded Packet Handler
+// Burst sizes with a poll loop instantiation: powers of two up to MAX_BURST_SIZE
+constexpr bool is_supported_burst(uint16_t n) {
+    return n != 0 && n <= MAX_BURST_SIZE && (n & (n - 1)) == 0;
+}
+
+// Call fn(std::integral_constant<uint16_t, N>) for burst == N, so the hot
+// loop gets the burst as a compile-time constant (is_supported_burst() first)
+template<typename Fn>
+inline void with_burst_size(uint16_t burst, Fn&& fn) {
+    switch (burst) {
+        case 1:  fn(std::integral_constant<uint16_t, 1>{}); break;
+        case 2:  fn(std::integral_constant<uint16_t, 2>{}); break;
+        case 4:  fn(std::integral_constant<uint16_t, 4>{}); break;
+        case 8:  fn(std::integral_constant<uint16_t, 8>{}); break;
+        case 16: fn(std::integral_constant<uint16_t, 16>{}); break;
+        case 64: fn(std::integral_constant<uint16_t, 64>{}); break;
+        default: fn(std::integral_constant<uint16_t, BURST_SIZE>{}); break;
+    }
+}
+static_assert(is_supported_burst(BURST_SIZE) && is_supported_burst(MAX_BURST_SIZE));
+
+// UDP port built into the hot path as an immediate (CMake FIXED_UDP_PORT);
+// 0 = every instantiation compares against RxQueue::udp_port
+#ifndef BBO_FIXED_UDP_PORT
+#define BBO_FIXED_UDP_PORT 0
+#endif
+constexpr uint16_t FIXED_UDP_PORT = BBO_FIXED_UDP_PORT;
+
+// How traffic is distributed across RX queues when num_queues > 1
+enum class SteeringMode : uint8_t {
+    RSS,        // NIC hashes IPv4/UDP 4-tuple (distinct feeds land on distinct queues)
+    UDP_PORT,   // rte_flow rule per queue: dst UDP port -> queue
+};
+
+// Shared-memory output format
+enum class PublishMode : uint8_t {
+    GATEWAY,    // gateway::BBOData via disruptor::BboRingBuffer (Project 15 compatible)
+    NATIVE,     // BBODataFast parsed in place into a FastBboRing slot (one line per tick)
+};
+
+// Per-packet features as compile-time policy: each combination is its own
+// poll loop with the dead branches compiled out (DPDKReceiver picks one at
+// launch through with_hot_path(), like with_burst_size())
+template<bool STATS, bool LATENCY, bool FPGA, PublishMode PUBLISH, uint16_t UDP_PORT>
+struct HotPath {
+    static constexpr bool stats = STATS;            // Config::enable_stats
+    static constexpr bool latency = LATENCY;        // Histograms + FPGA T1-T4 extraction
+    static constexpr bool fpga = FPGA;              // Config::fpga_deltas
+    static constexpr PublishMode publish = PUBLISH; // Config::publish_mode
+    static constexpr uint16_t udp_port = UDP_PORT;  // FIXED_UDP_PORT, 0 = RxQueue::udp_port
+};
+
+// Call fn(HotPath<...>{}) for the runtime settings; fixed_port selects the
+// FIXED_UDP_PORT instantiation (every queue listens on that port)
+template<typename Fn>
+inline void with_hot_path(bool stats, bool latency, bool fpga, PublishMode publish,
+                          bool fixed_port, Fn&& fn) {
+    const auto by_port = [&](auto s, auto l, auto f, auto p) {
+        if constexpr (FIXED_UDP_PORT != 0) {
+            if (fixed_port) {
+                fn(HotPath<decltype(s)::value, decltype(l)::value, decltype(f)::value,
+                           decltype(p)::value, FIXED_UDP_PORT>{});
+                return;
+            }
+        }
+        fn(HotPath<decltype(s)::value, decltype(l)::value, decltype(f)::value,
+                   decltype(p)::value, 0>{});
+    };
+    const auto by_publish = [&](auto s, auto l, auto f) {
+        if (publish == PublishMode::NATIVE) {
+            by_port(s, l, f, std::integral_constant<PublishMode, PublishMode::NATIVE>{});
+        } else {
+            by_port(s, l, f, std::integral_constant<PublishMode, PublishMode::GATEWAY>{});
+        }
+    };
+    const auto by_fpga = [&](auto s, auto l) {
+        if (fpga) {
+            by_publish(s, l, std::true_type{});
+        } else {
+            by_publish(s, l, std::false_type{});
+        }
+    };
+    const auto by_latency = [&](auto s) {
+        if (latency) {
+            by_fpga(s, std::true_type{});
+        } else {
+            by_fpga(s, std::false_type{});
+        }
+    };
+    if (stats) {
+        by_latency(std::true_type{});
+    } else {
+        by_latency(std::false_type{});
+    }
+}
+
+// DPDK Receiver - Ultra Low Latency Packet Handler
 //
 // Design:
-// - Single polling loop (no context switches)
+// - One polling loop per RX queue, each on its own lcore (no context switches)
+// - RX from a DPDK PMD, AF_XDP or UDP sockets (RxBackend), one pipeline
+// - Per-queue pool, stats and sequence counter (no shared cache lines)
 // - Prefetch next packet while processing current
 // - Zero allocation in hot path (object pool)
 // - RDTSC timestamps (no syscalls)
 // - Writes directly to Disruptor shared memory
+// - Stats, histograms, FPGA deltas, publish mode compiled into the poll loop (HotPath)
 //
 class DPDKReceiver {
 public:
     struct Config {
         uint16_t port_id = 0;
-        uint16_t queue_id = 0;
+        uint16_t queue_id = 0;          // First RX queue (single-queue mode)
         uint16_t udp_port = 12345;
         int lcore_id = -1;              // -1 = auto-detect
         std::string shm_name = "gateway";
+        std::string hugepage_dir;       // hugetlbfs mount for the rings (empty = POSIX shm)
+        FeedProtocol protocol = FeedProtocol::BBO;  // Payload format (ITCH/SBE: software book)
+        uint32_t msg_prefetch = 0;      // ITCH: prefetch order slots N messages ahead (0 = off)
+        std::string symbols;            // Subscriptions: "A,B,..." or "@file" (empty = all)
+        std::string instruments;        // NATIVE: ID reference "A,B,...", "@file" or "dynamic"
+        std::vector<RouteConfig> routes; // NATIVE: extra filtered rings (implies instrument IDs)
+        // RX sizing (X710 / ConnectX and feeds differ): bbo_bench --sweep
+        uint16_t burst_size = BURST_SIZE;       // rte_eth_rx_burst() size, is_supported_burst()
+        uint16_t rx_ring_size = RX_RING_SIZE;   // Descriptors per RX queue (PMD may adjust)
+        uint32_t mbuf_pool_size = MBUF_POOL_SIZE;
+        uint16_t mbuf_cache_size = MBUF_CACHE_SIZE;
         bool enable_stats = true;
+        bool telemetry = true;          // Stats + latency in shm "/bbo_telemetry_<shm_name>"
+        PublishMode publish_mode = PublishMode::GATEWAY;
+        bool batch_publish = false;     // NATIVE only: one ring commit per rx burst
+        bool simd_parse = false;        // Vectorized burst parser (ISA chosen at startup)
+        SimdIsa max_simd_isa = SimdIsa::AVX512;  // Clamp for A/B runs
+        bool conflate = false;          // Fold ring-full BBOs into per-symbol latest value
+        bool latency_histograms = false; // Per-stage HDR histograms (3 rdtsc per packet or burst)
+        bool fpga_deltas = false;       // BBO feed: T1-T4 stage deltas in the padding + FPGA histograms
+        bool hw_timestamps = false;     // NIC RX timestamps into timestamp_ns (TSC fallback)
+        bool raw_tsc = false;           // timestamp_ns = rdtsc(), consumers convert (telemetry clock)
+        RxBackendConfig backend;        // DPDK PMD, AF_XDP (net_af_xdp vdev) or UDP sockets
+        bool replay = false;            // No NIC: skip port setup, feed via inject_burst()
+        std::string replay_file;        // replay: journal / pcap played by poll_loop() (empty = caller injects)
+        double replay_speed = 1.0;      // x recorded rate, REPLAY_MAX_SPEED (0) = unpaced
+        bool replay_live_ts = false;    // Stamp TSC at injection instead of the recorded time
+
+        // NUMA placement check (-1 = consumer CPU unknown)
+        int consumer_core = -1;         // CPU the ring consumer polls on
+
+        // Wire sequencing
+        bool wire_seq = false;          // Payload = 8-byte BE feed sequence + BBO (gap detection)
+        bool ab_arbitration = false;    // Queues 0/1 carry lines A/B of one feed, one lcore
+
+        // Idle policy (default: busy-spin forever)
+        IdleConfig idle;
+
+        // Tick capture to mmap'd journal files (journal.dir empty = off)
+        JournalConfig journal;
+
+        // Background TSC re-fit to CLOCK_REALTIME / PHC (tsc_sync.enabled)
+        TscSyncConfig tsc_sync;
+
+        // Multi-queue mode
+        uint16_t num_queues = 1;
+        SteeringMode steering = SteeringMode::RSS;
+        uint16_t queue_udp_ports[MAX_RX_QUEUES] = {};  // UDP_PORT steering, 0 = udp_port
+        bool ring_per_queue = true;     // Queue N > 0 publishes to "<shm_name>_q<N>"
+
+        // NIC filtering (rte_flow)
+        bool hw_filter = false;         // Match port/groups in the NIC, drop the rest, no promiscuous
+        bool flow_mark = false;         // Mark matched frames so the fast path skips header checks
+        uint32_t mcast_groups[MAX_MCAST_GROUPS] = {};   // Network byte order
+        uint8_t num_mcast_groups = 0;
     };
 
-    // Statistics (cache-line aligned to prevent false sharing)
-    struct alignas(64) Stats {
-        std::atomic<uint64_t> packets_received{0};
-        std::atomic<uint64_t> packets_processed{0};
-        std::atomic<uint64_t> packets_dropped{0};
-        std::atomic<uint64_t> parse_errors{0};
-        std::atomic<uint64_t> ring_buffer_full{0};
+    // Statistics (one cache line per queue, single writer: see telemetry.h)
+    using Stats = RxStats;
+
+    // Per-queue state, owned exclusively by the lcore polling that queue
+    //
+    // Layout:
+    // - Line 0: read-mostly queue identity + sequence counter
+    // - Stats: the queue's slot in the telemetry segment (stats_storage
+    //   without one), written by this lcore, read by bbo_stat / print_stats
+    // - Pool header on its own line, entries on separate pages
+    // - Cold: owned storage, owner (worker launch only)
+    //
+    struct alignas(64) RxQueue {
+        explicit RxQueue(int numa_node) : stats(&stats_storage), bbo_pool(numa_node) {}
+
+        disruptor::BboRingBuffer* ring_buffer = nullptr;
+        BboFastRing* fast_ring = nullptr;
+        DefaultConflationCache* conflation = nullptr;   // Non-null when conflate enabled (shared by A/B)
+        LatencyRecorder* latency = nullptr;             // Non-null when histograms enabled
+        FeedArbiter* arbiter = nullptr;                 // Non-null with wire_seq (shared by A/B)
+        Stats* stats;                                   // Telemetry slot or stats_storage
+        uint64_t rx_tsc = 0;            // TSC at last rte_eth_rx_burst() return (histograms)
+        uint16_t queue_id = 0;
+        uint16_t udp_port = 0;
+        uint32_t sequence = 0;
+
+        PublishRouter* router = nullptr;                // Non-null with routes (shared by A/B)
+        DefaultJournalRing* journal = nullptr;          // Non-null with -J (shared by A/B)
+        ItchBookBuilder* itch = nullptr;                // FeedProtocol::ITCH (shared by A/B)
+        SbeDecoder* sbe = nullptr;                      // FeedProtocol::SBE (shared by A/B)
+        IdleBackoff idle;                               // Empty-poll backoff (poll lcore)
+        BBOPool<1024> bbo_pool;
+        Stats stats_storage;                            // Without a telemetry segment
+        std::unique_ptr<DefaultConflationCache> conflation_storage;
+        std::unique_ptr<LatencyRecorder> latency_storage;
+        std::unique_ptr<FeedArbiter> arbiter_storage;
+        std::unique_ptr<ItchBookBuilder> itch_storage;
+        std::unique_ptr<SbeDecoder> sbe_storage;
+        std::unique_ptr<PublishRouter> router_storage;
+        std::unique_ptr<DefaultJournalRing> journal_storage;
+        std::unique_ptr<SocketRx> socket;               // RxBackend::SOCKET
+        unsigned lcore_id = 0;
+        DPDKReceiver* owner = nullptr;
     };
 
     explicit DPDKReceiver(const Config& config);
@@ -72,7 +287,9 @@ public:
     // Initialize DPDK and shared memory
     bool initialize(int argc, char** argv);
 
-    // Run the polling loop (blocks until stop() is called)
+    // Run the polling loops (blocks until stop() is called)
+    // Queue 0 runs on the calling lcore, queues 1..N-1 on worker lcores
+    // With replay_file: plays the recording into queue 0, returns at its end
     void poll_loop();
 
     // Stop the polling loop
@@ -84,59 +301,363 @@ public:
     // Warm-up: pre-fault caches and run synthetic packets
     void warm_up(int synthetic_packets = 1000);
 
+    // Replay: run a burst through a queue's hot path as if rte_eth_rx_burst()
+    // had just returned it (count <= MAX_BURST_SIZE, mbufs are freed).
+    // Must not race poll_loop() on the same queue. After initialize(): one
+    // indirect call into the hot path instantiation chosen there.
+    HOT_FUNC void inject_burst(uint16_t queue, rte_mbuf** pkts, uint16_t count);
+
+    // BBODataFast -> gateway::BBOData, the conversion half of
+    // convert_and_publish() (public for bbo_microbench)
+    HOT_FUNC static void to_gateway(const BBODataFast& fast, gateway::BBOData& bbo);
+
     // Get statistics
-    const Stats& get_stats() const { return stats_; }
+    uint16_t num_queues() const { return num_queues_; }
+    const Stats& get_stats(uint16_t queue = 0) const { return *queues_[queue]->stats; }
     void print_stats() const;
     void reset_stats();
 
+    // ISA selected for the burst parser (SCALAR unless simd_parse)
+    SimdIsa simd_isa() const { return simd_isa_; }
+
     // Get TSC calibrator (for external timing)
     const TSCCalibrator& get_tsc() const { return tsc_; }
 
+    // NIC RX timestamp clock (enabled() false when running on TSC)
+    const NicClock& get_nic_clock() const { return nic_clock_; }
+
+    // NUMA node everything is allocated on (NUMA_NODE_ANY if unknown)
+    int numa_node() const { return numa_node_; }
+
 private:
     Config config_;
-    Stats stats_;
     TSCCalibrator tsc_;
+    NicClock nic_clock_;
 
     // DPDK resources
     rte_mempool* mbuf_pool_ = nullptr;
     bool dpdk_initialized_ = false;
+    int numa_node_ = NUMA_NODE_ANY;     // NIC's node: mbufs, pools and rings live here
+    ShmBacking shm_;                    // POSIX shm or hugetlbfs for the rings
+
+    // Per-queue state (allocated separately so queues never share a line)
+    std::unique_ptr<RxQueue> queues_[MAX_RX_QUEUES];
+    uint16_t num_queues_ = 0;
+
+    // rte_flow rules (destroyed before the port is closed)
+    std::unique_ptr<FlowRules> flow_rules_;
+
+    // Subscription set (read-only after initialize(), shared by all lcores)
+    SymbolFilter filter_;
+
+    // Symbol -> instrument ID map in shared memory (nullptr = not interning)
+    InstrumentMap* instruments_ = nullptr;
+
+    // Fan-out filters + per-instrument route masks (nullptr = primary ring only)
+    std::unique_ptr<RouteTable> routes_;
+
+    // Drains the queues' journal rings into files (own thread, non-isolated core)
+    std::unique_ptr<JournalWriter> journal_;
+
+    // Keeps tsc_'s epoch mapping on the reference clock (nullptr = startup fit only)
+    std::unique_ptr<TscSync> tsc_sync_;
 
-    // Object pool for BBO parsing
-    BBOPool<1024> bbo_pool_;
+    // Recording played by replay_loop() (nullptr = live port or caller injects)
+    std::unique_ptr<ReplaySource> replay_;
 
-    // Shared memory ring buffer
-    disruptor::BboRingBuffer* ring_buffer_ = nullptr;
+    // Live per-queue Stats + latency for external readers (nullptr = in-process only)
+    TelemetrySegment* telemetry_ = nullptr;
 
-    // Running flag
+    // Burst parser kernel, selected once in initialize()
+    BurstParseFn parse_burst_ = &BBOParserSimd::parse_burst_scalar;
+    SimdIsa simd_isa_ = SimdIsa::SCALAR;
+
+    // Running flag (read-only for the poll lcores)
     std::atomic<bool> running_{false};
 
-    // Packet sequence counter
-    uint32_t sequence_ = 0;
+    // inject_burst() target: inject_burst_path<Path> for the launch hot path
+    using InjectFn = void (DPDKReceiver::*)(RxQueue&, rte_mbuf**, uint16_t);
+    InjectFn inject_ = nullptr;
+
+    // An ethdev port to configure, poll and close (DPDK or AF_XDP backend)
+    bool has_port() const {
+        return !config_.replay && config_.backend.backend != RxBackend::SOCKET;
+    }
 
     // Internal methods
     bool init_dpdk_eal(int argc, char** argv);
+    bool check_backend() const;
+    bool init_sockets();
+    bool init_queues();
     bool init_mempool();
     bool init_port();
+    // Point the whole RSS table at [queue_id, queue_id + num_queues)
+    bool init_reta(uint16_t reta_size);
+    bool init_flow_steering();
+    bool install_flow_rules(bool mark);
     bool init_shared_memory();
+    disruptor::BboRingBuffer* open_ring(const std::string& name);
+    BboFastRing* open_fast_ring(const std::string& name);
+    InstrumentMap* open_instrument_map(const std::string& name);
+    TelemetrySegment* open_telemetry(const std::string& name);
+    bool init_routes();
+    bool init_journal();
+    bool init_replay();
+    bool init_tsc_sync();
+    void attach_telemetry();
+    void* map_shm_segment(const std::string& shm_name, size_t size, bool& created);
+    void unmap_shm_segment(void* ptr, size_t size) const;
+    void check_numa_placement() const;
+
+    // Per-lcore poll loop (A/B: both lines on one lcore), dispatched once
+    // on the hot path and config_.burst_size to the instantiation for both
+    void poll_queue(RxQueue& q);
+    void poll_queue_pair(RxQueue& a, RxQueue& b);
+    template<typename Path, uint16_t BURST> void poll_queue_burst(RxQueue& q);
+    template<typename Path, uint16_t BURST> void poll_queue_pair_burst(RxQueue& a, RxQueue& b);
+    // RxBackend::SOCKET: recvmmsg() bursts through inject_burst_path()
+    template<typename Path, uint16_t BURST> void poll_socket_burst(RxQueue& q);
+    template<typename Path, uint16_t BURST>
+    HOT_FUNC uint16_t poll_once(RxQueue& q, rte_mbuf** pkts, IdleBackoff& idle);
+    NEVER_INLINE void record_wakeup(RxQueue& q, IdleBackoff& idle, const rte_mbuf* first);
+    static int queue_worker_main(void* arg);
+    void replay_loop(RxQueue& q);
+
+    // Hot path fixed at launch (with_hot_path() on config_ and the ports)
+    template<typename Fn> void dispatch_hot_path(Fn&& fn) const;
+
+    // Hot path methods, instantiated per HotPath: Path::stats, latency and
+    // publish are if constexpr, Path::udp_port an immediate
+    template<typename Path>
+    HOT_FUNC void inject_burst_path(RxQueue& q, rte_mbuf** pkts, uint16_t count);
+    template<typename Path>
+    HOT_FUNC void process_burst(RxQueue& q, rte_mbuf** pkts, uint16_t count);
+    template<typename Path>
+    HOT_FUNC void process_burst_batched(RxQueue& q, rte_mbuf** pkts, uint16_t count);
+    template<typename Path>
+    HOT_FUNC void process_burst_simd(RxQueue& q, rte_mbuf** pkts, uint16_t count);
+
+    // Non-BBO feeds: one burst loop instantiated per decoder policy
+    template<typename Path, FeedDecoder Decoder>
+    HOT_FUNC void process_burst_feed(RxQueue& q, Decoder& decoder, rte_mbuf** pkts,
+                                     uint16_t count);
+    template<typename Path>
+    HOT_FUNC void publish_update(RxQueue& q, BBODataFast& bbo);
+    template<typename Path>
+    HOT_FUNC void process_packet(RxQueue& q, rte_mbuf* pkt);
+    template<typename Path>
+    HOT_FUNC bool extract_payload(const RxQueue& q, rte_mbuf* pkt,
+                                  const uint8_t*& payload, size_t& payload_len) const;
+
+    // extract_payload() + wire sequence strip and arbitration (non-const)
+    template<typename Path>
+    HOT_FUNC bool accept_payload(RxQueue& q, rte_mbuf* pkt,
+                                 const uint8_t*& payload, size_t& payload_len);
+
+    // accept_payload() + subscription check on the BBO symbol (before parse)
+    template<typename Path>
+    HOT_FUNC bool accept_bbo(RxQueue& q, rte_mbuf* pkt,
+                             const uint8_t*& payload, size_t& payload_len);
 
-    // Hot path methods
-    HOT_FUNC void process_burst(rte_mbuf** pkts, uint16_t count);
-    HOT_FUNC void process_packet(rte_mbuf* pkt);
-    HOT_FUNC void publish_bbo(const BBODataFast& fast);
+    // Reception time: NIC wire timestamp when stamped, else TSC at dequeue
+    HOT_FUNC uint64_t rx_timestamp_ns(const rte_mbuf* pkt, uint64_t tsc) const;
+
+    // Parse straight into a claimed FastBboRing slot (PublishMode::NATIVE)
+    template<typename Path>
+    HOT_FUNC bool parse_and_publish_native(RxQueue& q, const uint8_t* payload,
+                                           size_t payload_len, uint64_t ts_ns);
 
     // Convert fast BBO to gateway format for shared memory
-    HOT_FUNC void convert_and_publish(const BBODataFast& fast);
+    // (conflates or counts ring_buffer_full when the ring is full)
+    template<typename Path>
+    HOT_FUNC void convert_and_publish(RxQueue& q, const BBODataFast& fast);
+    HOT_FUNC bool try_convert_and_publish(RxQueue& q, const BBODataFast& fast);
+
+    // Copy a finished BBO into the native ring (conflation flush)
+    HOT_FUNC bool try_publish_native(RxQueue& q, const BBODataFast& fast);
+
+    // Conflation: fold into the per-symbol cache / drain it when space frees
+    template<typename Path>
+    HOT_FUNC void conflate(RxQueue& q, const BBODataFast& fast);
+    template<typename Path>
+    HOT_FUNC bool conflate_payload(RxQueue& q, const uint8_t* payload, size_t payload_len,
+                                   uint64_t ts_ns, uint32_t sequence);
+    void flush_conflation(RxQueue& q);
+
+    // After the primary ring (stamp_instrument() first): routes + journal
+    // (payload supplies FPGA T1-T4, nullptr for decoded feeds);
+    // fan_out_payload() parses a BBO the primary ring had no room for
+    FORCE_INLINE void fan_out(RxQueue& q, const BBODataFast& bbo, const uint8_t* payload,
+                              size_t payload_len) {
+        if (q.router != nullptr) {
+            q.router->publish(bbo);
+        }
+        if (q.journal != nullptr) {
+            q.journal->append(bbo, payload, payload_len);
+        }
+    }
+    NEVER_INLINE bool fan_out_payload(RxQueue& q, const uint8_t* payload, size_t payload_len,
+                                      uint64_t ts_ns, uint32_t sequence);
+
+    // Burst parser output: rejected packets are compacted out of out[],
+    // so each BBO is paired with its input by sequence
+    FORCE_INLINE void fan_out_burst(RxQueue& q, const BurstParseInput* in,
+                                    BBODataFast* const* out, uint32_t parsed) {
+        if (q.router == nullptr && q.journal == nullptr) {
+            return;
+        }
+        uint32_t k = 0;
+        for (uint32_t j = 0; j < parsed; ++j, ++k) {
+            while (in[k].sequence != out[j]->sequence) {
+                ++k;
+            }
+            fan_out(q, *out[j], in[k].data, in[k].len);
+        }
+    }
+
+    // Native BBOs carry the dense ID; one index probe per BBO
+    FORCE_INLINE void stamp_instrument(BBODataFast& bbo) {
+        if (instruments_ != nullptr) {
+            bbo.instrument_id = instruments_->intern(bbo.symbol);
+        }
+    }
+
+    // Latency histograms: stage times relative to q.rx_tsc, n BBOs per sample
+    HOT_FUNC void record_latency(RxQueue& q, uint64_t parsed_tsc,
+                                 uint64_t published_tsc, uint32_t n);
+    HOT_FUNC void record_fpga_latency(RxQueue& q, const uint8_t* payload, size_t payload_len);
+
+    // fpga_deltas: FPGA stage histograms from the parsed BBO (no payload re-read)
+    template<typename Path>
+    FORCE_INLINE void record_fpga_deltas(RxQueue& q, const BBODataFast& bbo) {
+        if constexpr (Path::fpga) {
+            if (likely(bbo.flags & BboFlags::HAS_FPGA_DELTAS)) {
+                q.latency->record_fpga(bbo.fpga_deltas());
+            }
+        }
+    }
+
+    // The SIMD kernels zero the padding: pack each BBO's deltas right after
+    // the kernel (payload bytes still in L1), paired like fan_out_burst()
+    FORCE_INLINE void pack_fpga_burst(RxQueue& q, const BurstParseInput* in,
+                                      BBODataFast* const* out, uint32_t parsed) {
+        uint32_t k = 0;
+        for (uint32_t j = 0; j < parsed; ++j, ++k) {
+            while (in[k].sequence != out[j]->sequence) {
+                ++k;
+            }
+            BBOParserFast::pack_fpga_deltas(in[k].data, in[k].len, *out[j]);
+            if (likely(out[j]->flags & BboFlags::HAS_FPGA_DELTAS)) {
+                q.latency->record_fpga(out[j]->fpga_deltas());
+            }
+        }
+    }
+    void print_latency(const RxQueue& q) const;
 
     // Warm-up helpers
     void warm_cache();
     void warm_dpdk_path(int count);
-    rte_mbuf* create_dummy_packet();
+    rte_mbuf* create_dummy_packet(uint16_t udp_port, uint64_t seq);
 };
 
 // Inline hot path implementations
 
+// One poll iteration: conflation drain, histogram handover, rx burst
+// (pkts holds BURST entries)
+template<typename Path, uint16_t BURST>
+HOT_FUNC
+inline uint16_t DPDKReceiver::poll_once(RxQueue& q, rte_mbuf** pkts, IdleBackoff& idle) {
+    // Drain conflated BBOs before new ones (also when the feed is idle)
+    if (q.conflation && unlikely(q.conflation->has_dirty())) {
+        flush_conflation(q);
+    }
+    if (q.router && unlikely(q.router->has_backlog())) {
+        q.router->flush();
+    }
+
+    // Hand the stats thread a finished histogram phase if it asked
+    if constexpr (Path::latency) {
+        q.latency->poll_swap();
+    }
+
+    uint16_t nb_rx = rte_eth_rx_burst(
+        config_.port_id,
+        q.queue_id,
+        pkts,
+        BURST
+    );
+
+    if (likely(nb_rx > 0)) {
+        if (unlikely(idle.backed_off())) {
+            record_wakeup(q, idle, pkts[0]);
+        }
+        idle.on_packets();
+        if constexpr (Path::latency) {
+            q.rx_tsc = rdtsc();
+        }
+        process_burst<Path>(q, pkts, nb_rx);
+        if (q.journal) {
+            q.journal->publish();
+        }
+    }
+    return nb_rx;
+}
+
+HOT_FUNC
+inline void DPDKReceiver::inject_burst(uint16_t queue, rte_mbuf** pkts, uint16_t count) {
+    (this->*inject_)(*queues_[queue], pkts, count);
+}
+
+// Same per-iteration work as poll_once(), minus rte_eth_rx_burst()
+template<typename Path>
 HOT_FUNC
-inline void DPDKReceiver::process_burst(rte_mbuf** pkts, uint16_t count) {
+inline void DPDKReceiver::inject_burst_path(RxQueue& q, rte_mbuf** pkts, uint16_t count) {
+    if (q.conflation && unlikely(q.conflation->has_dirty())) {
+        flush_conflation(q);
+    }
+    if (q.router && unlikely(q.router->has_backlog())) {
+        q.router->flush();
+    }
+    if constexpr (Path::latency) {
+        q.latency->poll_swap();
+        q.rx_tsc = rdtsc();
+    }
+
+    process_burst<Path>(q, pkts, count);
+    if (q.journal) {
+        q.journal->publish();
+    }
+}
+
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::process_burst(RxQueue& q, rte_mbuf** pkts, uint16_t count) {
+    // Backlog still pending after poll_queue()'s flush: per-packet path,
+    // which folds every BBO into the cache so per-symbol order holds
+    const bool backlog = (q.conflation != nullptr) && unlikely(q.conflation->has_dirty());
+
+    // Decoded feeds build the book themselves; the branch is per burst
+    if (q.itch) {
+        process_burst_feed<Path>(q, *q.itch, pkts, count);
+        return;
+    }
+    if (q.sbe) {
+        process_burst_feed<Path>(q, *q.sbe, pkts, count);
+        return;
+    }
+
+    if (config_.simd_parse && likely(!backlog)) {
+        process_burst_simd<Path>(q, pkts, count);
+        return;
+    }
+
+    if constexpr (Path::publish == PublishMode::NATIVE) {
+        if (config_.batch_publish && likely(!backlog)) {
+            process_burst_batched<Path>(q, pkts, count);
+            return;
+        }
+    }
+
     for (uint16_t i = 0; i < count; ++i) {
         // Prefetch next packet's data into L1 cache
         if (likely(i + 1 < count)) {
@@ -147,22 +668,317 @@ inline void DPDKReceiver::process_burst(rte_mbuf** pkts, uint16_t count) {
             prefetch_l2(rte_pktmbuf_mtod(pkts[i + 2], void*));
         }
 
-        process_packet(pkts[i]);
+        process_packet<Path>(q, pkts[i]);
         rte_pktmbuf_free(pkts[i]);
     }
 }
 
+// Batched native publish: claim ring slots for the whole burst up front,
+// parse packets into consecutive slots, commit once at the end.
+// Trades the first packet's publish latency (it waits for the burst) for
+// one cursor store per burst instead of one per BBO.
+template<typename Path>
 HOT_FUNC
-inline void DPDKReceiver::process_packet(rte_mbuf* pkt) {
-    // Capture timestamp immediately
-    uint64_t ts = rdtsc();
+inline void DPDKReceiver::process_burst_batched(RxQueue& q, rte_mbuf** pkts,
+                                                uint16_t count) {
+    BboFastRing& ring = *q.fast_ring;
+    const uint32_t claimed = ring.claim_batch(count);
+    BBODataFast* slots[MAX_BURST_SIZE];     // Fan-out source once committed
+    uint32_t filled = 0;
+    uint32_t received = 0;
+    uint32_t errors = 0;
+    uint32_t full = 0;
+    uint32_t conflated = 0;
+
+    for (uint16_t i = 0; i < count; ++i) {
+        // Prefetch next packet's data into L1 cache
+        if (likely(i + 1 < count)) {
+            rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void*));
+        }
+        // Prefetch packet after that into L2 cache
+        if (likely(i + 2 < count)) {
+            prefetch_l2(rte_pktmbuf_mtod(pkts[i + 2], void*));
+        }
+
+        uint64_t ts = rdtsc();
+
+        const uint8_t* payload;
+        size_t payload_len;
+        if (likely(accept_bbo<Path>(q, pkts[i], payload, payload_len))) {
+            ++received;
+
+            if (likely(filled < claimed)) {
+                // Failed parses leave the slot unfilled; next packet reuses it
+                slots[filled] = ring.batch_slot(filled);
+                if (likely(BBOParserFast::parse_into<Path::fpga>(
+                        payload, payload_len, *slots[filled], rx_timestamp_ns(pkts[i], ts),
+                        q.sequence++))) {
+                    stamp_instrument(*slots[filled]);
+                    // Before the commit: the mbuf is freed below
+                    if (q.journal) {
+                        q.journal->append(*slots[filled], payload, payload_len);
+                    }
+                    record_fpga_deltas<Path>(q, *slots[filled]);
+                    ++filled;
+                    if constexpr (Path::latency && !Path::fpga) {
+                        record_fpga_latency(q, payload, payload_len);
+                    }
+                } else {
+                    ++errors;
+                }
+            } else if (q.conflation) {
+                // Counted as conflated (or ring_buffer_full) by conflate()
+                if (likely(conflate_payload<Path>(q, payload, payload_len,
+                                            rx_timestamp_ns(pkts[i], ts),
+                                            q.sequence++))) {
+                    ++conflated;
+                } else {
+                    ++errors;
+                }
+            } else {
+                if (q.router || q.journal) {
+                    fan_out_payload(q, payload, payload_len, rx_timestamp_ns(pkts[i], ts),
+                                    q.sequence);
+                }
+                ++q.sequence;
+                ++full;
+            }
+        }
+
+        rte_pktmbuf_free(pkts[i]);
+    }
+
+    if (likely(filled > 0)) {
+        // Parse time of the burst's last BBO; all of them publish together
+        const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+        ring.commit_batch(filled);
+        if constexpr (Path::latency) {
+            record_latency(q, parsed_tsc, rdtsc(), filled);
+        }
+        // Slots stay intact until this producer wraps onto them again
+        if (q.router) {
+            for (uint32_t j = 0; j < filled; ++j) {
+                q.router->publish(*slots[j]);
+            }
+        }
+    }
+
+    // One relaxed add per counter per burst
+    if constexpr (Path::stats) {
+        q.stats->packets_received.add(received);
+        q.stats->packets_processed.add(filled + full + conflated);
+        q.stats->parse_errors.add(errors);
+        if (unlikely(full > 0)) {
+            q.stats->ring_buffer_full.add(full);
+        }
+    }
+}
+
+// Vectorized burst parse: gather payloads for the whole burst, parse them in
+// one call to the ISA-specific kernel, then publish. Native mode parses
+// straight into claimed ring slots and commits the burst once (as -B);
+// gateway mode parses into pool slots and converts each valid BBO.
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::process_burst_simd(RxQueue& q, rte_mbuf** pkts,
+                                             uint16_t count) {
+    BurstParseInput in[MAX_BURST_SIZE];
+    BBODataFast* out[MAX_BURST_SIZE];
+    uint32_t received = 0;
+
+    for (uint16_t i = 0; i < count; ++i) {
+        // Prefetch next packet's data into L1 cache
+        if (likely(i + 1 < count)) {
+            rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void*));
+        }
+
+        uint64_t ts = rdtsc();
+
+        const uint8_t* payload;
+        size_t payload_len;
+        if (likely(accept_bbo<Path>(q, pkts[i], payload, payload_len))) {
+            in[received].data = payload;
+            in[received].len = static_cast<uint32_t>(payload_len);
+            in[received].sequence = q.sequence++;
+            in[received].ts_ns = rx_timestamp_ns(pkts[i], ts);
+            ++received;
+        }
+    }
+
+    uint32_t parsed;
+    uint32_t full = 0;
+
+    if constexpr (Path::publish == PublishMode::NATIVE) {
+        BboFastRing& ring = *q.fast_ring;
+        const uint32_t claimed = ring.claim_batch(received);
+        for (uint32_t j = 0; j < claimed; ++j) {
+            out[j] = ring.batch_slot(j);
+        }
+
+        parsed = parse_burst_(in, claimed, out);
+        if constexpr (Path::fpga) {
+            pack_fpga_burst(q, in, out, parsed);
+        }
+        if (instruments_ != nullptr) {
+            for (uint32_t j = 0; j < parsed; ++j) {
+                stamp_instrument(*out[j]);
+            }
+        }
+
+        if (likely(parsed > 0)) {
+            const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+            ring.commit_batch(parsed);
+            if constexpr (Path::latency) {
+                record_latency(q, parsed_tsc, rdtsc(), parsed);
+            }
+        }
+        fan_out_burst(q, in, out, parsed);
+
+        // Overflow beyond the claim: fold into the cache, else drop
+        if (unlikely(claimed < received)) {
+            if (q.conflation) {
+                for (uint32_t j = claimed; j < received; ++j) {
+                    parsed += conflate_payload<Path>(q, in[j].data, in[j].len,
+                                               in[j].ts_ns, in[j].sequence);
+                }
+            } else {
+                full = received - claimed;
+                if (q.router || q.journal) {
+                    for (uint32_t j = claimed; j < received; ++j) {
+                        fan_out_payload(q, in[j].data, in[j].len, in[j].ts_ns, in[j].sequence);
+                    }
+                }
+            }
+        }
+    } else {
+        for (uint32_t j = 0; j < received; ++j) {
+            out[j] = q.bbo_pool.acquire();
+        }
+
+        parsed = parse_burst_(in, received, out);
+        if constexpr (Path::fpga) {
+            pack_fpga_burst(q, in, out, parsed);
+        }
+        const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+        for (uint32_t j = 0; j < parsed; ++j) {
+            convert_and_publish<Path>(q, *out[j]);
+        }
+        if (Path::latency && parsed > 0) {
+            record_latency(q, parsed_tsc, rdtsc(), parsed);
+        }
+        fan_out_burst(q, in, out, parsed);
+    }
+
+    if constexpr (Path::latency && !Path::fpga) {
+        for (uint32_t j = 0; j < received; ++j) {
+            record_fpga_latency(q, in[j].data, in[j].len);
+        }
+    }
+
+    // Payloads referenced mbuf data until here
+    rte_pktmbuf_free_bulk(pkts, count);
+
+    if constexpr (Path::stats) {
+        q.stats->packets_received.add(received);
+        q.stats->packets_processed.add(parsed + full);
+        q.stats->parse_errors.add(received - full - parsed);
+        if (unlikely(full > 0)) {
+            q.stats->ring_buffer_full.add(full);
+        }
+    }
+}
+
+// Decoded feed burst: every top-of-book change the decoder emits is
+// published on the spot (conflated behind a backlog, like the BBO path)
+template<typename Path, FeedDecoder Decoder>
+HOT_FUNC
+inline void DPDKReceiver::process_burst_feed(RxQueue& q, Decoder& decoder, rte_mbuf** pkts,
+                                             uint16_t count) {
+    uint32_t received = 0;
+    uint32_t errors = 0;
+
+    for (uint16_t i = 0; i < count; ++i) {
+        // Prefetch next packet's data into L1 cache
+        if (likely(i + 1 < count)) {
+            rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void*));
+        }
+
+        uint64_t ts = rdtsc();
+
+        const uint8_t* payload;
+        size_t payload_len;
+        if (likely(accept_payload<Path>(q, pkts[i], payload, payload_len))) {
+            ++received;
+            const bool ok = decoder.decode(payload, payload_len, rx_timestamp_ns(pkts[i], ts),
+                                           [this, &q](BBODataFast& bbo) {
+                                               publish_update<Path>(q, bbo);
+                                           });
+            errors += !ok;
+        }
+
+        rte_pktmbuf_free(pkts[i]);
+    }
+
+    if constexpr (Path::stats) {
+        q.stats->packets_received.add(received);
+        q.stats->packets_processed.add(received - errors);
+        if (unlikely(errors > 0)) {
+            q.stats->parse_errors.add(errors);
+        }
+    }
+}
+
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::publish_update(RxQueue& q, BBODataFast& bbo) {
+    bbo.sequence = q.sequence++;
+    const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+
+    if constexpr (Path::publish == PublishMode::NATIVE) {
+        stamp_instrument(bbo);
+        const bool backlog = (q.conflation != nullptr) && unlikely(q.conflation->has_dirty());
+        if (likely(!backlog) && likely(try_publish_native(q, bbo))) {
+            if constexpr (Path::latency) {
+                record_latency(q, parsed_tsc, rdtsc(), 1);
+            }
+        } else if (q.conflation) {
+            conflate<Path>(q, bbo);
+        } else if constexpr (Path::stats) {
+            q.stats->ring_buffer_full.add(1);
+        }
+        fan_out(q, bbo, nullptr, 0);
+        return;
+    }
+
+    convert_and_publish<Path>(q, bbo);
+    if constexpr (Path::latency) {
+        record_latency(q, parsed_tsc, rdtsc(), 1);
+    }
+    fan_out(q, bbo, nullptr, 0);
+}
+
+template<typename Path>
+HOT_FUNC
+inline bool DPDKReceiver::extract_payload(const RxQueue& q, rte_mbuf* pkt,
+                                          const uint8_t*& payload,
+                                          size_t& payload_len) const {
+    auto* base = rte_pktmbuf_mtod(pkt, uint8_t*);
+
+    // Marked by our flow rule: IPv4 (IHL=5) / UDP / our port already verified
+    if (config_.flow_mark && (pkt->ol_flags & RTE_MBUF_F_RX_FDIR_ID) &&
+        likely(pkt->hash.fdir.hi == BBO_FLOW_MARK)) {
+        auto* udp = reinterpret_cast<rte_udp_hdr*>(base + MARKED_UDP_OFFSET);
+        payload = base + MARKED_PAYLOAD_OFFSET;
+        payload_len = rte_be_to_cpu_16(udp->dgram_len) - sizeof(rte_udp_hdr);
+        return true;
+    }
 
     // Get Ethernet header
-    auto* eth = rte_pktmbuf_mtod(pkt, rte_ether_hdr*);
+    auto* eth = reinterpret_cast<rte_ether_hdr*>(base);
 
     // Fast check: IPv4?
     if (unlikely(eth->ether_type != rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4))) {
-        return;
+        return false;
     }
 
     // Get IP header
@@ -170,7 +986,7 @@ inline void DPDKReceiver::process_packet(rte_mbuf* pkt) {
 
     // Fast check: UDP?
     if (unlikely(ip->next_proto_id != IPPROTO_UDP)) {
-        return;
+        return false;
     }
 
     // Get UDP header (account for IP header length)
@@ -179,46 +995,198 @@ inline void DPDKReceiver::process_packet(rte_mbuf* pkt) {
         reinterpret_cast<uint8_t*>(ip) + ihl
     );
 
-    // Fast check: target port?
-    if (unlikely(rte_be_to_cpu_16(udp->dst_port) != config_.udp_port)) {
-        return;
+    // Fast check: target port? (an immediate with FIXED_UDP_PORT)
+    const uint16_t port = (Path::udp_port != 0) ? Path::udp_port : q.udp_port;
+    if (unlikely(udp->dst_port != rte_cpu_to_be_16(port))) {
+        return false;
     }
 
     // Extract payload
-    const uint8_t* payload = reinterpret_cast<uint8_t*>(udp + 1);
-    size_t payload_len = rte_be_to_cpu_16(udp->dgram_len) - sizeof(rte_udp_hdr);
+    payload = reinterpret_cast<uint8_t*>(udp + 1);
+    payload_len = rte_be_to_cpu_16(udp->dgram_len) - sizeof(rte_udp_hdr);
+    return true;
+}
+
+template<typename Path>
+HOT_FUNC
+inline bool DPDKReceiver::accept_payload(RxQueue& q, rte_mbuf* pkt,
+                                         const uint8_t*& payload, size_t& payload_len) {
+    if (unlikely(!extract_payload<Path>(q, pkt, payload, payload_len))) {
+        return false;
+    }
+    if (likely(q.arbiter == nullptr)) {
+        return true;
+    }
+
+    if (unlikely(payload_len < WIRE_SEQ_SIZE)) {
+        return false;
+    }
+    uint64_t seq;
+    std::memcpy(&seq, payload, sizeof(seq));
+    seq = __builtin_bswap64(seq);
+    payload += WIRE_SEQ_SIZE;
+    payload_len -= WIRE_SEQ_SIZE;
+
+    if (unlikely(q.arbiter->accept(seq) != ArbVerdict::FIRST)) {
+        if constexpr (Path::stats) {
+            q.stats->packets_dropped.add(1);
+        }
+        return false;
+    }
+
+    // BBO carries the wire sequence instead of the local counter
+    q.sequence = static_cast<uint32_t>(seq);
+    return true;
+}
+
+template<typename Path>
+HOT_FUNC
+inline bool DPDKReceiver::accept_bbo(RxQueue& q, rte_mbuf* pkt,
+                                     const uint8_t*& payload, size_t& payload_len) {
+    if (unlikely(!accept_payload<Path>(q, pkt, payload, payload_len))) {
+        return false;
+    }
+    // Short payloads fall through and count as parse errors
+    if (likely(!filter_.enabled()) || unlikely(payload_len < BBO_MIN_SIZE) ||
+        filter_.contains(payload + SYMBOL_OFFSET)) {
+        return true;
+    }
+    if constexpr (Path::stats) {
+        q.stats->packets_filtered.add(1);
+    }
+    return false;
+}
+
+HOT_FUNC
+inline uint64_t DPDKReceiver::rx_timestamp_ns(const rte_mbuf* pkt, uint64_t tsc) const {
+    // Conversion deferred to the consumer: TelemetrySegment::timestamp_to_ns()
+    if (config_.raw_tsc) {
+        return tsc;
+    }
+    if (nic_clock_.has_timestamp(pkt)) {
+        return nic_clock_.to_ns(pkt);
+    }
+    return tsc_.tsc_to_ns(tsc);
+}
+
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::process_packet(RxQueue& q, rte_mbuf* pkt) {
+    // Capture timestamp immediately
+    uint64_t ts = rdtsc();
+
+    const uint8_t* payload;
+    size_t payload_len;
+    if (unlikely(!accept_bbo<Path>(q, pkt, payload, payload_len))) {
+        return;
+    }
 
     // Update stats
-    if (config_.enable_stats) {
-        stats_.packets_received.fetch_add(1, std::memory_order_relaxed);
+    if constexpr (Path::stats) {
+        q.stats->packets_received.add(1);
     }
 
-    // Convert TSC to nanoseconds
-    uint64_t ts_ns = tsc_.cycles_to_ns(ts);
+    // NIC wire time if stamped, else TSC converted to nanoseconds
+    uint64_t ts_ns = rx_timestamp_ns(pkt, ts);
 
-    // Parse BBO
-    BBODataFast* bbo = BBOParserFast::parse(
-        payload, payload_len, bbo_pool_, ts_ns, sequence_++
-    );
+    bool parsed;
+    if constexpr (Path::publish == PublishMode::NATIVE) {
+        parsed = parse_and_publish_native<Path>(q, payload, payload_len, ts_ns);
+    } else {
+        // Parse BBO
+        BBODataFast* bbo = BBOParserFast::parse<Path::fpga>(
+            payload, payload_len, q.bbo_pool, ts_ns, q.sequence++
+        );
 
-    if (likely(bbo != nullptr)) {
-        convert_and_publish(*bbo);
+        parsed = (bbo != nullptr);
+        if (likely(parsed)) {
+            record_fpga_deltas<Path>(q, *bbo);
+            const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+            convert_and_publish<Path>(q, *bbo);
+            if constexpr (Path::latency) {
+                record_latency(q, parsed_tsc, rdtsc(), 1);
+            }
+            fan_out(q, *bbo, payload, payload_len);
+        }
+    }
 
-        if (config_.enable_stats) {
-            stats_.packets_processed.fetch_add(1, std::memory_order_relaxed);
+    if (Path::latency && !Path::fpga && likely(parsed)) {
+        record_fpga_latency(q, payload, payload_len);
+    }
+
+    if (likely(parsed)) {
+        if constexpr (Path::stats) {
+            q.stats->packets_processed.add(1);
         }
     } else {
-        if (config_.enable_stats) {
-            stats_.parse_errors.fetch_add(1, std::memory_order_relaxed);
+        if constexpr (Path::stats) {
+            q.stats->parse_errors.add(1);
         }
     }
 }
 
+template<typename Path>
 HOT_FUNC
-inline void DPDKReceiver::convert_and_publish(const BBODataFast& fast) {
-    // Convert to gateway::BBOData for shared memory
-    gateway::BBOData bbo;
+inline bool DPDKReceiver::parse_and_publish_native(RxQueue& q, const uint8_t* payload,
+                                                   size_t payload_len, uint64_t ts_ns) {
+    BBODataFast* slot = nullptr;
+    if (likely(q.conflation == nullptr) || likely(!q.conflation->has_dirty())) {
+        slot = q.fast_ring->claim();
+    }
 
+    if (unlikely(slot == nullptr) && q.conflation) {
+        return conflate_payload<Path>(q, payload, payload_len, ts_ns, q.sequence++);
+    }
+
+    if (unlikely(slot == nullptr)) {
+        // Ring full: still validate so parse_errors stays meaningful
+        if constexpr (Path::stats) {
+            q.stats->ring_buffer_full.add(1);
+        }
+        if (q.router || q.journal) {
+            return fan_out_payload(q, payload, payload_len, ts_ns, q.sequence++);
+        }
+        ++q.sequence;
+        return BBOParserFast::is_valid_bbo(payload, payload_len);
+    }
+
+    if (unlikely(!BBOParserFast::parse_into<Path::fpga>(payload, payload_len, *slot, ts_ns,
+                                                        q.sequence++))) {
+        return false;  // Slot not committed, reused by next claim()
+    }
+    stamp_instrument(*slot);
+    record_fpga_deltas<Path>(q, *slot);
+
+    const uint64_t parsed_tsc = Path::latency ? rdtsc() : 0;
+    q.fast_ring->commit();
+    if constexpr (Path::latency) {
+        record_latency(q, parsed_tsc, rdtsc(), 1);
+    }
+    fan_out(q, *slot, payload, payload_len);
+    return true;
+}
+
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::convert_and_publish(RxQueue& q, const BBODataFast& fast) {
+    if (q.conflation) {
+        // Queue behind an existing backlog so the cache keeps per-symbol order
+        if (unlikely(q.conflation->has_dirty()) ||
+            unlikely(!try_convert_and_publish(q, fast))) {
+            conflate<Path>(q, fast);
+        }
+        return;
+    }
+
+    if (unlikely(!try_convert_and_publish(q, fast))) {
+        if constexpr (Path::stats) {
+            q.stats->ring_buffer_full.add(1);
+        }
+    }
+}
+
+HOT_FUNC
+inline void DPDKReceiver::to_gateway(const BBODataFast& fast, gateway::BBOData& bbo) {
     // Copy symbol (8 bytes from fast, pad to 16 in gateway)
     std::memcpy(bbo.symbol, fast.symbol, 8);
     for (size_t i = 8; i < gateway::BBOData::SYMBOL_MAX_LEN; ++i) {
@@ -226,31 +1194,108 @@ inline void DPDKReceiver::convert_and_publish(const BBODataFast& fast) {
     }
     bbo.symbol[gateway::BBOData::SYMBOL_MAX_LEN - 1] = '\0';
 
-    bbo.bid_price = fast.bid_price;
-    bbo.ask_price = fast.ask_price;
+    // gateway::BBOData is double-priced; no-op conversion for FloatPrice
+    bbo.bid_price = fast.bid_price_f();
+    bbo.ask_price = fast.ask_price_f();
     bbo.bid_shares = fast.bid_shares;
     bbo.ask_shares = fast.ask_shares;
-    bbo.spread = fast.spread;
+    bbo.spread = fast.spread_f();
     bbo.timestamp_ns = static_cast<int64_t>(fast.timestamp_ns);
     bbo.valid = (fast.valid != 0);
 
-    // FPGA timestamps not available in hot path
+    // Absolute FPGA timestamps are not carried; stage latencies are with
+    // fpga_deltas (HAS_FPGA_DELTAS)
     bbo.fpga_ts_t1 = 0;
     bbo.fpga_ts_t2 = 0;
     bbo.fpga_ts_t3 = 0;
     bbo.fpga_ts_t4 = 0;
-    bbo.fpga_latency_a_us = 0;
-    bbo.fpga_latency_b_us = 0;
-    bbo.fpga_latency_us = 0;
+    if (fast.flags & BboFlags::HAS_FPGA_DELTAS) {
+        constexpr double US_PER_CYCLE = FPGA_NS_PER_CYCLE * 0.001;
+        const FpgaDeltas d = fast.fpga_deltas();
+        bbo.fpga_latency_a_us = d.parse_to_cdc * US_PER_CYCLE;
+        bbo.fpga_latency_b_us = d.fifo_to_tx * US_PER_CYCLE;
+        bbo.fpga_latency_us = d.total() * US_PER_CYCLE;
+    } else {
+        bbo.fpga_latency_a_us = 0;
+        bbo.fpga_latency_b_us = 0;
+        bbo.fpga_latency_us = 0;
+    }
     bbo.fpga_rx_timestamp = 0;
     bbo.fpga_tx_timestamp = 0;
+}
+
+HOT_FUNC
+inline bool DPDKReceiver::try_convert_and_publish(RxQueue& q, const BBODataFast& fast) {
+    // Convert to gateway::BBOData for shared memory
+    gateway::BBOData bbo;
+    to_gateway(fast, bbo);
 
     // Publish to ring buffer
-    if (unlikely(!ring_buffer_->try_publish(bbo))) {
-        if (config_.enable_stats) {
-            stats_.ring_buffer_full.fetch_add(1, std::memory_order_relaxed);
+    return q.ring_buffer->try_publish(bbo);
+}
+
+HOT_FUNC
+inline bool DPDKReceiver::try_publish_native(RxQueue& q, const BBODataFast& fast) {
+    BBODataFast* slot = q.fast_ring->claim();
+    if (unlikely(slot == nullptr)) {
+        return false;
+    }
+    *slot = fast;
+    q.fast_ring->commit();
+    return true;
+}
+
+template<typename Path>
+HOT_FUNC
+inline void DPDKReceiver::conflate(RxQueue& q, const BBODataFast& fast) {
+    if (likely(q.conflation->update(fast))) {
+        if constexpr (Path::stats) {
+            q.stats->conflated.add(1);
         }
+    } else {
+        // Table at its load limit: nowhere to keep it
+        if constexpr (Path::stats) {
+            q.stats->ring_buffer_full.add(1);
+        }
+    }
+}
+
+template<typename Path>
+HOT_FUNC
+inline bool DPDKReceiver::conflate_payload(RxQueue& q, const uint8_t* payload,
+                                           size_t payload_len, uint64_t ts_ns,
+                                           uint32_t sequence) {
+    BBODataFast bbo;
+    if (unlikely(!BBOParserFast::parse_into<Path::fpga>(payload, payload_len, bbo, ts_ns,
+                                                        sequence))) {
+        return false;
     }
+    stamp_instrument(bbo);
+    record_fpga_deltas<Path>(q, bbo);
+    conflate<Path>(q, bbo);
+    fan_out(q, bbo, payload, payload_len);
+    return true;
+}
+
+HOT_FUNC
+inline void DPDKReceiver::record_latency(RxQueue& q, uint64_t parsed_tsc,
+                                         uint64_t published_tsc, uint32_t n) {
+    q.latency->record(LatencyStage::RX_TO_PARSE, parsed_tsc - q.rx_tsc, n);
+    q.latency->record(LatencyStage::PARSE_TO_PUBLISH, published_tsc - parsed_tsc, n);
+    q.latency->record(LatencyStage::RX_TO_PUBLISH, published_tsc - q.rx_tsc, n);
+}
+
+HOT_FUNC
+inline void DPDKReceiver::record_fpga_latency(RxQueue& q, const uint8_t* payload,
+                                              size_t payload_len) {
+    if (payload_len < BBO_FULL_SIZE) {
+        return;  // No HAS_FPGA_TIMESTAMPS
+    }
+
+    uint32_t t[4];
+    std::memcpy(t, payload + T1_OFFSET, sizeof(t));
+    q.latency->record_fpga(__builtin_bswap32(t[0]), __builtin_bswap32(t[1]),
+                           __builtin_bswap32(t[2]), __builtin_bswap32(t[3]));
 }
 
 }  // namespace ultra_ll
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "likely.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace ultra_ll {
+
+// Wire sequence prefix: 8-byte big-endian feed sequence before the BBO
+constexpr size_t WIRE_SEQ_SIZE = 8;
+
+enum class ArbVerdict : uint8_t {
+    FIRST,      // First copy of this sequence: publish
+    DUPLICATE,  // Already seen on this or the other line: drop
+    STALE,      // Older than the window: drop
+};
+
+// Sequence arbitration for one logical feed (one line, or an A/B pair)
+//
+// Keeps the first copy of every sequence number and drops later copies,
+// using a bitmap over the last WINDOW sequences below the highest seen.
+// Jumps ahead count the skipped numbers as gaps; a number that later
+// arrives late (from the slower line, or reordered) fills its gap.
+// missing = gaps - filled is the loss neither line delivered.
+//
+// Single writer (the lcore polling every line of the feed); counters are
+// relaxed atomics so the stats thread can read them.
+//
+template<size_t WINDOW = 1024>
+class FeedArbiterT {
+    static_assert((WINDOW & (WINDOW - 1)) == 0 && WINDOW >= 64, "WINDOW must be a power of 2 >= 64");
+    static constexpr size_t WORDS = WINDOW / 64;
+
+    uint64_t seen_[WORDS];
+    uint64_t high_ = 0;             // Highest sequence accepted
+    uint32_t stale_run_ = 0;        // Consecutive STALE verdicts (feed restart detection)
+    bool started_ = false;
+
+    alignas(64) std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> filled_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> resyncs_{0};
+
+public:
+    FeedArbiterT() { reset(); }
+
+    // Non-copyable
+    FeedArbiterT(const FeedArbiterT&) = delete;
+    FeedArbiterT& operator=(const FeedArbiterT&) = delete;
+
+    HOT_FUNC
+    ArbVerdict accept(uint64_t seq) noexcept {
+        if (likely(seq > high_) && likely(started_)) {
+            const uint64_t ahead = seq - high_;
+            if (likely(ahead == 1)) {
+                clear_bit(seq);
+            } else {
+                advance(ahead);
+            }
+            high_ = seq;
+            set_bit(seq);
+            stale_run_ = 0;
+            return ArbVerdict::FIRST;
+        }
+
+        if (unlikely(!started_)) {
+            start(seq);
+            return ArbVerdict::FIRST;
+        }
+
+        if (unlikely(high_ - seq >= WINDOW)) {
+            return stale(seq);
+        }
+
+        stale_run_ = 0;
+        if (test_bit(seq)) {
+            return ArbVerdict::DUPLICATE;
+        }
+
+        // Late first copy of a number counted as a gap
+        set_bit(seq);
+        filled_.fetch_add(1, std::memory_order_relaxed);
+        return ArbVerdict::FIRST;
+    }
+
+    // Forget all state (counters kept); next sequence starts the feed
+    void reset() noexcept {
+        std::memset(seen_, 0, sizeof(seen_));
+        high_ = 0;
+        stale_run_ = 0;
+        started_ = false;
+    }
+
+    void reset_counters() noexcept {
+        gaps_.store(0, std::memory_order_relaxed);
+        filled_.store(0, std::memory_order_relaxed);
+        stale_.store(0, std::memory_order_relaxed);
+        resyncs_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t gaps() const noexcept { return gaps_.load(std::memory_order_relaxed); }
+    uint64_t filled() const noexcept { return filled_.load(std::memory_order_relaxed); }
+    uint64_t missing() const noexcept { return gaps() - filled(); }
+    uint64_t stale() const noexcept { return stale_.load(std::memory_order_relaxed); }
+    uint64_t resyncs() const noexcept { return resyncs_.load(std::memory_order_relaxed); }
+    uint64_t highest() const noexcept { return high_; }    // Writer lcore only
+
+    static constexpr size_t window() noexcept { return WINDOW; }
+
+private:
+    FORCE_INLINE void set_bit(uint64_t seq) noexcept {
+        seen_[(seq / 64) & (WORDS - 1)] |= uint64_t{1} << (seq & 63);
+    }
+    FORCE_INLINE void clear_bit(uint64_t seq) noexcept {
+        seen_[(seq / 64) & (WORDS - 1)] &= ~(uint64_t{1} << (seq & 63));
+    }
+    FORCE_INLINE bool test_bit(uint64_t seq) const noexcept {
+        return (seen_[(seq / 64) & (WORDS - 1)] >> (seq & 63)) & 1;
+    }
+
+    // Slide the window over the skipped numbers (rare: only on gaps)
+    void advance(uint64_t ahead) noexcept {
+        gaps_.fetch_add(ahead - 1, std::memory_order_relaxed);
+        if (ahead >= WINDOW) {
+            std::memset(seen_, 0, sizeof(seen_));
+            return;
+        }
+        for (uint64_t s = high_ + 1; s <= high_ + ahead; ++s) {
+            clear_bit(s);
+        }
+    }
+
+    void start(uint64_t seq) noexcept {
+        std::memset(seen_, 0, sizeof(seen_));
+        high_ = seq;
+        set_bit(seq);
+        started_ = true;
+        stale_run_ = 0;
+    }
+
+    // A full window of consecutive stale numbers means the feed restarted
+    // its sequence: follow it instead of dropping everything
+    ArbVerdict stale(uint64_t seq) noexcept {
+        stale_.fetch_add(1, std::memory_order_relaxed);
+        if (unlikely(++stale_run_ >= WINDOW)) {
+            resyncs_.fetch_add(1, std::memory_order_relaxed);
+            start(seq);
+            return ArbVerdict::FIRST;
+        }
+        return ArbVerdict::STALE;
+    }
+};
+
+// Default: 1024-sequence window (128-byte bitmap)
+using FeedArbiter = FeedArbiterT<1024>;
+
+}  // namespace ultra_ll
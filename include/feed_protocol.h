@@ -0,0 +1,84 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "bbo_parser_fast.h"
+#include "likely.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace ultra_ll {
+
+// Wire protocol of the feed a receiver decodes
+enum class FeedProtocol : uint8_t {
+    BBO,        // FPGA BBO: one 28/44-byte BBO per datagram (BBOParserFast)
+    ITCH,       // NASDAQ TotalView-ITCH 5.0 over MoldUDP64, book built in software
+    SBE,        // Simple Binary Encoding, layout from a compile-time schema
+};
+
+inline const char* feed_protocol_name(FeedProtocol p) {
+    switch (p) {
+        case FeedProtocol::BBO:  return "bbo";
+        case FeedProtocol::ITCH: return "itch";
+        case FeedProtocol::SBE:  return "sbe";
+    }
+    return "?";
+}
+
+// Feed decoder policy
+//
+// decode() takes one UDP payload and calls emit(BBODataFast&) for every
+// top-of-book change it produces (zero, one or many per datagram). It
+// fills symbol, prices, shares, timestamp_ns, valid and flags; the
+// receiver assigns sequence and publishes. Returns false for a malformed
+// datagram (counted as a parse error).
+//
+// Decoders are concrete types chosen at compile time: the receiver
+// instantiates one burst loop per policy, so emit() and the message
+// switch inline into it with no virtual calls.
+//
+using FeedEmitSignature = void (*)(BBODataFast&);
+
+template<typename D>
+concept FeedDecoder = requires(D& d, const uint8_t* data, size_t len, uint64_t ts_ns,
+                               FeedEmitSignature emit) {
+    { d.decode(data, len, ts_ns, emit) } -> std::same_as<bool>;
+};
+
+// Fill the non-price part of an emitted BBO (whole line written)
+FORCE_INLINE void init_feed_bbo(BBODataFast& out, const char* symbol, uint64_t ts_ns) noexcept {
+    std::memset(&out, 0, sizeof(out));
+    std::memcpy(out.symbol, symbol, 8);
+    out.timestamp_ns = ts_ns;
+    out.valid = 1;
+}
+
+// Top of book from raw 1/10000 ticks; a missing side is 0 / 0
+FORCE_INLINE void set_feed_bbo_prices(BBODataFast& out, uint32_t bid, uint32_t bid_shares,
+                                      uint32_t ask, uint32_t ask_shares) noexcept {
+    out.bid_price = BBOPrice::from_raw(bid);
+    out.ask_price = BBOPrice::from_raw(ask);
+    out.bid_shares = bid_shares;
+    out.ask_shares = ask_shares;
+    out.spread = BBOPrice::from_raw((bid_shares && ask_shares && ask > bid) ? ask - bid : 0);
+}
+
+// The FPGA BBO format as a decoder policy (one BBO per datagram)
+// DPDKReceiver keeps its specialized BBO paths (batched, SIMD); this
+// adapter lets BBO feeds run through the same generic harnesses
+struct BboFeedDecoder {
+    template<typename Emit>
+    HOT_FUNC bool decode(const uint8_t* data, size_t len, uint64_t ts_ns, Emit&& emit) noexcept {
+        BBODataFast bbo;
+        if (unlikely(!BBOParserFast::parse_into(data, len, bbo, ts_ns))) {
+            return false;
+        }
+        emit(bbo);
+        return true;
+    }
+};
+
+static_assert(FeedDecoder<BboFeedDecoder>);
+
+}  // namespace ultra_ll
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <rte_ethdev.h>
+#include <rte_flow.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ultra_ll {
+
+// Flow mark stamped by our rules (mbuf->hash.fdir.hi with RTE_MBUF_F_RX_FDIR_ID)
+// A marked frame is guaranteed IPv4 (IHL=5) / UDP / subscribed port, so the
+// fast path can jump straight to the payload
+constexpr uint32_t BBO_FLOW_MARK = 0xB0B0;
+constexpr size_t MARKED_UDP_OFFSET = 14 + 20;               // Ethernet + IPv4 (no options)
+constexpr size_t MARKED_PAYLOAD_OFFSET = MARKED_UDP_OFFSET + 8;
+
+constexpr uint16_t MAX_MCAST_GROUPS = 8;
+constexpr size_t MAX_FLOW_RULES = 64;
+
+// rte_flow rule set for one port
+//
+// All rules live at priority 0 except the optional catch-all drop at
+// priority 1, so anything not explicitly matched is discarded in the NIC.
+// Rules are destroyed with the set (before the port is closed).
+//
+class FlowRules {
+public:
+    explicit FlowRules(uint16_t port_id) : port_id_(port_id) {}
+    ~FlowRules() { clear(); }
+
+    // Non-copyable (owns rte_flow handles)
+    FlowRules(const FlowRules&) = delete;
+    FlowRules& operator=(const FlowRules&) = delete;
+
+    // IPv4 / UDP dst_port [/ IPv4 dst == group] -> queue
+    // dst_group_be: multicast group in network byte order, 0 = any
+    bool add_queue_rule(uint16_t udp_port, uint32_t dst_group_be, uint16_t queue, bool mark);
+
+    // IPv4 / UDP dst_port [/ IPv4 dst == group] -> RSS over queues[0..nb_queues)
+    bool add_rss_rule(uint16_t udp_port, uint32_t dst_group_be,
+                      const uint16_t* queues, uint16_t nb_queues, bool mark);
+
+    // Lowest priority: drop everything no other rule matched
+    bool add_drop_all();
+
+    // Destroy all rules created by this set
+    void clear();
+
+    size_t size() const { return count_; }
+
+private:
+    uint16_t port_id_;
+    rte_flow* rules_[MAX_FLOW_RULES] = {};
+    size_t count_ = 0;
+
+    bool create(uint32_t priority, const rte_flow_item* pattern,
+                const rte_flow_action* actions, const char* what);
+};
+
+// Multicast group (network byte order) -> Ethernet multicast MAC 01:00:5e:xx:xx:xx
+inline rte_ether_addr mcast_group_to_mac(uint32_t group_be) {
+    const uint32_t group = rte_be_to_cpu_32(group_be);
+    rte_ether_addr mac;
+    mac.addr_bytes[0] = 0x01;
+    mac.addr_bytes[1] = 0x00;
+    mac.addr_bytes[2] = 0x5E;
+    mac.addr_bytes[3] = static_cast<uint8_t>((group >> 16) & 0x7F);
+    mac.addr_bytes[4] = static_cast<uint8_t>(group >> 8);
+    mac.addr_bytes[5] = static_cast<uint8_t>(group);
+    return mac;
+}
+
+}  // namespace ultra_ll
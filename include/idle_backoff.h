@@ -0,0 +1,129 @@
+#pragma once
+
+#include "likely.h"
+#include "rdtsc.h"
+
+#include <rte_cpuflags.h>
+#include <rte_ethdev.h>
+#include <rte_pause.h>
+#include <rte_power_intrinsics.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace ultra_ll {
+
+// Idle policy for one poll loop; spin_polls == 0 keeps the pure busy-spin
+struct IdleConfig {
+    uint32_t spin_polls = 0;        // Empty polls spun hot before backing off (0 = never back off)
+    uint32_t pause_polls = 1024;    // Then empty polls with rte_pause() before power monitor
+    uint32_t monitor_us = 100;      // Max time per UMWAIT (bounds the running_ check), 0 = pause only
+};
+
+// Empty-poll backoff: spin -> rte_pause() -> rte_power_monitor()
+//
+// The poll loop calls on_empty() after every empty rx burst and on_packets()
+// after a non-empty one. The first packet always returns the loop to hot
+// spinning. In the monitor stage the core sleeps in UMWAIT (C0.1/C0.2) on
+// the address of the next RX descriptor the NIC writes, so a DMA write
+// wakes it; the deadline caps each sleep so stop() is still noticed.
+//
+// Single writer (the polling lcore); counters are relaxed atomics read by
+// the stats thread.
+//
+class IdleBackoff {
+public:
+    // Cold: resolve monitor support once per queue
+    void init(const IdleConfig& cfg, uint16_t port_id, uint16_t queue_id,
+              const TSCCalibrator& tsc) {
+        port_id_ = port_id;
+        queue_id_ = queue_id;
+        spin_polls_ = cfg.spin_polls ? cfg.spin_polls : ~uint64_t{0};
+        monitor_after_ = cfg.spin_polls ? spin_polls_ + cfg.pause_polls : ~uint64_t{0};
+        monitor_cycles_ = tsc.ns_to_cycles(uint64_t{cfg.monitor_us} * 1000);
+
+        rte_cpu_intrinsics intr{};
+        rte_cpu_get_intrinsics_support(&intr);
+        can_monitor_ = cfg.spin_polls && cfg.monitor_us && intr.power_monitor;
+    }
+
+    bool enabled() const { return spin_polls_ != ~uint64_t{0}; }
+    bool can_monitor() const { return can_monitor_; }
+
+    // True once the loop has left hot spinning (the next packet is a wake-up)
+    FORCE_INLINE bool backed_off() const { return empty_ > spin_polls_; }
+
+    FORCE_INLINE void on_empty() {
+        if (likely(++empty_ <= spin_polls_)) {
+            return;
+        }
+        wait();
+    }
+
+    FORCE_INLINE void on_packets() { empty_ = 0; }
+
+    // TSC at which the last wait returned (wake-up latency without NIC stamps)
+    uint64_t wait_end() const { return wait_end_tsc_; }
+
+    // Wake-up cost, recorded by the poll loop in TSC cycles
+    void record_wakeup(uint64_t cycles) {
+        wakeups_.store(wakeups_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        wake_cycles_.store(wake_cycles_.load(std::memory_order_relaxed) + cycles,
+                           std::memory_order_relaxed);
+        if (cycles > wake_max_.load(std::memory_order_relaxed)) {
+            wake_max_.store(cycles, std::memory_order_relaxed);
+        }
+    }
+
+    void reset_counters() {
+        pauses_.store(0, std::memory_order_relaxed);
+        monitors_.store(0, std::memory_order_relaxed);
+        wakeups_.store(0, std::memory_order_relaxed);
+        wake_cycles_.store(0, std::memory_order_relaxed);
+        wake_max_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t pauses() const { return pauses_.load(std::memory_order_relaxed); }
+    uint64_t monitors() const { return monitors_.load(std::memory_order_relaxed); }
+    uint64_t wakeups() const { return wakeups_.load(std::memory_order_relaxed); }
+    uint64_t wake_cycles() const { return wake_cycles_.load(std::memory_order_relaxed); }
+    uint64_t wake_max() const { return wake_max_.load(std::memory_order_relaxed); }
+
+private:
+    uint64_t empty_ = 0;                // Consecutive empty polls
+    uint64_t spin_polls_ = ~uint64_t{0};
+    uint64_t monitor_after_ = ~uint64_t{0};
+    uint64_t monitor_cycles_ = 0;
+    uint64_t wait_end_tsc_ = 0;
+    uint16_t port_id_ = 0;
+    uint16_t queue_id_ = 0;
+    bool can_monitor_ = false;
+
+    alignas(64) std::atomic<uint64_t> pauses_{0};
+    std::atomic<uint64_t> monitors_{0};
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<uint64_t> wake_cycles_{0};
+    std::atomic<uint64_t> wake_max_{0};
+
+    // Idle only: keep it out of the spinning loop body
+    NEVER_INLINE void wait() {
+        if (can_monitor_ && empty_ > monitor_after_) {
+            // Descriptor address moves with the ring: re-read before each sleep
+            rte_power_monitor_cond pmc;
+            if (unlikely(rte_eth_get_monitor_addr(port_id_, queue_id_, &pmc) != 0)) {
+                can_monitor_ = false;   // PMD has no monitor address: pause from now on
+            } else if (rte_power_monitor(&pmc, rdtsc() + monitor_cycles_) == 0) {
+                monitors_.store(monitors_.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+                wait_end_tsc_ = rdtsc();
+                return;
+            }
+        }
+
+        rte_pause();
+        pauses_.store(pauses_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        wait_end_tsc_ = rdtsc();
+    }
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "likely.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ultra_ll {
+
+// Symbol -> dense instrument ID map, exported through shared memory
+//
+// The receiver stamps every native BBO with BBODataFast::instrument_id so
+// strategies index per-instrument arrays directly instead of comparing or
+// hashing the 8-byte ticker. IDs are 1..CAPACITY-1 in order of first
+// appearance (0 = not interned): the reference list loaded at startup
+// takes the low IDs, symbols first seen on the feed are appended.
+//
+// Memory layout (placed in shared memory by the receiver):
+// - Line 0: header (magic, capacity) - read-only after creation
+// - Line 1: next ID + overflow counter (writers)
+// - symbols: CAPACITY x 8 bytes, symbols[id] = wire symbol
+// - index:   2 x CAPACITY slots {key, id}, open-addressed on the symbol
+//
+// Writers (every poll lcore) insert lock-free: CAS on the slot key claims
+// it, fetch_add on next_id assigns the ID, symbols[id] is written and the
+// slot's id is published with a release store. A BBO carrying an ID is
+// published after that store, so a consumer holding the ID can read
+// symbol(id) without synchronization. Mapping an existing valid segment
+// keeps its IDs (stable across receiver restarts).
+//
+template<size_t CAPACITY = 16384>
+class InstrumentMapT {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be power of 2");
+    static_assert(CAPACITY <= 65536, "IDs must fit uint16_t");
+
+    static constexpr size_t SLOTS = CAPACITY * 2;
+    static constexpr int HASH_SHIFT = 64 - __builtin_ctzll(SLOTS);
+    static constexpr uint32_t PENDING = 0;          // Slot claimed, ID not yet published
+    static constexpr uint32_t FULL = 0xFFFFFFFF;    // Slot claimed after the map filled up
+
+    struct alignas(16) Slot {
+        std::atomic<uint64_t> key;      // 0 = empty
+        std::atomic<uint32_t> id;
+        uint32_t reserved;
+    };
+
+public:
+    static constexpr uint64_t MAGIC = 0x4242'4F49'4E53'5431ULL;  // "BBOINST1"
+    static constexpr uint16_t NONE = 0;
+
+    // Segment is zero-filled by ftruncate(): index empty, symbols blank
+    InstrumentMapT() noexcept {
+        magic_ = MAGIC;
+        capacity_ = CAPACITY;
+        slots_ = SLOTS;
+        next_id_.store(1, std::memory_order_relaxed);
+    }
+
+    // Non-copyable (lives in shared memory)
+    InstrumentMapT(const InstrumentMapT&) = delete;
+    InstrumentMapT& operator=(const InstrumentMapT&) = delete;
+
+    // Validate a mapping created by another process
+    bool is_valid() const noexcept {
+        return magic_ == MAGIC && capacity_ == CAPACITY && slots_ == SLOTS;
+    }
+
+    // ---- Producer side (any poll lcore) ----
+
+    // ID of an 8-byte wire symbol, assigning one on first sight;
+    // NONE if the map is full
+    HOT_FUNC
+    uint16_t intern(const char* symbol) noexcept {
+        uint64_t key;
+        std::memcpy(&key, symbol, sizeof(key));
+        return intern_key(key);
+    }
+
+    HOT_FUNC
+    uint16_t intern_key(uint64_t key) noexcept {
+        if (unlikely(key == 0)) {
+            return NONE;
+        }
+        for (size_t i = slot_of(key);; i = (i + 1) & (SLOTS - 1)) {
+            const uint64_t k = index_[i].key.load(std::memory_order_acquire);
+            if (likely(k == key)) {
+                return wait_id(index_[i]);
+            }
+            if (k == 0) {
+                return insert(key, i);
+            }
+        }
+    }
+
+    // ---- Consumer side ----
+
+    // Symbol of an ID taken from a BBO (8 bytes, space padded, no NUL)
+    const char* symbol(uint16_t id) const noexcept { return symbols_[id]; }
+
+    // Lookup without inserting (NONE if unknown or still being assigned)
+    uint16_t find(const char* symbol) const noexcept {
+        uint64_t key;
+        std::memcpy(&key, symbol, sizeof(key));
+        if (key == 0) {
+            return NONE;
+        }
+        for (size_t i = slot_of(key);; i = (i + 1) & (SLOTS - 1)) {
+            const uint64_t k = index_[i].key.load(std::memory_order_acquire);
+            if (k == key) {
+                const uint32_t id = index_[i].id.load(std::memory_order_acquire);
+                return (id == PENDING || id == FULL) ? NONE : static_cast<uint16_t>(id);
+            }
+            if (k == 0) {
+                return NONE;
+            }
+        }
+    }
+
+    // Assigned IDs are 1..size()
+    uint32_t size() const noexcept {
+        const uint32_t next = next_id_.load(std::memory_order_acquire);
+        return (next < CAPACITY ? next : CAPACITY) - 1;
+    }
+
+    uint64_t overflow() const noexcept { return overflow_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+private:
+    // Line 0: header
+    uint64_t magic_;
+    uint32_t capacity_;
+    uint32_t slots_;
+
+    // Line 1: writer counters
+    alignas(64) std::atomic<uint32_t> next_id_;
+    std::atomic<uint64_t> overflow_{0};
+
+    alignas(64) char symbols_[CAPACITY][8];
+    Slot index_[SLOTS];
+
+    FORCE_INLINE static size_t slot_of(uint64_t key) noexcept {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> HASH_SHIFT);
+    }
+
+    // Another lcore may have claimed the slot and not yet published the ID
+    FORCE_INLINE static uint16_t wait_id(const Slot& s) noexcept {
+        uint32_t id;
+        while (unlikely((id = s.id.load(std::memory_order_acquire)) == PENDING)) {
+            __builtin_ia32_pause();
+        }
+        return id == FULL ? NONE : static_cast<uint16_t>(id);
+    }
+
+    // New symbol: once per instrument per session, kept out of line
+    NEVER_INLINE
+    uint16_t insert(uint64_t key, size_t i) noexcept {
+        // Stop claiming slots once full, so garbage symbols cannot fill the index
+        if (unlikely(next_id_.load(std::memory_order_relaxed) >= CAPACITY)) {
+            overflow_.fetch_add(1, std::memory_order_relaxed);
+            return NONE;
+        }
+
+        for (;; i = (i + 1) & (SLOTS - 1)) {
+            uint64_t expected = 0;
+            if (index_[i].key.compare_exchange_strong(expected, key,
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire)) {
+                const uint32_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+                if (unlikely(id >= CAPACITY)) {
+                    overflow_.fetch_add(1, std::memory_order_relaxed);
+                    index_[i].id.store(FULL, std::memory_order_release);
+                    return NONE;
+                }
+                std::memcpy(symbols_[id], &key, sizeof(key));
+                index_[i].id.store(id, std::memory_order_release);
+                return static_cast<uint16_t>(id);
+            }
+            if (expected == key) {
+                return wait_id(index_[i]);     // Lost the race for this symbol
+            }
+        }
+    }
+};
+
+// 16384 instruments: 128 KB symbols + 512 KB index
+using InstrumentMap = InstrumentMapT<16384>;
+
+}  // namespace ultra_ll
@@ -0,0 +1,551 @@
+#pragma once
+
+#include "feed_protocol.h"
+#include "likely.h"
+#include "mold_udp.h"
+#include "numa_util.h"
+#include "symbol_filter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+
+namespace ultra_ll {
+
+// NASDAQ TotalView-ITCH 5.0 order messages (type, size)
+// Common header: type(1) stock_locate(2) tracking(2) timestamp(6)
+namespace itch {
+    constexpr uint8_t ADD_ORDER = 'A';          // 36
+    constexpr uint8_t ADD_ORDER_MPID = 'F';     // 40
+    constexpr uint8_t ORDER_EXECUTED = 'E';     // 31
+    constexpr uint8_t EXECUTED_PRICE = 'C';     // 36
+    constexpr uint8_t ORDER_CANCEL = 'X';       // 23
+    constexpr uint8_t ORDER_DELETE = 'D';       // 19
+    constexpr uint8_t ORDER_REPLACE = 'U';      // 35
+
+    constexpr size_t ADD_ORDER_SIZE = 36;
+    constexpr size_t ORDER_EXECUTED_SIZE = 31;
+    constexpr size_t ORDER_CANCEL_SIZE = 23;
+    constexpr size_t ORDER_DELETE_SIZE = 19;
+    constexpr size_t ORDER_REPLACE_SIZE = 35;
+
+    constexpr size_t LOCATE_OFFSET = 1;
+    constexpr size_t ORDER_REF_OFFSET = 11;
+    constexpr size_t ADD_SIDE_OFFSET = 19;
+    constexpr size_t ADD_SHARES_OFFSET = 20;
+    constexpr size_t ADD_STOCK_OFFSET = 24;
+    constexpr size_t ADD_PRICE_OFFSET = 32;
+    constexpr size_t EXEC_SHARES_OFFSET = 19;   // E, C
+    constexpr size_t CANCEL_SHARES_OFFSET = 19; // X
+    constexpr size_t REPLACE_NEW_REF_OFFSET = 19;
+    constexpr size_t REPLACE_SHARES_OFFSET = 27;
+    constexpr size_t REPLACE_PRICE_OFFSET = 31;
+}  // namespace itch
+
+// Native ITCH 5.0 decoder: builds the top of book from the order flow
+//
+// Orders live in an open-addressing table keyed by order reference
+// (linear probing, backward-shift delete, no tombstones). Each instrument
+// (ITCH stock_locate) gets a book of LEVELS aggregated price levels per
+// side, sorted best first. Levels beyond LEVELS are not tracked
+// (book_overflow): the top stays exact as long as fewer than LEVELS
+// levels are live.
+//
+// A datagram is split into its messages in one pass (MoldPacket), then
+// applied in order, prefetching the order-table slot of the message
+// prefetch_distance ahead. Books whose level 0 changed are marked dirty;
+// after the last message each dirty book emits one BBO if its top differs
+// from the one last emitted. A 20-message packet on 3 symbols costs at
+// most 3 publishes (coalesced() counts the changes folded away).
+//
+// With a SymbolFilter, books of unsubscribed symbols keep only their
+// orders (so executes / cancels still resolve) and never build levels or
+// publish.
+//
+// Prices are ITCH Price(4), i.e. the same 1/10000 ticks as the FPGA BBO.
+// Single writer (the queue's poll lcore); counters are relaxed atomics.
+//
+template<size_t MAX_BOOKS = 16384, size_t LEVELS = 32, size_t ORDER_CAPACITY = (1u << 21)>
+class ItchBookBuilderT {
+    static_assert((ORDER_CAPACITY & (ORDER_CAPACITY - 1)) == 0, "ORDER_CAPACITY must be a power of 2");
+    static_assert(MAX_BOOKS < 0xFFFF, "Book index must fit uint16_t");
+
+    static constexpr uint16_t NO_BOOK = 0xFFFF;
+    static constexpr size_t LOCATES = 65536;
+    static constexpr size_t MAX_LOAD = ORDER_CAPACITY - ORDER_CAPACITY / 4;   // 75%
+
+    struct Order {
+        uint64_t ref;           // 0 = empty slot
+        uint32_t price;
+        uint32_t shares;
+        uint16_t book;
+        uint8_t side;           // 0 = bid, 1 = ask
+    };
+
+    struct Level {
+        uint32_t price;
+        uint32_t shares;
+    };
+
+    struct Book {
+        char symbol[8];
+        uint16_t depth[2];
+        uint8_t dirty;              // Level 0 changed in the current packet
+        uint8_t subscribed;         // In the filter (or no filter): levels maintained
+        Level shown[2];             // Top as last emitted
+        Level levels[2][LEVELS];    // [side][0] is the best
+    };
+
+public:
+    // prefetch_distance: messages to look ahead (0 = off)
+    explicit ItchBookBuilderT(int numa_node = NUMA_NODE_ANY, uint32_t prefetch_distance = 0)
+        : prefetch_(prefetch_distance) {
+        orders_ = static_cast<Order*>(allocate(ORDER_BYTES, numa_node, orders_huge_));
+        books_ = static_cast<Book*>(allocate(BOOK_BYTES, numa_node, books_huge_));
+        std::memset(orders_, 0, ORDER_BYTES);
+        std::memset(books_, 0, BOOK_BYTES);
+        std::memset(book_of_, 0xFF, sizeof(book_of_));
+    }
+
+    ~ItchBookBuilderT() {
+        release(orders_, ORDER_BYTES, orders_huge_);
+        release(books_, BOOK_BYTES, books_huge_);
+    }
+
+    // Non-copyable
+    ItchBookBuilderT(const ItchBookBuilderT&) = delete;
+    ItchBookBuilderT& operator=(const ItchBookBuilderT&) = delete;
+
+    // One MoldUDP64 datagram; emit(BBODataFast&) once per changed book.
+    // A malformed tail still applies (and publishes) the messages before it.
+    template<typename Emit>
+    HOT_FUNC bool decode(const uint8_t* data, size_t len, uint64_t ts_ns, Emit&& emit) noexcept {
+        const bool ok = packet_.split(data, len);
+
+        const MoldMessage* msgs = packet_.msgs;
+        const uint32_t n = packet_.count;
+        const uint32_t ahead = prefetch_;
+        if (ahead != 0) {
+            for (uint32_t i = 0; i < ahead && i < n; ++i) {
+                prefetch_message(msgs[i]);
+            }
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            if (ahead != 0 && i + ahead < n) {
+                prefetch_message(msgs[i + ahead]);
+            }
+            apply_message(msgs[i].data, msgs[i].len);
+        }
+
+        flush(ts_ns, emit);
+        return ok;
+    }
+
+    // One ITCH message (no MoldUDP64 framing); emits if the top changed
+    template<typename Emit>
+    HOT_FUNC void decode_message(const uint8_t* m, size_t len, uint64_t ts_ns, Emit&& emit) noexcept {
+        apply_message(m, len);
+        flush(ts_ns, emit);
+    }
+
+    // Update the book without publishing; flush() emits the dirty books
+    HOT_FUNC void apply_message(const uint8_t* m, size_t len) noexcept {
+        messages_.store(messages_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        switch (m[0]) {
+            case itch::ADD_ORDER:
+            case itch::ADD_ORDER_MPID:
+                if (likely(len >= itch::ADD_ORDER_SIZE)) {
+                    on_add(m);
+                    return;
+                }
+                break;
+            case itch::ORDER_EXECUTED:
+            case itch::EXECUTED_PRICE:
+                if (likely(len >= itch::ORDER_EXECUTED_SIZE)) {
+                    on_reduce(load_be64(m + itch::ORDER_REF_OFFSET),
+                              load_be32(m + itch::EXEC_SHARES_OFFSET));
+                    return;
+                }
+                break;
+            case itch::ORDER_CANCEL:
+                if (likely(len >= itch::ORDER_CANCEL_SIZE)) {
+                    on_reduce(load_be64(m + itch::ORDER_REF_OFFSET),
+                              load_be32(m + itch::CANCEL_SHARES_OFFSET));
+                    return;
+                }
+                break;
+            case itch::ORDER_DELETE:
+                if (likely(len >= itch::ORDER_DELETE_SIZE)) {
+                    on_reduce(load_be64(m + itch::ORDER_REF_OFFSET), ~uint32_t{0});
+                    return;
+                }
+                break;
+            case itch::ORDER_REPLACE:
+                if (likely(len >= itch::ORDER_REPLACE_SIZE)) {
+                    on_replace(m);
+                    return;
+                }
+                break;
+            default:
+                return;     // Not a book message (system, directory, trades, ...)
+        }
+
+        truncated_.store(truncated_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Emit each book whose top changed since the last flush (once each)
+    template<typename Emit>
+    HOT_FUNC void flush(uint64_t ts_ns, Emit&& emit) noexcept {
+        for (uint32_t i = 0; i < num_dirty_; ++i) {
+            Book& bk = books_[dirty_[i]];
+            bk.dirty = 0;
+            const Level bid = bk.depth[0] ? bk.levels[0][0] : Level{0, 0};
+            const Level ask = bk.depth[1] ? bk.levels[1][0] : Level{0, 0};
+            if (same(bid, bk.shown[0]) && same(ask, bk.shown[1])) {
+                bump(coalesced_);   // Changed and changed back within the packet
+                continue;
+            }
+            bk.shown[0] = bid;
+            bk.shown[1] = ask;
+
+            BBODataFast bbo;
+            init_feed_bbo(bbo, bk.symbol, ts_ns);
+            set_feed_bbo_prices(bbo, bid.price, bid.shares, ask.price, ask.shares);
+            bump(updates_);
+            emit(bbo);
+        }
+        num_dirty_ = 0;
+    }
+
+    // Subscription set, applied to books created from now on (set before
+    // the first packet); nullptr = every symbol
+    void set_filter(const SymbolFilter* filter) noexcept { filter_ = filter; }
+
+    // Forget every order and book (e.g. on a new session)
+    void reset() noexcept {
+        std::memset(orders_, 0, ORDER_BYTES);
+        std::memset(books_, 0, BOOK_BYTES);
+        num_dirty_ = 0;
+        std::memset(book_of_, 0xFF, sizeof(book_of_));
+        live_orders_ = 0;
+        num_books_ = 0;
+    }
+
+    void reset_counters() noexcept {
+        messages_.store(0, std::memory_order_relaxed);
+        updates_.store(0, std::memory_order_relaxed);
+        truncated_.store(0, std::memory_order_relaxed);
+        unknown_orders_.store(0, std::memory_order_relaxed);
+        book_overflow_.store(0, std::memory_order_relaxed);
+        order_overflow_.store(0, std::memory_order_relaxed);
+        coalesced_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t messages() const noexcept { return messages_.load(std::memory_order_relaxed); }
+    uint64_t updates() const noexcept { return updates_.load(std::memory_order_relaxed); }
+    uint64_t truncated() const noexcept { return truncated_.load(std::memory_order_relaxed); }
+    uint64_t unknown_orders() const noexcept { return unknown_orders_.load(std::memory_order_relaxed); }
+    uint64_t book_overflow() const noexcept { return book_overflow_.load(std::memory_order_relaxed); }
+    uint64_t order_overflow() const noexcept { return order_overflow_.load(std::memory_order_relaxed); }
+    uint64_t coalesced() const noexcept { return coalesced_.load(std::memory_order_relaxed); }
+    uint32_t books() const noexcept { return num_books_; }
+    uint32_t live_orders() const noexcept { return live_orders_; }     // Writer lcore only
+    uint32_t prefetch_distance() const noexcept { return prefetch_; }
+
+    static constexpr size_t max_books() noexcept { return MAX_BOOKS; }
+    static constexpr size_t order_capacity() noexcept { return ORDER_CAPACITY; }
+
+private:
+    static constexpr size_t ORDER_BYTES = ORDER_CAPACITY * sizeof(Order);
+    static constexpr size_t BOOK_BYTES = MAX_BOOKS * sizeof(Book);
+
+    Order* orders_ = nullptr;
+    Book* books_ = nullptr;
+    const SymbolFilter* filter_ = nullptr;
+    uint32_t live_orders_ = 0;
+    uint32_t num_books_ = 0;
+    uint32_t prefetch_ = 0;
+    uint32_t num_dirty_ = 0;
+    bool orders_huge_ = false;
+    bool books_huge_ = false;
+    uint16_t book_of_[LOCATES];        // stock_locate -> book index
+    uint16_t dirty_[MAX_BOOKS];        // Books to emit at flush(), each once
+    MoldPacket packet_;
+
+    alignas(64) std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<uint64_t> truncated_{0};
+    std::atomic<uint64_t> unknown_orders_{0};
+    std::atomic<uint64_t> book_overflow_{0};
+    std::atomic<uint64_t> order_overflow_{0};
+    std::atomic<uint64_t> coalesced_{0};
+
+    FORCE_INLINE static void bump(std::atomic<uint64_t>& c) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Fibonacci hash of the order reference
+    FORCE_INLINE static size_t slot_of(uint64_t ref) noexcept {
+        return static_cast<size_t>((ref * 0x9E3779B97F4A7C15ULL) >> 32) & (ORDER_CAPACITY - 1);
+    }
+
+    FORCE_INLINE Order* find_order(uint64_t ref) noexcept {
+        for (size_t i = slot_of(ref);; i = (i + 1) & (ORDER_CAPACITY - 1)) {
+            if (orders_[i].ref == ref) {
+                return &orders_[i];
+            }
+            if (orders_[i].ref == 0) {
+                return nullptr;
+            }
+        }
+    }
+
+    FORCE_INLINE bool insert_order(uint64_t ref, uint32_t price, uint32_t shares,
+                                   uint16_t book, uint8_t side) noexcept {
+        if (unlikely(live_orders_ >= MAX_LOAD || ref == 0)) {
+            bump(order_overflow_);
+            return false;
+        }
+        size_t i = slot_of(ref);
+        while (orders_[i].ref != 0 && orders_[i].ref != ref) {
+            i = (i + 1) & (ORDER_CAPACITY - 1);
+        }
+        if (orders_[i].ref == 0) {
+            ++live_orders_;
+        }
+        orders_[i] = Order{ref, price, shares, book, side};
+        return true;
+    }
+
+    // Backward-shift delete keeps probe chains intact without tombstones
+    FORCE_INLINE void erase_order(Order* o) noexcept {
+        size_t hole = static_cast<size_t>(o - orders_);
+        size_t i = hole;
+        for (;;) {
+            i = (i + 1) & (ORDER_CAPACITY - 1);
+            if (orders_[i].ref == 0) {
+                break;
+            }
+            const size_t home = slot_of(orders_[i].ref);
+            // Move i into the hole unless its home lies in (hole, i]
+            const bool stays = (hole <= i) ? (hole < home && home <= i)
+                                           : (hole < home || home <= i);
+            if (!stays) {
+                orders_[hole] = orders_[i];
+                hole = i;
+            }
+        }
+        orders_[hole].ref = 0;
+        --live_orders_;
+    }
+
+    FORCE_INLINE uint16_t book_for(uint16_t locate, const uint8_t* stock) noexcept {
+        uint16_t b = book_of_[locate];
+        if (likely(b != NO_BOOK)) {
+            return b;
+        }
+        if (unlikely(num_books_ >= MAX_BOOKS)) {
+            bump(book_overflow_);
+            return NO_BOOK;
+        }
+        b = static_cast<uint16_t>(num_books_++);
+        book_of_[locate] = b;
+        std::memcpy(books_[b].symbol, stock, 8);
+        books_[b].depth[0] = books_[b].depth[1] = 0;
+        books_[b].subscribed = (filter_ == nullptr) || filter_->contains(stock);
+        return b;
+    }
+
+    FORCE_INLINE static bool same(Level a, Level b) noexcept {
+        return a.price == b.price && a.shares == b.shares;
+    }
+
+    FORCE_INLINE void mark_dirty(uint16_t b) noexcept {
+        if (books_[b].dirty) {
+            bump(coalesced_);       // Folded into this packet's publish
+            return;
+        }
+        books_[b].dirty = 1;
+        dirty_[num_dirty_++] = b;
+    }
+
+    // Pull in what apply_message() will touch first: the order slot
+    // (reduce / replace / add) and, for adds, the book's bid/ask levels
+    FORCE_INLINE void prefetch_message(const MoldMessage& msg) const noexcept {
+        const uint8_t* m = msg.data;
+        if (unlikely(msg.len < itch::ORDER_DELETE_SIZE)) {
+            return;
+        }
+        switch (m[0]) {
+            case itch::ADD_ORDER:
+            case itch::ADD_ORDER_MPID: {
+                if (unlikely(msg.len < itch::ADD_ORDER_SIZE)) {
+                    return;
+                }
+                __builtin_prefetch(&orders_[slot_of(load_be64(m + itch::ORDER_REF_OFFSET))], 1, 3);
+                const uint16_t b = book_of_[load_be16(m + itch::LOCATE_OFFSET)];
+                if (likely(b != NO_BOOK)) {
+                    __builtin_prefetch(books_[b].levels[m[itch::ADD_SIDE_OFFSET] == 'S'], 1, 3);
+                }
+                return;
+            }
+            case itch::ORDER_EXECUTED:
+            case itch::EXECUTED_PRICE:
+            case itch::ORDER_CANCEL:
+            case itch::ORDER_DELETE:
+            case itch::ORDER_REPLACE:
+                __builtin_prefetch(&orders_[slot_of(load_be64(m + itch::ORDER_REF_OFFSET))], 1, 3);
+                return;
+            default:
+                return;
+        }
+    }
+
+    // Bids best = highest, asks best = lowest
+    FORCE_INLINE static bool better(uint8_t side, uint32_t a, uint32_t b) noexcept {
+        return side == 0 ? a > b : a < b;
+    }
+
+    // Add shares at price; true if level 0 changed
+    bool level_add(Book& bk, uint8_t side, uint32_t price, uint32_t shares) noexcept {
+        Level* lv = bk.levels[side];
+        const size_t n = bk.depth[side];
+        size_t i = 0;
+        while (i < n && better(side, lv[i].price, price)) {
+            ++i;
+        }
+        if (i < n && lv[i].price == price) {
+            lv[i].shares += shares;
+            return i == 0;
+        }
+        if (unlikely(i >= LEVELS)) {
+            bump(book_overflow_);   // Worse than every tracked level
+            return false;
+        }
+        size_t keep = n;
+        if (unlikely(n == LEVELS)) {
+            bump(book_overflow_);   // Deepest level falls off
+            keep = LEVELS - 1;
+        }
+        std::memmove(&lv[i + 1], &lv[i], (keep - i) * sizeof(Level));
+        lv[i] = Level{price, shares};
+        bk.depth[side] = static_cast<uint16_t>(keep + 1);
+        return i == 0;
+    }
+
+    // Remove shares at price; true if level 0 changed
+    bool level_reduce(Book& bk, uint8_t side, uint32_t price, uint32_t shares) noexcept {
+        Level* lv = bk.levels[side];
+        const size_t n = bk.depth[side];
+        size_t i = 0;
+        while (i < n && lv[i].price != price) {
+            ++i;
+        }
+        if (unlikely(i == n)) {
+            return false;           // Level was beyond LEVELS
+        }
+        if (lv[i].shares > shares) {
+            lv[i].shares -= shares;
+        } else {
+            std::memmove(&lv[i], &lv[i + 1], (n - i - 1) * sizeof(Level));
+            bk.depth[side] = static_cast<uint16_t>(n - 1);
+        }
+        return i == 0;
+    }
+
+    FORCE_INLINE void on_add(const uint8_t* m) noexcept {
+        const uint16_t b = book_for(load_be16(m + itch::LOCATE_OFFSET), m + itch::ADD_STOCK_OFFSET);
+        if (unlikely(b == NO_BOOK)) {
+            return;
+        }
+        const uint8_t side = (m[itch::ADD_SIDE_OFFSET] == 'S') ? 1 : 0;
+        const uint32_t shares = load_be32(m + itch::ADD_SHARES_OFFSET);
+        const uint32_t price = load_be32(m + itch::ADD_PRICE_OFFSET);
+        if (unlikely(!insert_order(load_be64(m + itch::ORDER_REF_OFFSET), price, shares, b, side))) {
+            return;
+        }
+        if (books_[b].subscribed && level_add(books_[b], side, price, shares)) {
+            mark_dirty(b);
+        }
+    }
+
+    // Execute / cancel / delete (shares = ~0): take shares off the order
+    FORCE_INLINE void on_reduce(uint64_t ref, uint32_t shares) noexcept {
+        Order* o = find_order(ref);
+        if (unlikely(o == nullptr)) {
+            bump(unknown_orders_);  // Joined mid-session, or dropped on overflow
+            return;
+        }
+        const uint32_t taken = shares < o->shares ? shares : o->shares;
+        const uint16_t b = o->book;
+        const bool top = books_[b].subscribed &&
+                         level_reduce(books_[b], o->side, o->price, taken);
+        if (taken == o->shares) {
+            erase_order(o);
+        } else {
+            o->shares -= taken;
+        }
+        if (top) {
+            mark_dirty(b);
+        }
+    }
+
+    // Replace: delete the original, add the new reference on the same side
+    FORCE_INLINE void on_replace(const uint8_t* m) noexcept {
+        Order* o = find_order(load_be64(m + itch::ORDER_REF_OFFSET));
+        if (unlikely(o == nullptr)) {
+            bump(unknown_orders_);
+            return;
+        }
+        const uint16_t b = o->book;
+        const uint8_t side = o->side;
+        Book& bk = books_[b];
+        bool top = bk.subscribed && level_reduce(bk, side, o->price, o->shares);
+        erase_order(o);
+
+        const uint32_t shares = load_be32(m + itch::REPLACE_SHARES_OFFSET);
+        const uint32_t price = load_be32(m + itch::REPLACE_PRICE_OFFSET);
+        if (likely(insert_order(load_be64(m + itch::REPLACE_NEW_REF_OFFSET), price, shares, b, side))) {
+            top |= bk.subscribed && level_add(bk, side, price, shares);
+        }
+        if (top) {
+            mark_dirty(b);
+        }
+    }
+
+    // Hugepages first (same policy as BBOPool), placed on the NIC's node
+    static void* allocate(size_t bytes, int numa_node, bool& huge) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge = (p != MAP_FAILED);
+        if (!huge) {
+            p = aligned_alloc(NUMA_PAGE_SIZE, (bytes + NUMA_PAGE_SIZE - 1) & ~(NUMA_PAGE_SIZE - 1));
+            if (!p) {
+                std::fprintf(stderr, "ItchBookBuilder: Failed to allocate %zu bytes\n", bytes);
+                std::abort();
+            }
+        }
+        numa_prefer(p, bytes, numa_node);
+        return p;
+    }
+
+    static void release(void* p, size_t bytes, bool huge) {
+        if (!p) {
+            return;
+        }
+        if (huge) {
+            munmap(p, bytes);
+        } else {
+            std::free(p);
+        }
+    }
+};
+
+// Default: 16384 instruments x 32 levels, 2M order slots (~1.5M live orders)
+using ItchBookBuilder = ItchBookBuilderT<>;
+
+}  // namespace ultra_ll
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "likely.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace ultra_ll {
+
+// Log-linear (HDR-style) histogram of raw tick counts
+//
+// Values below 2^SUB_BITS get one bucket each; above that every power of two
+// is split into 2^SUB_BITS linear sub-buckets, so the relative error is
+// bounded by 1/16 (~6%) from 1 tick to 2^MAX_BITS ticks (~23 s of 3 GHz TSC).
+// Larger values clamp into the last bucket.
+//
+// Not thread-safe: one writer, no concurrent readers (see LatencyRecorder).
+//
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 4;
+    static constexpr unsigned SUB_COUNT = 1u << SUB_BITS;
+    static constexpr unsigned MAX_BITS = 36;
+    static constexpr unsigned BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    LatencyHistogram() { reset(); }
+
+    FORCE_INLINE void record(uint64_t value, uint64_t n = 1) noexcept {
+        counts_[index_of(value)] += n;
+        total_ += n;
+        if (unlikely(value > max_)) {
+            max_ = value;
+        }
+    }
+
+    void add(const LatencyHistogram& other) noexcept {
+        for (unsigned i = 0; i < BUCKETS; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        if (other.max_ > max_) {
+            max_ = other.max_;
+        }
+    }
+
+    void reset() noexcept {
+        std::memset(counts_, 0, sizeof(counts_));
+        total_ = 0;
+        max_ = 0;
+    }
+
+    uint64_t count() const noexcept { return total_; }
+    uint64_t max() const noexcept { return max_; }
+
+    // Highest value equivalent to the percentile's bucket (0 when empty)
+    uint64_t value_at_percentile(double percentile) const noexcept {
+        if (total_ == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total_));
+        if (target == 0) {
+            target = 1;
+        }
+
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= target) {
+                const uint64_t upper = bucket_upper(i);
+                return upper < max_ ? upper : max_;
+            }
+        }
+        return max_;
+    }
+
+    FORCE_INLINE static unsigned index_of(uint64_t value) noexcept {
+        if (value < SUB_COUNT) {
+            return static_cast<unsigned>(value);
+        }
+        const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        if (unlikely(msb >= MAX_BITS)) {
+            return BUCKETS - 1;
+        }
+        const unsigned shift = msb - SUB_BITS;
+        const unsigned sub = static_cast<unsigned>(value >> shift) & (SUB_COUNT - 1);
+        return (shift + 1) * SUB_COUNT + sub;
+    }
+
+    // Largest value that maps to bucket idx
+    static uint64_t bucket_upper(unsigned idx) noexcept {
+        if (idx < SUB_COUNT) {
+            return idx;
+        }
+        const unsigned shift = idx / SUB_COUNT - 1;
+        const uint64_t base = (uint64_t{SUB_COUNT} + idx % SUB_COUNT) << shift;
+        return base + (uint64_t{1} << shift) - 1;
+    }
+
+private:
+    uint64_t counts_[BUCKETS];
+    uint64_t total_;
+    uint64_t max_;
+};
+
+// Histogram stages recorded per RX queue
+enum class LatencyStage : uint8_t {
+    RX_TO_PARSE = 0,    // rte_eth_rx_burst() return -> BBO parsed (TSC cycles)
+    PARSE_TO_PUBLISH,   // BBO parsed -> ring commit (TSC cycles)
+    RX_TO_PUBLISH,      // rte_eth_rx_burst() return -> ring commit (TSC cycles)
+    WAKE_UP,            // Idle backoff exit: NIC arrival (or last wait end) -> loop awake
+    FPGA_A,             // T2 - T1: ITCH parse -> CDC FIFO (FPGA 125 MHz cycles)
+    FPGA_CDC,           // T3 - T2: CDC FIFO -> BBO FIFO read (FPGA 125 MHz cycles)
+    FPGA_B,             // T4 - T3: BBO FIFO read -> TX start (FPGA 125 MHz cycles)
+    FPGA_TOTAL,         // T4 - T1 (FPGA 125 MHz cycles)
+    COUNT
+};
+
+constexpr size_t LATENCY_STAGES = static_cast<size_t>(LatencyStage::COUNT);
+constexpr double FPGA_NS_PER_CYCLE = 8.0;   // 125 MHz
+
+inline bool latency_stage_is_fpga(LatencyStage stage) {
+    return stage >= LatencyStage::FPGA_A;
+}
+
+inline const char* latency_stage_name(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::RX_TO_PARSE:      return "rx->parse";
+        case LatencyStage::PARSE_TO_PUBLISH: return "parse->publish";
+        case LatencyStage::RX_TO_PUBLISH:    return "rx->publish";
+        case LatencyStage::WAKE_UP:          return "idle wake-up";
+        case LatencyStage::FPGA_A:           return "fpga T2-T1";
+        case LatencyStage::FPGA_CDC:         return "fpga T3-T2";
+        case LatencyStage::FPGA_B:           return "fpga T4-T3";
+        case LatencyStage::FPGA_TOTAL:       return "fpga T4-T1";
+        default:                             return "?";
+    }
+}
+
+// Per-queue stage histograms: one poll lcore writes, one stats thread reads
+//
+// The writer records into one of two phases with plain stores. To read, the
+// stats thread bumps a request counter; the poll lcore notices it at its next
+// burst, switches to the other phase and acknowledges. The retired phase is
+// then owned by the reader, which folds it into its cumulative copy and
+// clears it before the next request hands it back. The poll core never waits
+// and never shares a written line with the reader except the rare request
+// and ack words.
+//
+// Layout:
+// - Line 0: request counter + reader lock (reader-written, writer polls once per burst)
+// - Line 1: active phase, ack, attached flag (writer-written)
+// - Phases: 2 x LATENCY_STAGES histograms, only the active one is hot
+// - Cumulative + last-interval results (reader only)
+//
+class LatencyRecorder {
+public:
+    using Phase = LatencyHistogram[LATENCY_STAGES];
+
+    LatencyRecorder() = default;
+
+    // Non-copyable
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    // --- Writer (poll lcore) ---
+
+    FORCE_INLINE void record(LatencyStage stage, uint64_t value, uint64_t n = 1) noexcept {
+        phases_[active_][static_cast<size_t>(stage)].record(value, n);
+    }
+
+    // Unsigned 32-bit differences, so FPGA counter wrap is harmless
+    FORCE_INLINE void record_fpga(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4) noexcept {
+        Phase& p = phases_[active_];
+        p[static_cast<size_t>(LatencyStage::FPGA_A)].record(t2 - t1);
+        p[static_cast<size_t>(LatencyStage::FPGA_CDC)].record(t3 - t2);
+        p[static_cast<size_t>(LatencyStage::FPGA_B)].record(t4 - t3);
+        p[static_cast<size_t>(LatencyStage::FPGA_TOTAL)].record(t4 - t1);
+    }
+
+    // Same stages from a parsed BBO's packed deltas (no payload re-read)
+    FORCE_INLINE void record_fpga(const FpgaDeltas& d) noexcept {
+        Phase& p = phases_[active_];
+        p[static_cast<size_t>(LatencyStage::FPGA_A)].record(d.parse_to_cdc);
+        p[static_cast<size_t>(LatencyStage::FPGA_CDC)].record(d.cdc_to_fifo);
+        p[static_cast<size_t>(LatencyStage::FPGA_B)].record(d.fifo_to_tx);
+        p[static_cast<size_t>(LatencyStage::FPGA_TOTAL)].record(d.total());
+    }
+
+    // Bracket the poll loop so collect() knows whether to handshake
+    void attach_writer() noexcept { writer_attached_.store(true, std::memory_order_release); }
+    void detach_writer() noexcept { writer_attached_.store(false, std::memory_order_release); }
+
+    // Call once per poll iteration: honours a pending swap request
+    FORCE_INLINE void poll_swap() noexcept {
+        const uint32_t req = request_.load(std::memory_order_acquire);
+        if (unlikely(req != acked_)) {
+            active_ ^= 1;
+            acked_ = req;
+            ack_.store(req, std::memory_order_release);
+        }
+    }
+
+    // --- Reader (stats thread or bbo_stat) ---
+
+    // Collect the writer's samples since the last collect() into interval()
+    // and accumulate them into cumulative().
+    // Without an attached writer the phases are drained directly.
+    // Returns false if the writer did not acknowledge within max_spins;
+    // the request stays pending and the next collect() picks it up.
+    // Also false while another reader (thread or process mapping the
+    // telemetry segment) is collecting: one reader at a time.
+    bool collect(uint32_t max_spins = 1u << 20) noexcept {
+        if (reader_busy_.exchange(true, std::memory_order_acquire)) {
+            return false;
+        }
+        const bool ok = collect_exclusive(max_spins);
+        reader_busy_.store(false, std::memory_order_release);
+        return ok;
+    }
+
+    // Writer must be stopped
+    void reset() noexcept {
+        for (auto& phase : phases_) {
+            for (auto& h : phase) {
+                h.reset();
+            }
+        }
+        for (auto& h : cumulative_) {
+            h.reset();
+        }
+        clear_interval();
+    }
+
+    const LatencyHistogram& cumulative(LatencyStage stage) const noexcept {
+        return cumulative_[static_cast<size_t>(stage)];
+    }
+    const LatencyHistogram& interval(LatencyStage stage) const noexcept {
+        return interval_[static_cast<size_t>(stage)];
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> request_{0};
+    uint32_t requested_ = 0;            // Reader-private mirror of request_
+    std::atomic<bool> reader_busy_{false};  // Held across collect()
+
+    alignas(64) uint32_t active_ = 0;
+    uint32_t acked_ = 0;                // Writer-private mirror of ack_
+    std::atomic<uint32_t> ack_{0};
+    std::atomic<bool> writer_attached_{false};
+
+    alignas(64) Phase phases_[2];
+
+    alignas(64) Phase cumulative_;
+    Phase interval_;
+
+    // collect() with reader_busy_ held
+    bool collect_exclusive(uint32_t max_spins) noexcept {
+        if (!writer_attached_.load(std::memory_order_acquire)) {
+            clear_interval();
+            for (auto& phase : phases_) {
+                drain(phase);
+            }
+            return true;
+        }
+
+        if (ack_.load(std::memory_order_acquire) == requested_) {
+            request_.store(++requested_, std::memory_order_release);
+        }
+
+        for (uint32_t spin = 0; ack_.load(std::memory_order_acquire) != requested_; ++spin) {
+            if (spin >= max_spins) {
+                return false;
+            }
+            __builtin_ia32_pause();
+        }
+
+        // Writer flips once per request: after k acks it is on phase k & 1
+        clear_interval();
+        drain(phases_[(requested_ & 1) ^ 1]);
+        return true;
+    }
+
+    void clear_interval() noexcept {
+        for (auto& h : interval_) {
+            h.reset();
+        }
+    }
+
+    void drain(Phase& phase) noexcept {
+        for (size_t s = 0; s < LATENCY_STAGES; ++s) {
+            interval_[s].add(phase[s]);
+            cumulative_[s].add(phase[s]);
+            phase[s].reset();
+        }
+    }
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "likely.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ultra_ll {
+
+// MoldUDP64 downstream packet: session(10) sequence(8) count(2), then
+// count x { length(2), message }. All fields big-endian.
+constexpr size_t MOLD_HEADER_SIZE = 20;
+constexpr size_t MOLD_SEQUENCE_OFFSET = 10;
+constexpr size_t MOLD_COUNT_OFFSET = 18;
+constexpr uint16_t MOLD_END_OF_SESSION = 0xFFFF;
+
+// A 9000-byte jumbo frame holds at most ~430 of the shortest (19-byte)
+// ITCH messages; a packet claiming more is rejected as malformed
+constexpr size_t MOLD_MAX_MESSAGES = 512;
+
+FORCE_INLINE uint16_t load_be16(const uint8_t* p) noexcept {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap16(v);
+}
+
+FORCE_INLINE uint32_t load_be32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap32(v);
+}
+
+FORCE_INLINE uint64_t load_be64(const uint8_t* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap64(v);
+}
+
+struct MoldMessage {
+    const uint8_t* data;
+    uint16_t len;
+};
+
+// One datagram split into its messages (pointers into the packet)
+//
+// split() walks the length prefixes once and validates every bound, so
+// the decode stage can index ahead (prefetch message i + N while applying
+// message i) without re-checking. Reused per packet: keep one per queue.
+//
+struct MoldPacket {
+    uint64_t sequence = 0;      // Sequence number of msgs[0]
+    uint32_t count = 0;
+    MoldMessage msgs[MOLD_MAX_MESSAGES];
+
+    // False if truncated, a zero-length message, or too many messages;
+    // count then covers the messages before the bad one
+    HOT_FUNC bool split(const uint8_t* data, size_t len) noexcept {
+        count = 0;
+        if (unlikely(len < MOLD_HEADER_SIZE)) {
+            return false;
+        }
+        sequence = load_be64(data + MOLD_SEQUENCE_OFFSET);
+        uint32_t n = load_be16(data + MOLD_COUNT_OFFSET);
+        if (unlikely(n == MOLD_END_OF_SESSION)) {
+            return true;                // End of session: no messages
+        }
+        if (unlikely(n > MOLD_MAX_MESSAGES)) {
+            return false;
+        }
+
+        const uint8_t* p = data + MOLD_HEADER_SIZE;
+        const uint8_t* const end = data + len;
+        for (; count < n; ++count) {
+            if (unlikely(p + 2 > end)) {
+                return false;
+            }
+            const uint16_t msg_len = load_be16(p);
+            p += 2;
+            if (unlikely(msg_len == 0 || p + msg_len > end)) {
+                return false;
+            }
+            msgs[count] = MoldMessage{p, msg_len};
+            p += msg_len;
+        }
+        return true;
+    }
+};
+
+}  // namespace ultra_ll
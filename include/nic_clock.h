@@ -0,0 +1,128 @@
+#pragma once
+
+#include "likely.h"
+#include "rdtsc.h"
+
+#include <rte_mbuf.h>
+#include <rte_mbuf_dyn.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace ultra_ll {
+
+// NIC clock -> TSC nanosecond mapping at the time of calibration
+struct NicClockDrift {
+    int64_t nic_error_ns;       // Mapped NIC clock minus TSC, now (0 right after a re-fit)
+    int64_t phc_offset_ns;      // PTP hardware clock minus TSC, now
+    int64_t phc_drift_ns;       // Change of phc_offset_ns since calibration
+    bool has_phc;
+};
+
+// NIC RX hardware timestamps in the receiver's TSC nanosecond domain
+//
+// With RTE_ETH_RX_OFFLOAD_TIMESTAMP the PMD stamps each mbuf (dynamic field,
+// flagged in ol_flags) with its free-running device clock at wire arrival.
+// init() correlates that clock with TSC (paired rte_eth_read_clock() /
+// rdtscp samples 10 ms apart), so to_ns() yields values directly comparable
+// with tsc_.tsc_to_ns(rdtsc()) but taken before NIC and burst queueing.
+//
+// If the port also exposes a PTP hardware clock (timesync), its offset to
+// TSC is kept so drift between the two clocks can be reported.
+//
+// A 10 ms fit is good to ~1e-4, and the TSC epoch itself moves under
+// TscSync. start() therefore launches a thread that re-fits the map every
+// interval, and right after each new TSC epoch. The map is published
+// through a seqlock (TscEpochClock), so to_ns() stays lock-free on every
+// poll lcore. Residual offsets are slewed out over the next interval.
+// Only offsets beyond step_ns, such as a TscSync step, re-anchor at once.
+//
+class NicClock {
+public:
+    NicClock() = default;
+    ~NicClock();
+
+    // Non-copyable (owns the re-fit thread)
+    NicClock(const NicClock&) = delete;
+    NicClock& operator=(const NicClock&) = delete;
+
+    // Call after rte_eth_dev_start() with the offload enabled
+    // Returns false if the PMD does not provide timestamps (use TSC)
+    bool init(uint16_t port_id, const TSCCalibrator& tsc);
+
+    // Re-fit thread on CPU core (-1 = unpinned); no-op unless init()
+    // succeeded. Until stop() it is the only map writer
+    void start(uint32_t interval_ms, int64_t step_ns, int core);
+    void stop();
+
+    // Replay: frames carry their recorded timestamp (ns) in the same
+    // dynamic field, mapped 1:1 around base_ns (first frame, keeps the
+    // double exact for ~100 days of offsets). No device clock to measure.
+    bool init_replay(uint64_t base_ns);
+
+    bool enabled() const { return rx_flag_ != 0; }
+
+    // Replay only: what the PMD would have written
+    FORCE_INLINE void stamp(rte_mbuf* pkt, uint64_t ns) const {
+        *RTE_MBUF_DYNFIELD(pkt, field_offset_, rte_mbuf_timestamp_t*) = ns;
+        pkt->ol_flags |= rx_flag_;
+    }
+
+    // False when disabled (rx_flag_ == 0) or the PMD skipped this mbuf
+    FORCE_INLINE bool has_timestamp(const rte_mbuf* pkt) const {
+        return (pkt->ol_flags & rx_flag_) != 0;
+    }
+
+    FORCE_INLINE uint64_t to_ns(const rte_mbuf* pkt) const {
+        const uint64_t ticks = *RTE_MBUF_DYNFIELD(pkt, field_offset_, const rte_mbuf_timestamp_t*);
+        return map(ticks);
+    }
+
+    // Re-sample both clocks and compare against the calibration (cold)
+    bool measure(NicClockDrift& out) const;
+
+    double ns_per_tick() const { return map_.load().scale.rate(); }
+    uint64_t refits() const noexcept { return refits_.load(std::memory_order_relaxed); }
+    uint64_t steps() const noexcept { return steps_.load(std::memory_order_relaxed); }
+
+private:
+    uint16_t port_id_ = 0;
+    const TSCCalibrator* tsc_ = nullptr;
+    int field_offset_ = -1;
+    uint64_t rx_flag_ = 0;
+
+    // Linear map, ticks in the tsc_base slot: ns = ns_base + (ticks - base) * rate
+    TscEpochClock map_;
+    uint32_t shift_ = 0;                // Fixed at init(): re-fits move the rate by ppm
+
+    // Re-fit state (thread only)
+    uint64_t last_ticks_ = 0;           // Previous sample: the rate baseline
+    uint64_t last_ns_ = 0;
+    uint32_t interval_ms_ = 1000;
+    int64_t step_ns_ = 1000000;
+    int core_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> refits_{0};
+    std::atomic<uint64_t> steps_{0};
+
+    bool replay_ = false;               // init_replay(): measure() has nothing to sample
+    bool has_phc_ = false;
+    int64_t phc_offset_ns_ = 0;
+
+    FORCE_INLINE uint64_t map(uint64_t ticks) const {
+        return map_.to_ns(ticks);
+    }
+
+    void publish(uint64_t tick_base, uint64_t ns_base, double ns_per_tick) {
+        map_.store(TscEpoch{tick_base, ns_base, TscScale::with_shift(ns_per_tick, shift_)});
+    }
+
+    void run();
+    void refit();
+    bool sample(uint64_t& ticks, uint64_t& tsc_ns) const;
+    bool read_phc_offset(int64_t& offset_ns) const;
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <numaif.h>
+
+#include <cstddef>
+
+namespace ultra_ll {
+
+// Unknown / no preference (same value as DPDK's SOCKET_ID_ANY)
+constexpr int NUMA_NODE_ANY = -1;
+
+// Page alignment for allocations that get a NUMA policy (mbind granularity)
+constexpr size_t NUMA_PAGE_SIZE = 4096;
+
+// Prefer `node` for the pages of [addr, addr + len) that are not yet faulted
+// in. Call before first touch; addr must be page aligned. Preferred, not
+// bound: a node without free (huge)pages falls back instead of SIGBUS.
+inline bool numa_prefer(void* addr, size_t len, int node) {
+    if (node < 0) {
+        return true;
+    }
+    if (node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+        return false;
+    }
+    const unsigned long mask = 1UL << node;
+    return mbind(addr, len, MPOL_PREFERRED, &mask, sizeof(mask) * 8, 0) == 0;
+}
+
+// Node holding the (faulted-in) page at addr, NUMA_NODE_ANY if unknown
+inline int numa_node_of(const void* addr) {
+    int node = NUMA_NODE_ANY;
+    if (get_mempolicy(&node, nullptr, 0, const_cast<void*>(addr),
+                      MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return NUMA_NODE_ANY;
+    }
+    return node;
+}
+
+}  // namespace ultra_ll
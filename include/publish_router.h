@@ -0,0 +1,162 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "bbo_fast_ring.h"
+#include "conflation_cache.h"
+#include "instrument_map.h"
+#include "likely.h"
+#include "symbol_filter.h"
+#include "telemetry.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ultra_ll {
+
+constexpr uint8_t MAX_ROUTES = 8;
+
+// What a route does with a BBO its ring has no room for
+enum class RoutePolicy : uint8_t {
+    DROP,       // Count it and move on (recorders, analytics)
+    CONFLATE,   // Keep the latest per symbol, flush once the ring drains
+};
+
+// One extra consumer ring (main -O "name[:drop|conflate[:symbols]]")
+struct RouteConfig {
+    std::string name;                   // Ring "/bbo_fast_<name>" ("_q<N>" per queue)
+    RoutePolicy policy = RoutePolicy::DROP;
+    std::string symbols;                // parse_symbol_spec() list, empty = all
+};
+
+// "name[:policy[:symbols]]"; false (with an error) on a bad spec
+bool parse_route_spec(const std::string& spec, RouteConfig& route);
+
+inline const char* route_policy_name(RoutePolicy p) {
+    return p == RoutePolicy::CONFLATE ? "conflate" : "drop";
+}
+
+// Instrument ID -> bitmask of the routes that want it
+//
+// Built once per receiver and shared by every poll lcore. Each route's
+// symbol filter is evaluated the first time an instrument ID is routed,
+// then cached in masks_[id]: routing a tick is one 2-byte load indexed by
+// BBODataFast::instrument_id. Entries are relaxed stores of a pure
+// function of the ID, so two lcores resolving the same ID concurrently
+// store the same value. ID 0 (not interned) is never cached.
+//
+class RouteTable {
+public:
+    static constexpr uint16_t RESOLVED = 0x8000;
+    static_assert(MAX_ROUTES < 16, "route bits must leave room for RESOLVED");
+
+    RouteTable() = default;
+
+    // Non-copyable
+    RouteTable(const RouteTable&) = delete;
+    RouteTable& operator=(const RouteTable&) = delete;
+
+    // Compile the filters (cold); false on a bad symbol list
+    bool init(const std::vector<RouteConfig>& routes, int numa_node);
+
+    uint8_t size() const noexcept { return static_cast<uint8_t>(routes_.size()); }
+    const RouteConfig& route(uint8_t i) const noexcept { return routes_[i]; }
+    const SymbolFilter& filter(uint8_t i) const noexcept { return filters_[i]; }
+
+    HOT_FUNC uint32_t mask_of(const BBODataFast& bbo) noexcept {
+        const uint16_t m = masks_[bbo.instrument_id].load(std::memory_order_relaxed);
+        if (likely(m & RESOLVED)) {
+            return m & ~RESOLVED;
+        }
+        return resolve(bbo);
+    }
+
+private:
+    std::vector<RouteConfig> routes_;
+    SymbolFilter filters_[MAX_ROUTES];  // Disabled = every instrument
+    std::atomic<uint16_t> masks_[InstrumentMap::capacity()] = {};
+
+    // First tick of an instrument: once per ID per session
+    NEVER_INLINE uint32_t resolve(const BBODataFast& bbo) noexcept;
+};
+
+// Per-route counters: one cache line, written by the owning poll lcore
+struct alignas(64) RouteLane {
+    BboFastRing* ring = nullptr;
+    DefaultConflationCache* conflation = nullptr;   // RoutePolicy::CONFLATE
+    StatCounter published;
+    StatCounter dropped;                // Ring full (DROP) or cache at its limit
+    StatCounter conflated;              // Absorbed into the route's cache
+    StatCounter flushed;                // Published from the route's cache
+};
+
+static_assert(sizeof(RouteLane) == 64, "RouteLane must stay one cache line");
+
+// One poll lcore's fan-out: every BBO published to the primary ring is
+// copied into each matching route's ring (single producer per ring)
+//
+// Routes never push back on the caller: a full route ring only costs that
+// route a drop or a conflation. The primary ring is published first, so the
+// market maker's latency does not include the fan-out copies.
+//
+class PublishRouter {
+public:
+    PublishRouter(RouteTable& table, int numa_node);
+
+    // Non-copyable
+    PublishRouter(const PublishRouter&) = delete;
+    PublishRouter& operator=(const PublishRouter&) = delete;
+
+    // Cold setup: route i publishes to ring (not owned)
+    void attach(uint8_t route, BboFastRing* ring);
+
+    HOT_FUNC void publish(const BBODataFast& bbo) noexcept {
+        uint32_t mask = table_.mask_of(bbo);
+        while (mask != 0) {
+            const unsigned i = static_cast<unsigned>(__builtin_ctz(mask));
+            mask &= mask - 1;
+            publish_lane(i, bbo);
+        }
+    }
+
+    // Routes holding conflated BBOs (checked once per poll)
+    bool has_backlog() const noexcept { return backlog_ != 0; }
+    void flush() noexcept;
+
+    uint8_t size() const noexcept { return table_.size(); }
+    const RouteTable& table() const noexcept { return table_; }
+    const RouteLane& lane(uint8_t i) const noexcept { return lanes_[i]; }
+
+    void warm_cache() noexcept;
+    void reset_stats() noexcept;
+
+private:
+    RouteTable& table_;
+    uint32_t backlog_ = 0;              // Bit i: lanes_[i].conflation has dirty entries
+    RouteLane lanes_[MAX_ROUTES];
+    std::unique_ptr<DefaultConflationCache> conflation_storage_[MAX_ROUTES];
+    int numa_node_;
+
+    FORCE_INLINE void publish_lane(unsigned i, const BBODataFast& bbo) noexcept {
+        RouteLane& lane = lanes_[i];
+        // Behind a backlog: conflate so the route keeps per-symbol order
+        if (likely((backlog_ & (1u << i)) == 0)) {
+            BBODataFast* slot = lane.ring->claim();
+            if (likely(slot != nullptr)) {
+                *slot = bbo;
+                lane.ring->commit();
+                lane.published.add();
+                return;
+            }
+        }
+        if (lane.conflation != nullptr && likely(lane.conflation->update(bbo))) {
+            lane.conflated.add();
+            backlog_ |= 1u << i;
+        } else {
+            lane.dropped.add();
+        }
+    }
+};
+
+}  // namespace ultra_ll
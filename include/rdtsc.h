@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <ctime>
 #include <unistd.h>
 
 // Read Time Stamp Counter - cycle-accurate timing
@@ -28,18 +30,129 @@ static inline uint64_t rdtscp() {
     return ((uint64_t)hi << 32) | lo;
 }
 
+// 64x64 -> 128-bit products (GCC / Clang extension)
+__extension__ typedef unsigned __int128 tsc_u128;
+__extension__ typedef __int128 tsc_i128;
+
+// Fixed-point rate: ns = (cycles * mult) >> shift, as the Linux vDSO does
+// mult stays below 2^62, so a 64-bit cycle count never overflows the
+// __int128 product and a rate re-fit keeps headroom
+struct TscScale {
+    uint64_t mult;
+    uint32_t shift;
+
+    static TscScale from_rate(double units_per_cycle) {
+        uint32_t shift = 62;
+        while (shift > 0 && units_per_cycle * static_cast<double>(1ULL << shift) >=
+                                static_cast<double>(1ULL << 62)) {
+            --shift;
+        }
+        return with_shift(units_per_cycle, shift);
+    }
+
+    static TscScale with_shift(double units_per_cycle, uint32_t shift) {
+        return TscScale{static_cast<uint64_t>(units_per_cycle * static_cast<double>(1ULL << shift)
+                                              + 0.5),
+                        shift};
+    }
+
+    inline uint64_t apply(uint64_t cycles) const {
+        return static_cast<uint64_t>((static_cast<tsc_u128>(cycles) * mult) >> shift);
+    }
+
+    // Deltas just before the base (a reading taken before a publish)
+    inline int64_t apply_signed(int64_t cycles) const {
+        return static_cast<int64_t>((static_cast<tsc_i128>(cycles) * static_cast<tsc_i128>(mult))
+                                    >> shift);
+    }
+
+    double rate() const { return static_cast<double>(mult) / static_cast<double>(1ULL << shift); }
+};
+
+// TSC -> epoch mapping: ns = ns_base + ((tsc - tsc_base) * mult) >> shift
+// (ns_base in CLOCK_REALTIME, or PHC time when TscSync follows a PHC)
+struct TscEpoch {
+    uint64_t tsc_base;
+    uint64_t ns_base;
+    TscScale scale;
+};
+
+// Seqlock'd TscEpoch: one writer, any number of lock-free readers
+//
+// Lives in TSCCalibrator and, mirrored, in the telemetry segment, where
+// consumers of raw-TSC timestamps (DPDKReceiver::Config::raw_tsc) convert
+// with the receiver's current mapping. Plain data: safe in shared memory.
+class TscEpochClock {
+    alignas(64) std::atomic<uint32_t> seq_{0};      // Odd while store() is writing
+    std::atomic<uint64_t> tsc_base_{0};
+    std::atomic<uint64_t> ns_base_{0};
+    std::atomic<uint64_t> mult_{0};
+    std::atomic<uint32_t> shift_{0};
+
+public:
+    inline TscEpoch load() const {
+        uint32_t seq;
+        TscEpoch e;
+        do {
+            seq = seq_.load(std::memory_order_acquire);
+            e.tsc_base = tsc_base_.load(std::memory_order_relaxed);
+            e.ns_base = ns_base_.load(std::memory_order_relaxed);
+            e.scale.mult = mult_.load(std::memory_order_relaxed);
+            e.scale.shift = shift_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while (__builtin_expect((seq & 1) != 0 ||
+                                  seq != seq_.load(std::memory_order_relaxed), 0));
+        return e;
+    }
+
+    // Integer only: one 64x64->128 multiply, shift, add
+    inline uint64_t to_ns(uint64_t tsc) const {
+        const TscEpoch e = load();
+        return e.ns_base + e.scale.apply_signed(static_cast<int64_t>(tsc - e.tsc_base));
+    }
+
+    void store(const TscEpoch& e) {
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        tsc_base_.store(e.tsc_base, std::memory_order_relaxed);
+        ns_base_.store(e.ns_base, std::memory_order_relaxed);
+        mult_.store(e.scale.mult, std::memory_order_relaxed);
+        shift_.store(e.scale.shift, std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+};
+
 // TSC Calibrator - converts cycles to nanoseconds
 // Calibrate once at startup, then use for all conversions
+//
+// Two conversions, both integer multiply-shift (no int->double->int per
+// packet):
+// - cycles_to_ns() / ns_to_cycles(): durations, at the startup rate
+// - tsc_to_ns() / now_ns(): timestamps, through the epoch mapping. It is
+//   anchored to CLOCK_REALTIME by calibrate() and re-fitted at run time by
+//   TscSync (tsc_sync.h), which publishes each new mapping through a
+//   seqlock. Readers never block; a read that overlaps a publish (once a
+//   second) retries.
 class TSCCalibrator {
     double ns_per_cycle_;
     double cycles_per_ns_;
     uint64_t base_tsc_;
+    TscScale to_ns_{0, 0};
+    TscScale to_cycles_{0, 0};
+
+    TscEpochClock epoch_;
+    TscEpochClock* mirror_ = nullptr;   // Telemetry copy for raw-TSC consumers
 
 public:
     TSCCalibrator() : ns_per_cycle_(0), cycles_per_ns_(0), base_tsc_(0) {
         calibrate();
     }
 
+    // Non-copyable (poll lcores and TscSync share one mapping)
+    TSCCalibrator(const TSCCalibrator&) = delete;
+    TSCCalibrator& operator=(const TSCCalibrator&) = delete;
+
     void calibrate() {
         // Use a longer calibration period for accuracy
         constexpr int calibration_us = 10000;  // 10ms
@@ -54,16 +167,23 @@ public:
         ns_per_cycle_ = ns / cycles;
         cycles_per_ns_ = cycles / ns;
         base_tsc_ = rdtscp();
+        to_ns_ = TscScale::from_rate(ns_per_cycle_);
+        to_cycles_ = TscScale::from_rate(cycles_per_ns_);
+
+        // Epoch: one CLOCK_REALTIME reading, bracketed by rdtscp
+        uint64_t tsc, realtime_ns;
+        sample_realtime(tsc, realtime_ns);
+        publish_epoch(tsc, realtime_ns, ns_per_cycle_);
     }
 
     // Convert TSC cycles to nanoseconds
     inline uint64_t cycles_to_ns(uint64_t cycles) const {
-        return static_cast<uint64_t>(cycles * ns_per_cycle_);
+        return to_ns_.apply(cycles);
     }
 
     // Convert nanoseconds to TSC cycles
     inline uint64_t ns_to_cycles(uint64_t ns) const {
-        return static_cast<uint64_t>(ns * cycles_per_ns_);
+        return to_cycles_.apply(ns);
     }
 
     // Get elapsed nanoseconds since calibration
@@ -71,15 +191,58 @@ public:
         return cycles_to_ns(rdtscp() - base_tsc_);
     }
 
-    // Get current time in nanoseconds (relative to epoch approximation)
+    // TSC reading -> epoch nanoseconds (lock-free)
+    inline uint64_t tsc_to_ns(uint64_t tsc) const {
+        return epoch_.to_ns(tsc);
+    }
+
+    // Current epoch time in nanoseconds (CLOCK_REALTIME / PHC)
     inline uint64_t now_ns() const {
-        return cycles_to_ns(rdtscp());
+        return tsc_to_ns(rdtscp());
+    }
+
+    TscEpoch epoch() const { return epoch_.load(); }
+
+    // Single writer (calibrate(), then the TscSync thread). The shift is
+    // the startup one: re-fits move the rate by ppm, never by 2x
+    void publish_epoch(uint64_t tsc_base, uint64_t ns_base, double ns_per_cycle) {
+        const TscEpoch e{tsc_base, ns_base, TscScale::with_shift(ns_per_cycle, to_ns_.shift)};
+        epoch_.store(e);
+        if (mirror_ != nullptr) {
+            mirror_->store(e);
+        }
+    }
+
+    // Also publish into clock (nullptr to detach); same writer rules
+    void set_mirror(TscEpochClock* clock) {
+        mirror_ = clock;
+        if (clock != nullptr) {
+            clock->store(epoch_.load());
+        }
+    }
+
+    // CLOCK_REALTIME with the TSC at its midpoint (tightest of a few tries)
+    static void sample_realtime(uint64_t& tsc, uint64_t& realtime_ns) {
+        uint64_t best_width = ~uint64_t{0};
+        for (int i = 0; i < 8; ++i) {
+            timespec ts;
+            const uint64_t before = rdtscp();
+            clock_gettime(CLOCK_REALTIME, &ts);
+            const uint64_t after = rdtscp();
+            if (after - before < best_width) {
+                best_width = after - before;
+                tsc = before + (after - before) / 2;
+                realtime_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+                              static_cast<uint64_t>(ts.tv_nsec);
+            }
+        }
     }
 
     // Accessors for calibration values
     double get_ns_per_cycle() const { return ns_per_cycle_; }
     double get_cycles_per_ns() const { return cycles_per_ns_; }
     double get_ghz() const { return cycles_per_ns_; }  // GHz = cycles per ns
+    TscScale get_ns_scale() const { return to_ns_; }
 };
 
 // Lightweight timing helper for benchmarking
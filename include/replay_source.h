@@ -0,0 +1,84 @@
+#pragma once
+
+#include "tick_journal.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ultra_ll {
+
+// Replay pacing against the recorded timestamps (main --replay-speed)
+// 1.0 = original timing, 4.0 = four times faster, 0 = as fast as possible
+constexpr double REPLAY_MAX_SPEED = 0.0;
+
+// Recorded feed for replay mode (DPDKReceiver::Config::replay_file)
+//
+// Reads a tick journal (.bbj, -J) or a classic Ethernet pcap (us or ns
+// resolution) through a read-only mmap with MADV_SEQUENTIAL. next() yields
+// one Ethernet frame at a time with its recorded timestamp:
+// - pcap: the captured frame as is, capture time in ns
+// - journal: the record rebuilt into the FPGA wire format (Eth/IPv4/UDP
+//   to udp_port + BBO, T1-T4 when the record has them, 8-byte sequence
+//   prefix with wire_seq), timestamp_ns as published
+//
+// The receiver copies each frame into an mbuf and runs it through
+// inject_burst(), so replayed ticks take the production publish path.
+//
+class ReplaySource {
+public:
+    enum class Format : uint8_t { PCAP, JOURNAL };
+
+    struct Frame {
+        const uint8_t* data;    // Valid until the next call to next()
+        uint32_t len;
+        uint64_t ts_ns;
+    };
+
+    ReplaySource() = default;
+    ~ReplaySource();
+
+    // Non-copyable
+    ReplaySource(const ReplaySource&) = delete;
+    ReplaySource& operator=(const ReplaySource&) = delete;
+
+    // Map the file and check its header (cold); false with an error
+    bool open(const std::string& path, uint16_t udp_port, bool wire_seq);
+
+    // False at the end of the recording (or at a truncated pcap record)
+    bool next(Frame& out) noexcept;
+
+    // Back to the first frame (repeat runs)
+    void rewind() noexcept;
+
+    Format format() const noexcept { return format_; }
+    const std::string& path() const noexcept { return path_; }
+
+    // Journal: records in the file; pcap: 0 (not indexed)
+    uint64_t frames() const noexcept { return records_; }
+    uint64_t position() const noexcept { return position_; }
+
+private:
+    std::string path_;
+    Format format_ = Format::PCAP;
+    const uint8_t* map_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;             // Next pcap record / journal record
+    uint64_t position_ = 0;         // Frames returned so far
+    uint64_t records_ = 0;
+
+    // pcap
+    bool swapped_ = false;          // File written on the other endianness
+    uint32_t ts_scale_ = 1000;      // ns per ts_frac unit
+
+    // journal: rebuilt frame
+    uint16_t udp_port_ = 0;
+    bool wire_seq_ = false;
+    alignas(64) uint8_t frame_[128] = {};
+
+    bool open_pcap();
+    bool open_journal();
+    bool next_pcap(Frame& out) noexcept;
+    bool next_journal(Frame& out) noexcept;
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "likely.h"
+#include <rte_byteorder.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_udp.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+
+namespace ultra_ll {
+
+// Where RX bursts come from; the parse / publish pipeline is the same for all
+enum class RxBackend : uint8_t {
+    DPDK,       // vfio/uio-bound NIC through its PMD (default)
+    XDP,        // AF_XDP: kernel-owned NIC through DPDK's net_af_xdp PMD (XSK, UMEM zero copy)
+    SOCKET,     // UDP socket: recvmmsg() with SO_BUSY_POLL into mbufs (last fallback)
+};
+
+inline const char* rx_backend_name(RxBackend b) {
+    switch (b) {
+        case RxBackend::DPDK:   return "dpdk";
+        case RxBackend::XDP: return "af_xdp";
+        case RxBackend::SOCKET: return "socket";
+    }
+    return "?";
+}
+
+// EAL name of the vdev the AF_XDP backend creates (its ethdev port)
+constexpr const char* AF_XDP_VDEV = "net_af_xdp0";
+
+// NUMA node of a kernel interface's device (sysfs), NUMA_NODE_ANY if unknown
+int iface_numa_node(const std::string& iface);
+
+// Kernel-path settings (main -i / -d; unused by the DPDK backend)
+struct RxBackendConfig {
+    RxBackend backend = RxBackend::DPDK;
+    std::string iface;                  // AF_XDP: required; SOCKET: bind + multicast (optional)
+    uint32_t busy_poll_us = 50;         // SOCKET: SO_BUSY_POLL on; AF_XDP: preferred busy polling (0 = off)
+    uint32_t rcvbuf = 4u << 20;         // SOCKET: SO_RCVBUF bytes
+};
+
+// One queue's UDP socket for RxBackend::SOCKET
+//
+// receive() is a stand-in for rte_eth_rx_burst(): one non-blocking
+// recvmmsg() straight into the data room of pre-allocated mbufs, then a
+// prebuilt Ethernet/IPv4/UDP header is written in front of each datagram.
+// The hot path parses the frames exactly as if a NIC had delivered them.
+// Only the mbufs handed out are replaced, so an empty poll costs one
+// syscall and no allocation.
+//
+// With SO_BUSY_POLL set, each recvmmsg() on an empty queue first runs one
+// NAPI poll of the device queue in the calling thread, so the frames reach
+// the socket without waiting for the IRQ and softirq. The socket is
+// nonblocking, so the kernel polls once and returns: the value is not a
+// spin window, and the poll loop itself is the spin. Setting it above
+// net.core.busy_read needs CAP_NET_ADMIN. Queues that share a UDP port
+// join one SO_REUSEPORT group, and the kernel spreads flows across them.
+//
+class SocketRx {
+public:
+    static constexpr uint16_t MAX_BURST = 64;                   // MAX_BURST_SIZE
+    static constexpr size_t HEADERS_SIZE =
+        sizeof(rte_ether_hdr) + sizeof(rte_ipv4_hdr) + sizeof(rte_udp_hdr);
+
+    SocketRx() = default;
+    ~SocketRx();
+
+    // Non-copyable
+    SocketRx(const SocketRx&) = delete;
+    SocketRx& operator=(const SocketRx&) = delete;
+
+    // Bind, join the multicast groups (network byte order) and fill the
+    // mbuf reserve (cold); false with an error
+    bool open(const RxBackendConfig& config, uint16_t udp_port, const uint32_t* mcast_groups,
+              uint8_t num_mcast_groups, rte_mempool* pool);
+
+    // Up to n (<= MAX_BURST) frames into pkts; the caller owns and frees them
+    HOT_FUNC uint16_t receive(rte_mbuf** pkts, uint16_t n) noexcept {
+        if (unlikely(n > available_)) {
+            n = available_;
+            if (n == 0) {
+                refill(0);          // Pool was dry: try again
+                return 0;
+            }
+        }
+        const int got = recvmmsg(fd_, msgs_, n, MSG_DONTWAIT, nullptr);
+        if (likely(got <= 0)) {
+            return 0;               // EAGAIN: queue empty after one NAPI poll
+        }
+
+        for (int i = 0; i < got; ++i) {
+            rte_mbuf* m = reserve_[i];
+            const uint32_t len = msgs_[i].msg_len;
+            if (unlikely(msgs_[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                ++truncated_;       // Cut to the data room; the parser sees the rest
+            }
+            uint8_t* frame = rte_pktmbuf_mtod(m, uint8_t*);
+            std::memcpy(frame, header_, HEADERS_SIZE);
+            const uint16_t dgram_len = rte_cpu_to_be_16(
+                static_cast<uint16_t>(sizeof(rte_udp_hdr) + len));
+            std::memcpy(frame + DGRAM_LEN_OFFSET, &dgram_len, sizeof(dgram_len));
+            m->data_len = static_cast<uint16_t>(HEADERS_SIZE + len);
+            m->pkt_len = m->data_len;
+            pkts[i] = m;
+        }
+
+        refill(static_cast<uint16_t>(got));
+        return static_cast<uint16_t>(got);
+    }
+
+    int fd() const noexcept { return fd_; }
+    // Datagrams larger than the mbuf data room (delivered cut short)
+    uint64_t truncated() const noexcept { return truncated_; }
+
+private:
+    static constexpr size_t DGRAM_LEN_OFFSET =
+        sizeof(rte_ether_hdr) + sizeof(rte_ipv4_hdr) + offsetof(rte_udp_hdr, dgram_len);
+
+    int fd_ = -1;
+    rte_mempool* pool_ = nullptr;
+    uint16_t available_ = 0;            // reserve_[0, available_) hold mbufs
+    uint64_t truncated_ = 0;
+
+    // Header template: what extract_payload() checks (IPv4, IHL 5, UDP, port)
+    alignas(64) uint8_t header_[HEADERS_SIZE] = {};
+
+    // Slot i receives into reserve_[i]'s data room past the header
+    rte_mbuf* reserve_[MAX_BURST] = {};
+    mmsghdr msgs_[MAX_BURST] = {};
+    iovec iov_[MAX_BURST] = {};
+
+    // Replace the first used slots (handed out by receive()) and any empty
+    // ones; with the pool dry the rest move down and recvmmsg() gets fewer
+    NEVER_INLINE void refill(uint16_t used) noexcept;
+    void attach(uint16_t slot, rte_mbuf* m) noexcept;
+};
+
+}  // namespace ultra_ll
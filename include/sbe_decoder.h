@@ -0,0 +1,226 @@
+#pragma once
+
+#include "feed_protocol.h"
+#include "likely.h"
+#include "symbol_filter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+
+namespace ultra_ll {
+
+// Simple Binary Encoding: little-endian, fixed-offset root blocks
+//
+// Per message on the wire:
+//   framing header  message_length(2) encoding_type(2)   (B3 UMDF style; length covers all)
+//   message header  block_length(2) template_id(2) schema_id(2) version(2)
+//   root block      block_length bytes, fields at fixed offsets
+//   [groups / var data, skipped via message_length]
+//
+constexpr size_t SBE_FRAMING_SIZE = 4;
+constexpr size_t SBE_HEADER_SIZE = 8;
+
+// Field types used by schemas
+template<size_t N>
+struct SbeChar {
+    char value[N];
+};
+
+// Decimal with a constant exponent (mantissa * 10^EXP)
+template<typename Mantissa, int EXP>
+struct SbeDecimal {
+    Mantissa mantissa;
+    static constexpr int exponent = EXP;
+};
+
+// Root block layout generated at compile time from the field list
+// (SBE packs root fields in declaration order; offsets are the prefix sums)
+template<typename... Fields>
+struct SbeBlock {
+    using types = std::tuple<Fields...>;
+
+    static constexpr size_t COUNT = sizeof...(Fields);
+    static constexpr size_t LENGTH = (sizeof(Fields) + ... + 0);
+
+    template<size_t I>
+    using type = std::tuple_element_t<I, types>;
+
+    template<size_t I>
+    static constexpr size_t offset = [] {
+        constexpr size_t sizes[] = {sizeof(Fields)...};
+        size_t off = 0;
+        for (size_t i = 0; i < I; ++i) {
+            off += sizes[i];
+        }
+        return off;
+    }();
+
+    template<size_t I>
+    FORCE_INLINE static type<I> get(const uint8_t* block) noexcept {
+        type<I> v;
+        std::memcpy(&v, block + offset<I>, sizeof(v));
+        return v;   // Host is little-endian (x86), as is SBE
+    }
+};
+
+// Decimal -> 1/10000 ticks, scale folded at compile time; false if out of range
+template<typename Mantissa, int EXP>
+FORCE_INLINE bool sbe_to_ticks(SbeDecimal<Mantissa, EXP> d, uint32_t& ticks) noexcept {
+    constexpr int SHIFT = EXP + 4;
+    constexpr auto pow10 = [](int n) {
+        int64_t p = 1;
+        for (int i = 0; i < n; ++i) {
+            p *= 10;
+        }
+        return p;
+    };
+    int64_t v = static_cast<int64_t>(d.mantissa);
+    if constexpr (SHIFT > 0) {
+        v *= pow10(SHIFT);
+    } else if constexpr (SHIFT < 0) {
+        v /= pow10(-SHIFT);
+    }
+    if (unlikely(v < 0 || v > 0xFFFFFFFFLL)) {
+        return false;
+    }
+    ticks = static_cast<uint32_t>(v);
+    return true;
+}
+
+// Example top-of-book schema: one message carrying the best bid and offer
+//
+// A venue schema is a struct of the same shape generated from its XML:
+// ids, a Block alias and the index of each BBO field in the Block list.
+//
+struct TopOfBookSchema {
+    static constexpr uint16_t SCHEMA_ID = 36;
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t TEMPLATE_ID = 1;
+
+    using Block = SbeBlock<
+        SbeChar<8>,                 // 0 symbol
+        SbeDecimal<int64_t, -4>,    // 1 bid price
+        uint32_t,                   // 2 bid size
+        SbeDecimal<int64_t, -4>,    // 3 ask price
+        uint32_t,                   // 4 ask size
+        uint64_t                    // 5 transact time (ns)
+    >;
+
+    static constexpr size_t SYMBOL = 0;
+    static constexpr size_t BID_PRICE = 1;
+    static constexpr size_t BID_SIZE = 2;
+    static constexpr size_t ASK_PRICE = 3;
+    static constexpr size_t ASK_SIZE = 4;
+};
+
+static_assert(TopOfBookSchema::Block::LENGTH == 40, "Packed root block");
+static_assert(TopOfBookSchema::Block::offset<TopOfBookSchema::ASK_PRICE> == 20, "Prefix-sum offsets");
+
+// SBE decoder policy: every matching top-of-book message emits one BBO
+//
+// Messages of other templates or schemas are skipped by message_length.
+// block_length may exceed the schema's (newer version appended fields);
+// a shorter one is an error. Single writer; counters relaxed atomics.
+//
+template<typename Schema = TopOfBookSchema>
+class SbeDecoderT {
+    using Block = typename Schema::Block;
+
+public:
+    template<typename Emit>
+    HOT_FUNC bool decode(const uint8_t* data, size_t len, uint64_t ts_ns, Emit&& emit) noexcept {
+        const uint8_t* p = data;
+        const uint8_t* const end = data + len;
+
+        while (p < end) {
+            if (unlikely(p + SBE_FRAMING_SIZE + SBE_HEADER_SIZE > end)) {
+                return false;
+            }
+            const size_t msg_len = load_le16(p);
+            if (unlikely(msg_len < SBE_FRAMING_SIZE + SBE_HEADER_SIZE || p + msg_len > end)) {
+                return false;
+            }
+
+            const uint8_t* hdr = p + SBE_FRAMING_SIZE;
+            const uint16_t block_len = load_le16(hdr);
+            const uint16_t template_id = load_le16(hdr + 2);
+            const uint16_t schema_id = load_le16(hdr + 4);
+            messages_.store(messages_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            if (likely(template_id == Schema::TEMPLATE_ID && schema_id == Schema::SCHEMA_ID)) {
+                if (unlikely(block_len < Block::LENGTH ||
+                             SBE_FRAMING_SIZE + SBE_HEADER_SIZE + block_len > msg_len)) {
+                    return false;
+                }
+                decode_top_of_book(hdr + SBE_HEADER_SIZE, ts_ns, emit);
+            } else {
+                skipped_.store(skipped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            p += msg_len;
+        }
+        return true;
+    }
+
+    void reset_counters() noexcept {
+        messages_.store(0, std::memory_order_relaxed);
+        updates_.store(0, std::memory_order_relaxed);
+        skipped_.store(0, std::memory_order_relaxed);
+        bad_prices_.store(0, std::memory_order_relaxed);
+        filtered_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t messages() const noexcept { return messages_.load(std::memory_order_relaxed); }
+    uint64_t updates() const noexcept { return updates_.load(std::memory_order_relaxed); }
+    uint64_t skipped() const noexcept { return skipped_.load(std::memory_order_relaxed); }
+    uint64_t bad_prices() const noexcept { return bad_prices_.load(std::memory_order_relaxed); }
+    uint64_t filtered() const noexcept { return filtered_.load(std::memory_order_relaxed); }
+
+    // Subscription set checked before decoding prices; nullptr = every symbol
+    void set_filter(const SymbolFilter* filter) noexcept { filter_ = filter; }
+
+private:
+    const SymbolFilter* filter_ = nullptr;
+
+    alignas(64) std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> bad_prices_{0};
+    std::atomic<uint64_t> filtered_{0};
+
+    FORCE_INLINE static uint16_t load_le16(const uint8_t* p) noexcept {
+        uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    template<typename Emit>
+    FORCE_INLINE void decode_top_of_book(const uint8_t* block, uint64_t ts_ns, Emit& emit) noexcept {
+        const uint8_t* symbol = block + Block::template offset<Schema::SYMBOL>;
+        if (filter_ != nullptr && !filter_->contains(symbol)) {
+            filtered_.store(filtered_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+
+        uint32_t bid, ask;
+        if (unlikely(!sbe_to_ticks(Block::template get<Schema::BID_PRICE>(block), bid) ||
+                     !sbe_to_ticks(Block::template get<Schema::ASK_PRICE>(block), ask))) {
+            bad_prices_.store(bad_prices_.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+            return;
+        }
+
+        BBODataFast bbo;
+        init_feed_bbo(bbo, reinterpret_cast<const char*>(symbol), ts_ns);
+        set_feed_bbo_prices(bbo, bid, Block::template get<Schema::BID_SIZE>(block),
+                            ask, Block::template get<Schema::ASK_SIZE>(block));
+        updates_.store(updates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        emit(bbo);
+    }
+};
+
+using SbeDecoder = SbeDecoderT<TopOfBookSchema>;
+
+}  // namespace ultra_ll
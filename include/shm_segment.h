@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ultra_ll {
+
+// Backing store for the shared-memory rings
+//
+// Default: POSIX shm (shm_open, /dev/shm, 4K pages). With a hugetlbfs mount
+// (e.g. /dev/hugepages) segments are files there instead, backed by 2M/1G
+// pages: a 16384-entry ring is a handful of TLB entries instead of hundreds.
+// Sizes are rounded to the page size (hugetlbfs requires it for ftruncate
+// and munmap). Consumers must map the same path.
+//
+class ShmBacking {
+public:
+    // Empty dir: POSIX shm; false if dir is not a hugetlbfs mount
+    bool init(const std::string& hugepage_dir);
+
+    bool hugepages() const { return !dir_.empty(); }
+    size_t page_size() const { return page_size_; }
+    size_t round(size_t bytes) const { return (bytes + page_size_ - 1) & ~(page_size_ - 1); }
+
+    // shm_name is the POSIX name ("/bbo_ring_<name>"); returns an fd or -1
+    int open(const std::string& shm_name, int flags) const;
+    void unlink(const std::string& shm_name) const;
+    std::string path(const std::string& shm_name) const;
+
+    // Fault in and mlock a mapping. Only created (not yet shared)
+    // segments are written; live ones are read so consumer data is untouched.
+    static bool prefault_and_lock(void* addr, size_t bytes, size_t page_size, bool write);
+
+    // Read one word per page (TLB warm-up for the calling core)
+    static void touch(const void* addr, size_t bytes, size_t page_size);
+
+private:
+    std::string dir_;
+    size_t page_size_ = 4096;
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "latency_histogram.h"
+#include "likely.h"
+#include "rdtsc.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ultra_ll {
+
+constexpr uint16_t TELEMETRY_MAX_QUEUES = 16;
+
+// Single-writer counter
+//
+// Only the owning poll lcore writes it, so an increment is a plain
+// load + add + store (no lock prefix, unlike fetch_add). The aligned
+// 64-bit store is never torn: other threads and processes read a
+// consistent, possibly slightly stale, value.
+//
+class StatCounter {
+public:
+    FORCE_INLINE void add(uint64_t n = 1) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+    // Racy against a running writer (an in-flight add may survive)
+    void reset() noexcept { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// Per-RX-queue counters: one cache line, written by the queue's poll lcore
+struct alignas(64) RxStats {
+    StatCounter packets_received;
+    StatCounter packets_processed;
+    StatCounter packets_dropped;        // Duplicate / stale wire sequence
+    StatCounter packets_filtered;       // Symbol not subscribed (BBO feeds)
+    StatCounter parse_errors;
+    StatCounter ring_buffer_full;
+    StatCounter conflated;              // Absorbed into conflation cache
+    StatCounter conflation_flushed;     // Published from conflation cache
+};
+
+static_assert(sizeof(RxStats) == 64, "RxStats must stay one cache line");
+
+// One queue's slot in the telemetry segment
+struct alignas(64) TelemetryQueue {
+    // Identity, written once before the poll loops start
+    uint16_t queue_id;
+    uint16_t udp_port;
+    uint32_t lcore_id;
+    uint8_t active;                     // Slot in use (queue_id < num_queues)
+    uint8_t has_latency;                // latency is recorded (-L, FPGA stages with -f)
+
+    alignas(64) RxStats stats;
+    LatencyRecorder latency;            // Reader: any one process (see collect())
+};
+
+// Live telemetry exported through shared memory (/bbo_telemetry_<shm>)
+//
+// The receiver's per-queue Stats and latency histograms live here rather
+// than in process memory, so monitoring is an external reader (bbo_stat,
+// a Prometheus exporter) mapping the segment: no stats thread, printf or
+// stdio lock in the process running the poll loops.
+//
+// Memory layout:
+// - Line 0: header, written once at startup
+// - Line 1: the receiver's TSC -> epoch mapping, re-published by TscSync
+//   (timestamp_to_ns() for raw-TSC BBO timestamps)
+// - Per queue: identity line, RxStats line, LatencyRecorder
+//
+// Counters are plain single-writer stores (StatCounter). Histograms use
+// LatencyRecorder's phase handshake: a reader's collect() swaps the
+// writer's phase at its next burst; one reader at a time (others get
+// false from collect()).
+//
+class TelemetrySegment {
+public:
+    static constexpr uint64_t MAGIC = 0x4242'4F54'454C'4533ULL;  // "BBOTELE3"
+
+    TelemetrySegment() noexcept {
+        magic_ = MAGIC;
+        max_queues_ = TELEMETRY_MAX_QUEUES;
+        queue_size_ = sizeof(TelemetryQueue);
+    }
+
+    // Non-copyable (lives in shared memory)
+    TelemetrySegment(const TelemetrySegment&) = delete;
+    TelemetrySegment& operator=(const TelemetrySegment&) = delete;
+
+    // Validate a mapping created by another process (or build)
+    bool is_valid() const noexcept {
+        return magic_ == MAGIC && max_queues_ == TELEMETRY_MAX_QUEUES &&
+               queue_size_ == sizeof(TelemetryQueue);
+    }
+
+    // ---- Receiver side (before the poll loops start) ----
+
+    void describe(int32_t pid, uint16_t port_id, uint16_t num_queues, double tsc_ghz,
+                  uint64_t start_unix_ns, bool raw_tsc) noexcept {
+        pid_ = pid;
+        port_id_ = port_id;
+        num_queues_ = num_queues;
+        raw_tsc_ = raw_tsc ? 1 : 0;
+        tsc_ghz_ = tsc_ghz;
+        start_unix_ns_ = start_unix_ns;
+    }
+
+    TelemetryQueue& queue(uint16_t i) noexcept { return queues_[i]; }
+    TscEpochClock& clock() noexcept { return clock_; }     // TSCCalibrator::set_mirror()
+
+    // ---- Reader side ----
+
+    const TelemetryQueue& queue(uint16_t i) const noexcept { return queues_[i]; }
+    TelemetryQueue& reader_queue(uint16_t i) noexcept { return queues_[i]; }  // collect()
+
+    int32_t pid() const noexcept { return pid_; }
+    uint16_t port_id() const noexcept { return port_id_; }
+    uint16_t num_queues() const noexcept { return num_queues_; }
+    double tsc_ghz() const noexcept { return tsc_ghz_; }
+    uint64_t start_unix_ns() const noexcept { return start_unix_ns_; }
+
+    // BBO timestamp_ns -> epoch ns: identity unless the receiver publishes raw TSC
+    bool raw_tsc() const noexcept { return raw_tsc_ != 0; }
+    const TscEpochClock& clock() const noexcept { return clock_; }
+    uint64_t timestamp_to_ns(uint64_t timestamp) const noexcept {
+        return raw_tsc_ ? clock_.to_ns(timestamp) : timestamp;
+    }
+
+private:
+    // Line 0: header
+    uint64_t magic_;
+    uint32_t max_queues_;
+    uint32_t queue_size_;
+    int32_t pid_ = 0;
+    uint16_t port_id_ = 0;
+    uint16_t num_queues_ = 0;
+    uint8_t raw_tsc_ = 0;               // timestamp_ns holds TSC cycles
+    double tsc_ghz_ = 0.0;
+    uint64_t start_unix_ns_ = 0;
+
+    TscEpochClock clock_;               // Own line (alignas(64) inside)
+
+    alignas(64) TelemetryQueue queues_[TELEMETRY_MAX_QUEUES];
+};
+
+}  // namespace ultra_ll
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "bbo_data.h"
+#include "bbo_parser_fast.h"
+#include "likely.h"
+#include "numa_util.h"
+#include "telemetry.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <type_traits>
+
+namespace ultra_ll {
+
+// One journaled tick: the published BBO plus the FPGA T1-T4 cycle counts
+//
+// Exactly one cache line, so capture is a single 64-byte non-temporal
+// store. The BBO's spread is not stored (ask - bid); everything else is
+// copied field for field.
+//
+// Layout (FloatPrice)              Layout (TickPrice)
+//   0 symbol[8]                      0 symbol[8]
+//   8 bid_price  16 ask_price        8 bid_price  12 ask_price
+//  24 bid_shares 28 ask_shares      16 bid_shares 20 ask_shares
+//  32 timestamp_ns                  24 timestamp_ns
+//  40 sequence  44 instrument_id    32 sequence  36 instrument_id
+//  46 valid  47 flags               38 valid  39 flags
+//  48 fpga_t[4] (host order)        40 fpga_t[4]  56 reserved[8]
+//
+struct alignas(64) JournalRecord {
+    using price_type = BBODataFast::price_type;
+
+    char symbol[8];
+    price_type bid_price;
+    price_type ask_price;
+    uint32_t bid_shares;
+    uint32_t ask_shares;
+    uint64_t timestamp_ns;
+    uint32_t sequence;
+    uint16_t instrument_id;
+    uint8_t valid;
+    uint8_t flags;              // BboFlags: HAS_FPGA_TIMESTAMPS when fpga_t is set
+    uint32_t fpga_t[4];         // T1..T4, 125 MHz cycles (FPGATimestamps order)
+};
+
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord must stay one cache line");
+
+// Journal file header (first 64 bytes of every file, records follow)
+struct alignas(64) JournalFileHeader {
+    static constexpr uint64_t MAGIC = 0x4242'4F4A'524E'4C31ULL;  // "BBOJRNL1"
+
+    uint64_t magic;
+    uint32_t record_size;       // sizeof(JournalRecord)
+    uint8_t tick_prices;        // 1 = TickPrice records, 0 = FloatPrice
+    uint8_t reserved0;
+    uint16_t queue_id;
+    uint64_t records;           // Written so far, updated at every sync
+    uint64_t capacity;          // Records the file was preallocated for
+    uint64_t created_unix_ns;
+    double tsc_ghz;
+    uint32_t file_index;        // Rotation counter, per queue
+    uint32_t reserved1[3];
+
+    bool is_valid() const noexcept {
+        return magic == MAGIC && record_size == sizeof(JournalRecord) &&
+               tick_prices == (std::is_same_v<BBOPrice, TickPrice> ? 1 : 0);
+    }
+};
+
+static_assert(sizeof(JournalFileHeader) == 64, "JournalFileHeader must stay one cache line");
+
+// Per-queue capture ring: poll lcore -> journal writer thread
+//
+// The poll lcore's only per-tick cost is building one JournalRecord on
+// the stack (L1) and streaming it to its slot (movntdq / vmovntdq: the line
+// goes to memory without being read for ownership or evicting the hot
+// working set). The write cursor is published once per burst, after an
+// sfence that orders the streamed lines before it. A full ring drops the
+// record and counts it: the writer thread never backpressures polling.
+//
+// Memory layout:
+// - Line 0: producer-local cursors, drop counter
+// - Line 1: published write cursor (once per burst)
+// - Line 2: read cursor (writer thread)
+// - CAPACITY x 64-byte slots, hugepage-backed when possible
+//
+template<size_t CAPACITY = 262144>
+class JournalRing {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be power of 2");
+
+    static constexpr size_t MASK = CAPACITY - 1;
+
+public:
+    explicit JournalRing(int numa_node = NUMA_NODE_ANY) {
+        allocate_slots();
+        numa_prefer(slots_, bytes(), numa_node);
+        std::memset(slots_, 0, bytes());
+    }
+
+    ~JournalRing() {
+        if (slots_) {
+            if (using_hugepages_) {
+                munmap(slots_, bytes());
+            } else {
+                std::free(slots_);
+            }
+        }
+    }
+
+    // Non-copyable
+    JournalRing(const JournalRing&) = delete;
+    JournalRing& operator=(const JournalRing&) = delete;
+
+    // ---- Producer side (poll lcore) ----
+
+    // payload: the BBO's wire bytes for T1-T4 (nullptr for decoded feeds)
+    HOT_FUNC
+    void append(const BBODataFast& bbo, const uint8_t* payload, size_t payload_len) noexcept {
+        const uint64_t seq = head_;
+        if (unlikely(seq - cached_tail_ >= CAPACITY)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (seq - cached_tail_ >= CAPACITY) {
+                dropped_.add();
+                return;
+            }
+        }
+
+        alignas(64) JournalRecord rec{};     // Zeroed padding: files compress well
+        std::memcpy(rec.symbol, bbo.symbol, sizeof(rec.symbol));
+        rec.bid_price = bbo.bid_price;
+        rec.ask_price = bbo.ask_price;
+        rec.bid_shares = bbo.bid_shares;
+        rec.ask_shares = bbo.ask_shares;
+        rec.timestamp_ns = bbo.timestamp_ns;
+        rec.sequence = bbo.sequence;
+        rec.instrument_id = bbo.instrument_id;
+        rec.valid = bbo.valid;
+        if (payload != nullptr && payload_len >= BBO_FULL_SIZE) {
+            uint32_t t[4];
+            std::memcpy(t, payload + T1_OFFSET, sizeof(t));
+            for (int i = 0; i < 4; ++i) {
+                rec.fpga_t[i] = __builtin_bswap32(t[i]);
+            }
+            rec.flags = bbo.flags | BboFlags::HAS_FPGA_TIMESTAMPS;
+        } else {
+            rec.flags = bbo.flags & ~BboFlags::HAS_FPGA_TIMESTAMPS;
+        }
+
+        stream_line(&slots_[seq & MASK], &rec);
+        head_ = seq + 1;
+    }
+
+    // Once per burst: order the streamed lines, then hand them over
+    HOT_FUNC
+    void publish() noexcept {
+        if (head_ != published_) {
+            _mm_sfence();
+            write_cursor_.store(head_, std::memory_order_release);
+            published_ = head_;
+        }
+    }
+
+    // ---- Consumer side (journal writer thread) ----
+
+    // Copy up to max records into out, return the count
+    size_t drain(JournalRecord* out, size_t max) noexcept {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t head = write_cursor_.load(std::memory_order_acquire);
+        size_t n = static_cast<size_t>(head - tail);
+        n = n < max ? n : max;
+
+        // At most two contiguous pieces (wrap)
+        const size_t first = CAPACITY - (tail & MASK);
+        const size_t a = n < first ? n : first;
+        std::memcpy(out, &slots_[tail & MASK], a * sizeof(JournalRecord));
+        std::memcpy(out + a, &slots_[0], (n - a) * sizeof(JournalRecord));
+
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    uint64_t written() const noexcept { return write_cursor_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const noexcept { return dropped_.load(); }
+    uint64_t pending() const noexcept {
+        return write_cursor_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+
+    bool is_using_hugepages() const noexcept { return using_hugepages_; }
+    static constexpr size_t capacity() noexcept { return CAPACITY; }
+    static constexpr size_t bytes() noexcept { return CAPACITY * sizeof(JournalRecord); }
+
+private:
+    // Line 0: producer
+    uint64_t head_ = 0;             // Next slot to stream
+    uint64_t published_ = 0;        // Last value stored to write_cursor_
+    uint64_t cached_tail_ = 0;
+    StatCounter dropped_;           // Ring full
+
+    alignas(64) std::atomic<uint64_t> write_cursor_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+
+    alignas(64) JournalRecord* slots_ = nullptr;     // Off the cursor lines
+    bool using_hugepages_ = false;
+
+    // One 64-byte non-temporal line store (src in L1, dst 64-byte aligned)
+    FORCE_INLINE static void stream_line(JournalRecord* dst, const JournalRecord* src) noexcept {
+#if defined(__AVX512F__)
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst),
+                            _mm512_load_si512(reinterpret_cast<const __m512i*>(src)));
+#elif defined(__AVX__)
+        auto* d = reinterpret_cast<__m256i*>(dst);
+        const auto* s = reinterpret_cast<const __m256i*>(src);
+        _mm256_stream_si256(d, _mm256_load_si256(s));
+        _mm256_stream_si256(d + 1, _mm256_load_si256(s + 1));
+#else
+        auto* d = reinterpret_cast<__m128i*>(dst);
+        const auto* s = reinterpret_cast<const __m128i*>(src);
+        for (int i = 0; i < 4; ++i) {
+            _mm_stream_si128(d + i, _mm_load_si128(s + i));
+        }
+#endif
+    }
+
+    void allocate_slots() {
+        // Hugepages first (same policy as BBOPool)
+        void* p = mmap(nullptr, bytes(), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            slots_ = static_cast<JournalRecord*>(p);
+            using_hugepages_ = true;
+            return;
+        }
+
+        slots_ = static_cast<JournalRecord*>(aligned_alloc(NUMA_PAGE_SIZE, bytes()));
+        using_hugepages_ = false;
+        if (!slots_) {
+            std::abort();
+        }
+    }
+};
+
+// 262144 records = 16 MB per queue (~25 ms of 10 M ticks/s)
+using DefaultJournalRing = JournalRing<262144>;
+
+// Journal writer settings (main -J / -k / -Z)
+struct JournalConfig {
+    std::string dir;                    // Output directory (empty = journaling off)
+    uint64_t file_records = 1u << 24;   // Records per file before rotating (1 GB)
+    int core = -1;                      // Writer thread CPU (a non-isolated core)
+    std::string compress;               // Run as "<compress> <file>" after rotation
+    uint32_t sync_ms = 1000;            // msync + header update interval
+};
+
+// Writer thread: drains every queue's JournalRing into preallocated,
+// mmap'd files "<dir>/<shm>_q<N>_<index>.bbj"
+//
+// All file work happens here, off the poll lcores: preallocation
+// (posix_fallocate), copying, the periodic msync / header update, rotation
+// (final msync, truncate to the records written, fsync) and compression
+// (a child process per rotated file, reaped without blocking).
+//
+class JournalWriter {
+public:
+    JournalWriter(const JournalConfig& config, std::string shm_name, double tsc_ghz);
+    ~JournalWriter();
+
+    // Non-copyable
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Cold setup, before start(): ring of queue q (rings[q] may repeat)
+    void add_queue(uint16_t queue_id, DefaultJournalRing* ring);
+
+    // Open the first files and launch the thread
+    bool start();
+
+    // Drain what is left, close the files, join
+    void stop();
+
+    uint64_t records() const noexcept { return records_.load(std::memory_order_relaxed); }
+    uint64_t files() const noexcept { return files_.load(std::memory_order_relaxed); }
+    const JournalConfig& config() const noexcept { return config_; }
+
+private:
+    struct QueueFile {
+        uint16_t queue_id = 0;
+        DefaultJournalRing* ring = nullptr;
+        int fd = -1;
+        JournalFileHeader* header = nullptr;    // Start of the mapping
+        JournalRecord* records = nullptr;
+        uint64_t count = 0;
+        uint32_t index = 0;
+        std::string path;
+    };
+
+    JournalConfig config_;
+    std::string shm_name_;
+    double tsc_ghz_;
+    QueueFile queues_[TELEMETRY_MAX_QUEUES];
+    uint16_t num_queues_ = 0;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> records_{0};
+    std::atomic<uint64_t> files_{0};
+    int children_ = 0;                  // Compression processes not yet reaped
+
+    void run();
+    size_t drain(QueueFile& f);
+    bool open_file(QueueFile& f);
+    void close_file(QueueFile& f, bool rotated);
+    void sync_file(QueueFile& f, bool wait);
+    void compress(const std::string& path);
+    void reap_children(bool wait);
+};
+
+}  // namespace ultra_ll
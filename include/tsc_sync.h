@@ -0,0 +1,103 @@
+#pragma once
+
+#include "rdtsc.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ultra_ll {
+
+// What a TSC tick means across cores and power states (CPUID + /proc/cpuinfo)
+struct TscFeatures {
+    bool invariant;             // CPUID 80000007h EDX[8]: constant rate in every P/C-state
+    bool constant;              // Linux constant_tsc: rate independent of P-states
+    bool rdtscp;                // CPUID 80000001h EDX[27]
+};
+
+TscFeatures detect_tsc_features();
+
+// Clock the epoch mapping follows
+enum class TscReference : uint8_t {
+    REALTIME,   // CLOCK_REALTIME (NTP / PTP-disciplined system clock)
+    PHC,        // The port's PTP hardware clock (rte_eth_timesync_read_time)
+};
+
+inline const char* tsc_reference_name(TscReference r) {
+    return r == TscReference::PHC ? "phc" : "realtime";
+}
+
+// Recalibration settings (main -t / --tsc-sync)
+struct TscSyncConfig {
+    bool enabled = false;
+    TscReference reference = TscReference::REALTIME;
+    uint32_t interval_ms = 1000;        // One reference sample per interval
+    uint32_t window = 64;               // Samples in the rolling fit (~1 min)
+    int64_t step_ns = 1000000;          // Offsets beyond this step, smaller ones slew
+    int core = -1;                      // Thread CPU (a non-isolated core)
+};
+
+// Background TSC -> reference clock fit
+//
+// The 10 ms startup calibration is good to ~1e-4: microseconds of drift
+// per hour. Every interval this thread takes a tightly bracketed
+// (rdtscp, reference) sample, least-squares fits the rolling window, and
+// publishes a new TscEpoch through TSCCalibrator's seqlock. The hot path
+// keeps reading tsc_to_ns() lock-free.
+//
+// Each new mapping starts where the old one is at the publish TSC, so
+// timestamps never jump: a residual offset is slewed out over the next
+// interval by adjusting the rate. Only offsets beyond step_ns (reference
+// clock set, or the first fit) are stepped, and the window restarts.
+//
+class TscSync {
+public:
+    TscSync(TSCCalibrator& tsc, const TscSyncConfig& config, uint16_t phc_port);
+    ~TscSync();
+
+    // Non-copyable
+    TscSync(const TscSync&) = delete;
+    TscSync& operator=(const TscSync&) = delete;
+
+    // First sample and fit, on the caller's thread (cold); false if the
+    // reference is unreadable
+    bool sync_once();
+
+    // Launch the thread; until stop() it is the only epoch writer
+    void start();
+    void stop();
+
+    uint64_t updates() const noexcept { return updates_.load(std::memory_order_relaxed); }
+    uint64_t steps() const noexcept { return steps_.load(std::memory_order_relaxed); }
+    // Reference minus mapping at the last sample, before correcting it
+    int64_t last_offset_ns() const noexcept { return offset_ns_.load(std::memory_order_relaxed); }
+    // Fitted rate against the startup calibration, parts per million
+    double rate_ppm() const noexcept { return rate_ppm_.load(std::memory_order_relaxed); }
+    const TscSyncConfig& config() const noexcept { return config_; }
+
+private:
+    struct Sample {
+        uint64_t tsc;
+        uint64_t ns;
+    };
+
+    TSCCalibrator& tsc_;
+    TscSyncConfig config_;
+    uint16_t phc_port_;
+    std::vector<Sample> window_;        // Ring of the last config_.window samples
+    size_t next_ = 0;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<uint64_t> steps_{0};
+    std::atomic<int64_t> offset_ns_{0};
+    std::atomic<double> rate_ppm_{0.0};
+
+    void run();
+    bool sample(Sample& out) const;
+    void update(const Sample& s);
+    // Least-squares rate, and fitted line minus mapped at tsc
+    bool fit(uint64_t tsc, uint64_t mapped, double& ns_per_cycle, double& error_ns) const;
+};
+
+}  // namespace ultra_ll
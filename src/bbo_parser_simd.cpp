@@ -0,0 +1,288 @@
+#include "bbo_parser_simd.h"
+#include <immintrin.h>
+#include <cstring>
+#include <type_traits>
+
+namespace ultra_ll {
+
+namespace {
+
+// 2^52 as double / as bit pattern: (u64 | MAGIC_BITS) - MAGIC_DOUBLE == (double)u64
+// for u64 < 2^52 - exact uint32 -> double without AVX-512's vcvtudq2pd
+constexpr uint64_t MAGIC_BITS = 0x4330000000000000ULL;
+constexpr double MAGIC_DOUBLE = 4503599627370496.0;
+
+// Both BBODataFast layouts are handled: FloatPrice converts in SIMD,
+// TickPrice just reorders the swapped wire dwords into place
+constexpr bool TICKS = std::is_same_v<BBOPrice, TickPrice>;
+
+// 8 bytes at BBODataFast::sequence: sequence | valid | flags | instrument_id (0)
+FORCE_INLINE uint64_t pack_meta(const BurstParseInput& p) noexcept {
+    const uint64_t flags = (p.len >= BBO_FULL_SIZE) ? BboFlags::HAS_FPGA_TIMESTAMPS : 0;
+    return static_cast<uint64_t>(p.sequence) | (uint64_t{1} << 32) | (flags << 40);
+}
+
+// lo | hi as one zmm. GCC 12's _mm512_inserti64x4 (which its
+// _mm512_zextsi256_si512 is built on) merges into an undefined vector that
+// -Wmaybe-uninitialized flags at -O3; the zero-masked form with a full
+// mask does not, and is the same single vinserti64x4. hi overwrites the
+// cast's undefined upper lane.
+__attribute__((target("avx512f")))
+FORCE_INLINE __m512i join_256(__m256i lo, __m256i hi) noexcept {
+    return _mm512_maskz_inserti64x4(0xFF, _mm512_castsi256_si512(lo), hi, 1);
+}
+
+}  // namespace
+
+// ---- Scalar (SWAR) ----
+
+uint32_t BBOParserSimd::parse_burst_scalar(const BurstParseInput* in, uint32_t n,
+                                           BBODataFast* const* out) noexcept {
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const BurstParseInput& p = in[i];
+        if (unlikely(p.len < BBO_MIN_SIZE) ||
+            unlikely(!BBOParserFast::symbol_is_printable(p.data))) {
+            continue;
+        }
+        BBOParserFast::fill(p.data, p.len, *out[k], p.ts_ns, p.sequence);
+        ++k;
+    }
+    return k;
+}
+
+// ---- SSE4.1: vector symbol check and byte swap, scalar conversion ----
+
+__attribute__((target("sse4.1")))
+uint32_t BBOParserSimd::parse_burst_sse4(const BurstParseInput* in, uint32_t n,
+                                         BBODataFast* const* out) noexcept {
+    const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                        11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i lo_bound = _mm_set1_epi8(0x1F);
+    const __m128i hi_bound = _mm_set1_epi8(0x7F);
+
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const BurstParseInput& p = in[i];
+        if (unlikely(p.len < BBO_MIN_SIZE)) {
+            continue;
+        }
+
+        // Bytes 0..15 (symbol, bid, bid_shares) and 12..27 (bid_shares, ask, ask_shares, spread)
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.data));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.data + 12));
+
+        // Signed compare: bytes >= 0x80 are negative and fail the low bound
+        const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(a, lo_bound),
+                                                _mm_cmpgt_epi8(hi_bound, a));
+        const uint32_t sym_ok = (_mm_movemask_epi8(printable) & 0xFF) == 0xFF;
+
+        const __m128i sa = _mm_shuffle_epi8(a, bswap);
+        const __m128i sb = _mm_shuffle_epi8(b, bswap);
+
+        BBODataFast& bbo = *out[k];
+        std::memcpy(bbo.symbol, p.data + SYMBOL_OFFSET, 8);
+        bbo.bid_price = BBOPrice::from_raw(static_cast<uint32_t>(_mm_extract_epi32(sa, 2)));
+        bbo.ask_price = BBOPrice::from_raw(static_cast<uint32_t>(_mm_extract_epi32(sb, 1)));
+        bbo.bid_shares = static_cast<uint32_t>(_mm_extract_epi32(sa, 3));
+        bbo.ask_shares = static_cast<uint32_t>(_mm_extract_epi32(sb, 2));
+        bbo.spread = BBOPrice::from_raw(static_cast<uint32_t>(_mm_extract_epi32(sb, 3)));
+        bbo.timestamp_ns = p.ts_ns;
+
+        const uint64_t meta = pack_meta(p);
+        std::memcpy(&bbo.sequence, &meta, sizeof(meta));
+        std::memset(bbo.padding, 0, sizeof(bbo.padding));
+        BBOParserFast::clear_alignment_hole(bbo);
+
+        k += sym_ok;
+    }
+    return k;
+}
+
+// ---- AVX2: whole line assembled in registers, two 32-byte stores ----
+
+__attribute__((target("avx2")))
+uint32_t BBOParserSimd::parse_burst_avx2(const BurstParseInput* in, uint32_t n,
+                                         BBODataFast* const* out) noexcept {
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12);
+    // Dword i is loaded when len >= 4*i + 4, dword 7 never (28-byte BBO)
+    const __m256i lane_last_byte = _mm256_setr_epi32(3, 7, 11, 15, 19, 23, 27, 0x7FFFFFFF);
+    const __m256i lo_bound = _mm256_set1_epi8(0x1F);
+    const __m256i hi_bound = _mm256_set1_epi8(0x7F);
+    // After byte swap: dwords 2=bid 3=bid_shares 4=ask 5=ask_shares 6=spread
+    const __m256i field_idx = _mm256_setr_epi32(2, 4, 6, 6, 3, 5, 3, 5);
+    // TickPrice: symbol, bid, ask, bid_shares, ask_shares, spread, hole
+    const __m256i tick_idx = _mm256_setr_epi32(0, 1, 2, 4, 3, 5, 6, 7);
+    const __m256i magic_bits = _mm256_set1_epi64x(static_cast<long long>(MAGIC_BITS));
+    const __m256d magic = _mm256_set1_pd(MAGIC_DOUBLE);
+    const __m256d mult = _mm256_set1_pd(PRICE_MULTIPLIER);
+
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const BurstParseInput& p = in[i];
+
+        // Masked load never touches bytes past len (no fault on short packets)
+        const __m256i load_mask = _mm256_cmpgt_epi32(
+            _mm256_set1_epi32(static_cast<int>(p.len)), lane_last_byte);
+        const __m256i raw = _mm256_maskload_epi32(
+            reinterpret_cast<const int*>(p.data), load_mask);
+
+        const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(raw, lo_bound),
+                                                   _mm256_cmpgt_epi8(hi_bound, raw));
+        const uint32_t ok = ((_mm256_movemask_epi8(printable) & 0xFF) == 0xFF) &
+                            (p.len >= BBO_MIN_SIZE);
+
+        const __m256i swapped = _mm256_shuffle_epi8(raw, bswap);
+        __m256i* dst = reinterpret_cast<__m256i*>(out[k]);
+
+        if constexpr (TICKS) {
+            // Bytes 0..31: symbol | bid, ask | bid_shares, ask_shares | spread, 0
+            __m256i lo = _mm256_permutevar8x32_epi32(swapped, tick_idx);
+            lo = _mm256_blend_epi32(lo, raw, 0x03);
+            lo = _mm256_blend_epi32(lo, _mm256_setzero_si256(), 0x80);
+
+            // Bytes 32..63: timestamp_ns | meta | padding
+            const __m256i hi = _mm256_set_epi64x(0, 0, static_cast<long long>(pack_meta(p)),
+                                                 static_cast<long long>(p.ts_ns));
+            _mm256_store_si256(dst, lo);
+            _mm256_store_si256(dst + 1, hi);
+            k += ok;
+            continue;
+        }
+
+        const __m256i fields = _mm256_permutevar8x32_epi32(swapped, field_idx);
+
+        // [bid, ask, spread, spread] as double
+        const __m256i px64 = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(fields));
+        const __m256d px = _mm256_mul_pd(
+            _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(px64, magic_bits)), magic),
+            mult);
+        const __m256i pxi = _mm256_castpd_si256(px);
+
+        // Bytes 0..31: symbol | bid_price | ask_price | bid_shares, ask_shares
+        __m256i lo = _mm256_permute4x64_epi64(pxi, _MM_SHUFFLE(3, 1, 0, 0));
+        lo = _mm256_blend_epi32(lo, raw, 0x03);
+        lo = _mm256_blend_epi32(lo, _mm256_permute4x64_epi64(fields, _MM_SHUFFLE(2, 2, 2, 2)),
+                                0xC0);
+
+        // Bytes 32..63: spread | timestamp_ns | meta | padding
+        __m256i hi = _mm256_set_epi64x(0, static_cast<long long>(pack_meta(p)),
+                                       static_cast<long long>(p.ts_ns), 0);
+        hi = _mm256_blend_epi32(hi, _mm256_permute4x64_epi64(pxi, _MM_SHUFFLE(2, 2, 2, 2)),
+                                0x03);
+
+        _mm256_store_si256(dst, lo);
+        _mm256_store_si256(dst + 1, hi);
+
+        k += ok;
+    }
+    return k;
+}
+
+// ---- AVX-512: native u32->double, one 64-byte store per BBO ----
+
+__attribute__((target("avx512f,avx512vl,avx512bw,bmi2")))
+uint32_t BBOParserSimd::parse_burst_avx512(const BurstParseInput* in, uint32_t n,
+                                           BBODataFast* const* out) noexcept {
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4,
+                                           11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i lo_bound = _mm256_set1_epi8(0x20);
+    const __m256i hi_bound = _mm256_set1_epi8(0x7E);
+    const __m256i field_idx = _mm256_setr_epi32(2, 4, 6, 6, 3, 5, 3, 5);
+    const __m256i tick_idx = _mm256_setr_epi32(0, 1, 2, 4, 3, 5, 6, 7);
+    const __m256d mult = _mm256_set1_pd(PRICE_MULTIPLIER);
+
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const BurstParseInput& p = in[i];
+
+        // Byte-granular masked load of min(len, 28) bytes
+        const uint32_t load_len = p.len < BBO_MIN_SIZE ? p.len : BBO_MIN_SIZE;
+        const __mmask32 load_mask = _bzhi_u32(0xFFFFFFFFu, load_len);
+        const __m256i raw = _mm256_maskz_loadu_epi8(load_mask, p.data);
+
+        const __mmask32 printable = _mm256_cmpge_epu8_mask(raw, lo_bound) &
+                                    _mm256_cmple_epu8_mask(raw, hi_bound);
+        const uint32_t ok = ((printable & 0xFF) == 0xFF) & (p.len >= BBO_MIN_SIZE);
+
+        const __m256i swapped = _mm256_shuffle_epi8(raw, bswap);
+
+        if constexpr (TICKS) {
+            __m256i lo = _mm256_permutevar8x32_epi32(swapped, tick_idx);
+            lo = _mm256_mask_blend_epi32(0x03, lo, raw);
+            lo = _mm256_maskz_mov_epi32(0x7F, lo);
+
+            const __m256i hi = _mm256_set_epi64x(0, 0, static_cast<long long>(pack_meta(p)),
+                                                 static_cast<long long>(p.ts_ns));
+            _mm512_store_si512(out[k], join_256(lo, hi));
+            k += ok;
+            continue;
+        }
+
+        const __m256i fields = _mm256_permutevar8x32_epi32(swapped, field_idx);
+
+        const __m256d px = _mm256_mul_pd(
+            _mm256_cvtepu32_pd(_mm256_castsi256_si128(fields)), mult);
+        const __m256i pxi = _mm256_castpd_si256(px);
+
+        __m256i lo = _mm256_permute4x64_epi64(pxi, _MM_SHUFFLE(3, 1, 0, 0));
+        lo = _mm256_blend_epi32(lo, raw, 0x03);
+        lo = _mm256_blend_epi32(lo, _mm256_permute4x64_epi64(fields, _MM_SHUFFLE(2, 2, 2, 2)),
+                                0xC0);
+
+        __m256i hi = _mm256_set_epi64x(0, static_cast<long long>(pack_meta(p)),
+                                       static_cast<long long>(p.ts_ns), 0);
+        hi = _mm256_blend_epi32(hi, _mm256_permute4x64_epi64(pxi, _MM_SHUFFLE(2, 2, 2, 2)),
+                                0x03);
+
+        _mm512_store_si512(out[k], join_256(lo, hi));
+
+        k += ok;
+    }
+    return k;
+}
+
+// ---- Dispatch ----
+
+SimdIsa BBOParserSimd::detect() noexcept {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("bmi2")) {
+        return SimdIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdIsa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdIsa::SSE4;
+    }
+    return SimdIsa::SCALAR;
+}
+
+BurstParseFn BBOParserSimd::select(SimdIsa isa) noexcept {
+    switch (isa) {
+    case SimdIsa::AVX512: return &parse_burst_avx512;
+    case SimdIsa::AVX2:   return &parse_burst_avx2;
+    case SimdIsa::SSE4:   return &parse_burst_sse4;
+    case SimdIsa::SCALAR: break;
+    }
+    return &parse_burst_scalar;
+}
+
+const char* BBOParserSimd::isa_name(SimdIsa isa) noexcept {
+    switch (isa) {
+    case SimdIsa::AVX512: return "AVX-512";
+    case SimdIsa::AVX2:   return "AVX2";
+    case SimdIsa::SSE4:   return "SSE4.1";
+    case SimdIsa::SCALAR: break;
+    }
+    return "scalar";
+}
+
+}  // namespace ultra_ll
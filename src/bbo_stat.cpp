@@ -0,0 +1,356 @@
+/**
+ * bbo_stat - live receiver statistics from the telemetry segment
+ *
+ * Maps /bbo_telemetry_<shm> read-write (latency collection hands a request
+ * to the poll lcores) and prints per-queue counters, rates and latency
+ * percentiles. The receiver itself never formats or prints anything.
+ *
+ *   bbo_stat -s gateway -i 1          # human-readable, every second
+ *   bbo_stat -s gateway -P -o         # Prometheus text format, one scrape
+ */
+
+#include "shm_segment.h"
+#include "telemetry.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using ultra_ll::LatencyHistogram;
+using ultra_ll::LatencyStage;
+using ultra_ll::RxStats;
+using ultra_ll::TelemetryQueue;
+using ultra_ll::TelemetrySegment;
+
+// Set by SIGINT/SIGTERM, so the tool never exits inside collect()
+static std::atomic<bool> g_stop{false};
+
+void signal_handler(int)
+{
+    g_stop.store(true, std::memory_order_relaxed);
+}
+
+struct Options
+{
+    std::string shm_name = "gateway";
+    std::string hugepage_dir;
+    double interval_s = 1.0;
+    bool once = false;
+    bool prometheus = false;
+};
+
+// Counter snapshot for rates
+struct Snapshot
+{
+    uint64_t received = 0;
+    uint64_t processed = 0;
+    uint64_t dropped = 0;
+    uint64_t filtered = 0;
+    uint64_t errors = 0;
+    uint64_t full = 0;
+    uint64_t conflated = 0;
+    uint64_t flushed = 0;
+};
+
+Snapshot snapshot(const RxStats &st)
+{
+    Snapshot s;
+    s.received = st.packets_received.load();
+    s.processed = st.packets_processed.load();
+    s.dropped = st.packets_dropped.load();
+    s.filtered = st.packets_filtered.load();
+    s.errors = st.parse_errors.load();
+    s.full = st.ring_buffer_full.load();
+    s.conflated = st.conflated.load();
+    s.flushed = st.conflation_flushed.load();
+    return s;
+}
+
+uint64_t to_ns(const TelemetrySegment &seg, LatencyStage stage, uint64_t ticks)
+{
+    if (ultra_ll::latency_stage_is_fpga(stage))
+    {
+        return static_cast<uint64_t>(ticks * ultra_ll::FPGA_NS_PER_CYCLE);
+    }
+    return seg.tsc_ghz() > 0.0 ? static_cast<uint64_t>(ticks / seg.tsc_ghz()) : ticks;
+}
+
+TelemetrySegment *map_segment(const Options &opt)
+{
+    ultra_ll::ShmBacking backing;
+    if (!backing.init(opt.hugepage_dir))
+    {
+        return nullptr;
+    }
+
+    const std::string name = "/bbo_telemetry_" + opt.shm_name;
+    const int fd = backing.open(name, O_RDWR);
+    if (fd == -1)
+    {
+        std::fprintf(stderr, "Error: Cannot open '%s': %s (is the receiver running?)\n",
+                     backing.path(name).c_str(), std::strerror(errno));
+        return nullptr;
+    }
+
+    const size_t bytes = backing.round(sizeof(TelemetrySegment));
+    void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED)
+    {
+        std::fprintf(stderr, "Error: Failed to map '%s': %s\n", name.c_str(), std::strerror(errno));
+        return nullptr;
+    }
+
+    auto *seg = static_cast<TelemetrySegment *>(ptr);
+    if (!seg->is_valid())
+    {
+        std::fprintf(stderr, "Error: '%s' has a different layout (rebuild bbo_stat)\n",
+                     name.c_str());
+        munmap(ptr, bytes);
+        return nullptr;
+    }
+    return seg;
+}
+
+void print_human(TelemetrySegment &seg, Snapshot *last, double elapsed_s)
+{
+    const bool alive = seg.pid() > 0 && kill(seg.pid(), 0) == 0;
+    std::printf("=== Receiver pid %d, port %u, %u queues, TSC %.3f GHz%s%s ===\n",
+                seg.pid(), seg.port_id(), seg.num_queues(), seg.tsc_ghz(),
+                seg.raw_tsc() ? ", raw TSC timestamps" : "", alive ? "" : " (not running)");
+
+    for (uint16_t i = 0; i < seg.num_queues(); ++i)
+    {
+        const TelemetryQueue &t = seg.queue(i);
+        const Snapshot now = snapshot(t.stats);
+        const double rx_rate = elapsed_s > 0 ? (now.received - last[i].received) / elapsed_s : 0;
+        const double pub_rate = elapsed_s > 0 ? (now.processed - last[i].processed) / elapsed_s : 0;
+
+        std::printf("  Queue %u (lcore %u, udp %u): rx=%lu (%.0f/s) processed=%lu (%.0f/s) "
+                    "errors=%lu full=%lu dropped=%lu filtered=%lu conflated=%lu flushed=%lu\n",
+                    t.queue_id, t.lcore_id, t.udp_port, now.received, rx_rate,
+                    now.processed, pub_rate, now.errors, now.full, now.dropped,
+                    now.filtered, now.conflated, now.flushed);
+        last[i] = now;
+
+        if (!t.has_latency)
+        {
+            continue;
+        }
+        ultra_ll::LatencyRecorder &rec = seg.reader_queue(i).latency;
+        if (!rec.collect())
+        {
+            std::printf("    Latency: busy (another reader or the queue is stalled)\n");
+            continue;
+        }
+        std::printf("    Latency (ns)       count      p50      p99    p99.9      max   last p99\n");
+        for (size_t s = 0; s < ultra_ll::LATENCY_STAGES; ++s)
+        {
+            const auto stage = static_cast<LatencyStage>(s);
+            const LatencyHistogram &h = rec.cumulative(stage);
+            if (h.count() == 0)
+            {
+                continue;
+            }
+            const LatencyHistogram &iv = rec.interval(stage);
+            std::printf("    %-15s %9lu %8lu %8lu %8lu %8lu %10lu\n",
+                        ultra_ll::latency_stage_name(stage), h.count(),
+                        to_ns(seg, stage, h.value_at_percentile(50.0)),
+                        to_ns(seg, stage, h.value_at_percentile(99.0)),
+                        to_ns(seg, stage, h.value_at_percentile(99.9)),
+                        to_ns(seg, stage, h.max()),
+                        iv.count() ? to_ns(seg, stage, iv.value_at_percentile(99.0)) : 0);
+        }
+    }
+    std::fflush(stdout);
+}
+
+// Prometheus text exposition format (node_exporter textfile or a scrape wrapper)
+void print_prometheus(TelemetrySegment &seg)
+{
+    struct Counter
+    {
+        const char *name;
+        const char *help;
+        uint64_t Snapshot::*field;
+    };
+    static const Counter counters[] = {
+        {"bbo_rx_packets_received_total", "Packets received from the NIC", &Snapshot::received},
+        {"bbo_rx_packets_processed_total", "Packets parsed and published", &Snapshot::processed},
+        {"bbo_rx_packets_dropped_total", "Duplicate or stale wire sequence", &Snapshot::dropped},
+        {"bbo_rx_packets_filtered_total", "Symbol not subscribed", &Snapshot::filtered},
+        {"bbo_rx_parse_errors_total", "Packets that failed to parse", &Snapshot::errors},
+        {"bbo_rx_ring_full_total", "Publishes rejected by a full ring", &Snapshot::full},
+        {"bbo_rx_conflated_total", "BBOs absorbed into the conflation cache", &Snapshot::conflated},
+        {"bbo_rx_conflation_flushed_total", "BBOs published from the conflation cache",
+         &Snapshot::flushed},
+    };
+
+    Snapshot snaps[ultra_ll::TELEMETRY_MAX_QUEUES];
+    for (uint16_t i = 0; i < seg.num_queues(); ++i)
+    {
+        snaps[i] = snapshot(seg.queue(i).stats);
+    }
+
+    for (const Counter &c : counters)
+    {
+        std::printf("# HELP %s %s\n# TYPE %s counter\n", c.name, c.help, c.name);
+        for (uint16_t i = 0; i < seg.num_queues(); ++i)
+        {
+            std::printf("%s{queue=\"%u\"} %lu\n", c.name, seg.queue(i).queue_id,
+                        snaps[i].*c.field);
+        }
+    }
+
+    std::printf("# HELP bbo_rx_latency_ns Per-stage latency since receiver start\n"
+                "# TYPE bbo_rx_latency_ns summary\n");
+    for (uint16_t i = 0; i < seg.num_queues(); ++i)
+    {
+        const TelemetryQueue &t = seg.queue(i);
+        ultra_ll::LatencyRecorder &rec = seg.reader_queue(i).latency;
+        if (!t.has_latency || !rec.collect())
+        {
+            continue;
+        }
+        for (size_t s = 0; s < ultra_ll::LATENCY_STAGES; ++s)
+        {
+            const auto stage = static_cast<LatencyStage>(s);
+            const LatencyHistogram &h = rec.cumulative(stage);
+            if (h.count() == 0)
+            {
+                continue;
+            }
+            const char *name = ultra_ll::latency_stage_name(stage);
+            for (double q : {0.5, 0.9, 0.99, 0.999})
+            {
+                std::printf("bbo_rx_latency_ns{queue=\"%u\",stage=\"%s\",quantile=\"%g\"} %lu\n",
+                            t.queue_id, name, q,
+                            to_ns(seg, stage, h.value_at_percentile(q * 100.0)));
+            }
+            std::printf("bbo_rx_latency_ns_count{queue=\"%u\",stage=\"%s\"} %lu\n",
+                        t.queue_id, name, h.count());
+        }
+    }
+    std::fflush(stdout);
+}
+
+void print_usage(const char *prog)
+{
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "Options:\n"
+        "  -s, --shm <name>          Receiver's shared memory name (default: gateway)\n"
+        "  -H, --hugepage-dir <d>    Receiver's hugetlbfs mount, if it uses one\n"
+        "  -i, --interval <seconds>  Refresh interval (default: 1)\n"
+        "  -o, --once                Print one report and exit\n"
+        "  -P, --prometheus          Prometheus text format instead of a report\n"
+        "  -h, --help                Show this help\n"
+        "\n",
+        prog);
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+
+    static struct option long_options[] = {
+        {"shm", required_argument, 0, 's'},
+        {"hugepage-dir", required_argument, 0, 'H'},
+        {"interval", required_argument, 0, 'i'},
+        {"once", no_argument, 0, 'o'},
+        {"prometheus", no_argument, 0, 'P'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}};
+
+    int c;
+    while ((c = getopt_long(argc, argv, "s:H:i:oPh", long_options, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case 's':
+            opt.shm_name = optarg;
+            break;
+        case 'H':
+            opt.hugepage_dir = optarg;
+            break;
+        case 'i':
+            opt.interval_s = std::atof(optarg);
+            if (opt.interval_s <= 0.0)
+            {
+                std::fprintf(stderr, "Error: Invalid interval '%s'\n", optarg);
+                return 1;
+            }
+            break;
+        case 'o':
+            opt.once = true;
+            break;
+        case 'P':
+            opt.prometheus = true;
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    TelemetrySegment *seg = map_segment(opt);
+    if (!seg)
+    {
+        return 1;
+    }
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    Snapshot last[ultra_ll::TELEMETRY_MAX_QUEUES];
+    for (uint16_t i = 0; i < seg->num_queues(); ++i)
+    {
+        last[i] = snapshot(seg->queue(i).stats);
+    }
+    auto last_time = std::chrono::steady_clock::now();
+
+    const auto interval = std::chrono::duration<double>(opt.interval_s);
+    while (!g_stop.load(std::memory_order_relaxed))
+    {
+        if (!opt.once)
+        {
+            std::this_thread::sleep_for(interval);
+            if (g_stop.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - last_time).count();
+        last_time = now;
+
+        if (opt.prometheus)
+        {
+            print_prometheus(*seg);
+        }
+        else
+        {
+            print_human(*seg, last, opt.once ? 0.0 : elapsed);
+        }
+
+        if (opt.once)
+        {
+            break;
+        }
+    }
+    return 0;
+}
@@ -1,9 +1,17 @@
 #include "dpdk_receiver.h"
 #include <rte_bus_pci.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
 #include <rte_log.h>
+#include <rte_pause.h>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <numa.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -11,6 +19,131 @@
 
 namespace ultra_ll {
 
+namespace {
+
+// Synthetic warm-up payloads, one per feed protocol (symbol "WARMUP")
+constexpr char WARMUP_SYMBOL[8] = {'W', 'A', 'R', 'M', 'U', 'P', ' ', ' '};
+constexpr uint16_t WARMUP_LOCATE = 1;
+
+// Per packet: delete the previous packet's two orders, add a bid and an
+// ask one level away from them, execute part of the bid
+constexpr size_t ITCH_WARMUP_SIZE = MOLD_HEADER_SIZE +
+    2 * (2 + itch::ORDER_DELETE_SIZE) + 2 * (2 + itch::ADD_ORDER_SIZE) +
+    (2 + itch::ORDER_EXECUTED_SIZE);
+constexpr size_t SBE_WARMUP_SIZE =
+    SBE_FRAMING_SIZE + SBE_HEADER_SIZE + TopOfBookSchema::Block::LENGTH;
+constexpr size_t BBO_WARMUP_SIZE = 44;  // Full BBO with timestamps
+
+void put_be16(uint8_t* p, uint16_t v) noexcept {
+    const uint16_t be = __builtin_bswap16(v);
+    std::memcpy(p, &be, sizeof(be));
+}
+
+void put_be32(uint8_t* p, uint32_t v) noexcept {
+    const uint32_t be = __builtin_bswap32(v);
+    std::memcpy(p, &be, sizeof(be));
+}
+
+void put_be64(uint8_t* p, uint64_t v) noexcept {
+    const uint64_t be = __builtin_bswap64(v);
+    std::memcpy(p, &be, sizeof(be));
+}
+
+// x86: native order is SBE's little-endian
+template<typename T>
+void put_le(uint8_t* p, T v) noexcept {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+size_t warmup_payload_size(FeedProtocol protocol) noexcept {
+    switch (protocol) {
+    case FeedProtocol::ITCH:
+        return ITCH_WARMUP_SIZE;
+    case FeedProtocol::SBE:
+        return SBE_WARMUP_SIZE;
+    default:
+        return BBO_WARMUP_SIZE;
+    }
+}
+
+// Prices walk over 8 levels so the book inserts and removes levels
+uint32_t warmup_bid(uint64_t seq) noexcept {
+    return 1500000 - static_cast<uint32_t>(seq % 8) * 100;     // $150.00 and below
+}
+uint32_t warmup_ask(uint64_t seq) noexcept {
+    return 1501000 + static_cast<uint32_t>(seq % 8) * 100;     // $150.10 and above
+}
+
+uint8_t* put_itch_message(uint8_t* p, uint8_t type, size_t size, uint64_t order_ref) noexcept {
+    put_be16(p, static_cast<uint16_t>(size));
+    p += 2;
+    p[0] = type;
+    put_be16(p + itch::LOCATE_OFFSET, WARMUP_LOCATE);
+    put_be64(p + itch::ORDER_REF_OFFSET, order_ref);
+    return p;
+}
+
+// MoldUDP64 datagram; the first packet of a queue deletes orders its
+// book never saw (unknown_orders, cleared after warm-up)
+void write_itch_warmup(uint8_t* data, uint64_t seq) noexcept {
+    std::memcpy(data, "WARMUP    ", MOLD_SEQUENCE_OFFSET);
+    put_be64(data + MOLD_SEQUENCE_OFFSET, seq);
+    put_be16(data + MOLD_COUNT_OFFSET, 5);
+
+    uint8_t* p = data + MOLD_HEADER_SIZE;
+    // Order refs 2 * seq + 1 (bid) and 2 * seq + 2 (ask); 0 is never a ref
+    for (uint64_t ref = 2 * seq - 1; ref <= 2 * seq; ++ref) {
+        put_itch_message(p, itch::ORDER_DELETE, itch::ORDER_DELETE_SIZE, ref);
+        p += 2 + itch::ORDER_DELETE_SIZE;
+    }
+    for (uint64_t ref = 2 * seq + 1; ref <= 2 * seq + 2; ++ref) {
+        const bool bid = (ref == 2 * seq + 1);
+        uint8_t* m = put_itch_message(p, itch::ADD_ORDER, itch::ADD_ORDER_SIZE, ref);
+        m[itch::ADD_SIDE_OFFSET] = bid ? 'B' : 'S';
+        put_be32(m + itch::ADD_SHARES_OFFSET, 100);
+        std::memcpy(m + itch::ADD_STOCK_OFFSET, WARMUP_SYMBOL, sizeof(WARMUP_SYMBOL));
+        put_be32(m + itch::ADD_PRICE_OFFSET, bid ? warmup_bid(seq) : warmup_ask(seq));
+        p += 2 + itch::ADD_ORDER_SIZE;
+    }
+    uint8_t* m = put_itch_message(p, itch::ORDER_EXECUTED, itch::ORDER_EXECUTED_SIZE, 2 * seq + 1);
+    put_be32(m + itch::EXEC_SHARES_OFFSET, 10);
+}
+
+// One framed top-of-book message of the compiled schema
+void write_sbe_warmup(uint8_t* data, uint64_t seq) noexcept {
+    using Schema = TopOfBookSchema;
+    using Block = Schema::Block;
+
+    put_le<uint16_t>(data, SBE_WARMUP_SIZE);
+    put_le<uint16_t>(data + 2, 0xEB50);     // Encoding type: SBE 1.0 little-endian
+
+    uint8_t* hdr = data + SBE_FRAMING_SIZE;
+    put_le<uint16_t>(hdr, Block::LENGTH);
+    put_le<uint16_t>(hdr + 2, Schema::TEMPLATE_ID);
+    put_le<uint16_t>(hdr + 4, Schema::SCHEMA_ID);
+    put_le<uint16_t>(hdr + 6, Schema::VERSION);
+
+    uint8_t* block = hdr + SBE_HEADER_SIZE;
+    std::memcpy(block + Block::offset<Schema::SYMBOL>, WARMUP_SYMBOL, sizeof(WARMUP_SYMBOL));
+    put_le<int64_t>(block + Block::offset<Schema::BID_PRICE>, warmup_bid(seq));
+    put_le<uint32_t>(block + Block::offset<Schema::BID_SIZE>, 100);
+    put_le<int64_t>(block + Block::offset<Schema::ASK_PRICE>, warmup_ask(seq));
+    put_le<uint32_t>(block + Block::offset<Schema::ASK_SIZE>, 100);
+}
+
+void write_bbo_warmup(uint8_t* bbo) noexcept {
+    std::memcpy(bbo, WARMUP_SYMBOL, sizeof(WARMUP_SYMBOL));
+
+    // Valid prices (network byte order)
+    put_be32(bbo + 8, 1500000);     // bid_price $150.00
+    put_be32(bbo + 12, 100);        // bid_shares
+    put_be32(bbo + 16, 1500000);    // ask_price
+    put_be32(bbo + 20, 100);        // ask_shares
+    put_be32(bbo + 24, 1000);       // spread $0.10
+}
+
+}  // namespace
+
 DPDKReceiver::DPDKReceiver(const Config& config)
     : config_(config) {
 }
@@ -18,14 +151,56 @@ DPDKReceiver::DPDKReceiver(const Config& config)
 DPDKReceiver::~DPDKReceiver() {
     stop();
 
-    // Disconnect from shared memory
-    if (ring_buffer_) {
-        disruptor::SharedMemoryManager<disruptor::BboRingBuffer>::disconnect(ring_buffer_);
-        ring_buffer_ = nullptr;
+    // Poll loops are done: the writer drains what they published and closes the files
+    journal_.reset();
+    nic_clock_.stop();
+    tsc_sync_.reset();
+
+    // Disconnect from shared memory (queues may share queue 0's ring)
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        disruptor::BboRingBuffer* ring = queues_[i]->ring_buffer;
+        if (ring && (i == 0 || ring != queues_[0]->ring_buffer)) {
+            if (shm_.hugepages()) {
+                unmap_shm_segment(ring, sizeof(disruptor::BboRingBuffer));
+            } else {
+                disruptor::SharedMemoryManager<disruptor::BboRingBuffer>::disconnect(ring);
+            }
+        }
+        queues_[i]->ring_buffer = nullptr;
+
+        BboFastRing* fast = queues_[i]->fast_ring;
+        if (fast && (i == 0 || fast != queues_[0]->fast_ring)) {
+            unmap_shm_segment(fast, sizeof(BboFastRing));
+        }
+
+        // Route rings belong to the queue that owns the router
+        if (PublishRouter* router = queues_[i]->router_storage.get()) {
+            for (uint8_t r = 0; r < router->size(); ++r) {
+                if (router->lane(r).ring) {
+                    unmap_shm_segment(router->lane(r).ring, sizeof(BboFastRing));
+                }
+            }
+        }
+        queues_[i]->router = nullptr;
+    }
+    if (instruments_) {
+        unmap_shm_segment(instruments_, sizeof(InstrumentMap));
+        instruments_ = nullptr;
+    }
+    // Segment stays for a final bbo_stat read; queues fall back to local storage
+    if (telemetry_) {
+        tsc_.set_mirror(nullptr);
+        for (uint16_t i = 0; i < num_queues_; ++i) {
+            queues_[i]->stats = &queues_[i]->stats_storage;
+            queues_[i]->latency = nullptr;
+        }
+        unmap_shm_segment(telemetry_, sizeof(TelemetrySegment));
+        telemetry_ = nullptr;
     }
 
     // Stop and close DPDK port
-    if (dpdk_initialized_) {
+    if (dpdk_initialized_ && has_port()) {
+        flow_rules_.reset();
         rte_eth_dev_stop(config_.port_id);
         rte_eth_dev_close(config_.port_id);
     }
@@ -33,16 +208,66 @@ DPDKReceiver::~DPDKReceiver() {
     // DPDK EAL cleanup happens at process exit
 }
 
+template<typename Fn>
+void DPDKReceiver::dispatch_hot_path(Fn&& fn) const {
+    bool fixed_port = FIXED_UDP_PORT != 0;
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        fixed_port = fixed_port && queues_[i]->udp_port == FIXED_UDP_PORT;
+    }
+    with_hot_path(config_.enable_stats, config_.latency_histograms, config_.fpga_deltas,
+                  config_.publish_mode, fixed_port, std::forward<Fn>(fn));
+}
+
 bool DPDKReceiver::initialize(int argc, char** argv) {
+    // Raw TSC is converted by consumers with the telemetry segment's clock
+    if (config_.raw_tsc && (config_.hw_timestamps || !config_.telemetry)) {
+        std::fprintf(stderr, "Error: Raw TSC timestamps need telemetry and no NIC "
+                     "timestamps (-T)\n");
+        return false;
+    }
+    // Decoded feeds carry no FPGA T1-T4
+    if (config_.fpga_deltas && config_.protocol != FeedProtocol::BBO) {
+        std::fprintf(stderr, "Error: FPGA deltas need the BBO feed (-X bbo)\n");
+        return false;
+    }
+    if (!check_backend()) {
+        return false;
+    }
+
     if (!init_dpdk_eal(argc, argv)) {
         return false;
     }
 
+    // Before the queues: the ITCH / SBE decoders take a pointer to it
+    if (!filter_.load(config_.symbols, numa_node_)) {
+        return false;
+    }
+
+    if (!init_queues()) {
+        return false;
+    }
+
     if (!init_mempool()) {
         return false;
     }
 
-    if (!init_port()) {
+    // Replay and sockets have no port: mbufs come from inject_burst()
+    if (has_port()) {
+        if (!init_port()) {
+            return false;
+        }
+
+        // The AF_XDP vdev has no rte_flow: the kernel steers (ethtool -N)
+        if (config_.backend.backend == RxBackend::DPDK && !init_flow_steering()) {
+            return false;
+        }
+    } else if (!init_tsc_sync()) {
+        return false;
+    } else if (config_.replay) {
+        if (!config_.replay_file.empty() && !init_replay()) {
+            return false;
+        }
+    } else if (!init_sockets()) {
         return false;
     }
 
@@ -50,36 +275,297 @@ bool DPDKReceiver::initialize(int argc, char** argv) {
         return false;
     }
 
+    if (!config_.journal.dir.empty() && !init_journal()) {
+        return false;
+    }
+
+    if (config_.simd_parse) {
+        const SimdIsa detected = BBOParserSimd::detect();
+        simd_isa_ = (detected < config_.max_simd_isa) ? detected : config_.max_simd_isa;
+        parse_burst_ = BBOParserSimd::select(simd_isa_);
+        std::printf("Burst parser: %s (CPU supports %s)\n",
+                    BBOParserSimd::isa_name(simd_isa_),
+                    BBOParserSimd::isa_name(detected));
+    }
+
+    dispatch_hot_path([this](auto path) {
+        using Path = decltype(path);
+        inject_ = &DPDKReceiver::inject_burst_path<Path>;
+        std::printf("Hot path: stats %s, latency %s, FPGA deltas %s, %s publish, UDP port %s\n",
+                    Path::stats ? "on" : "off", Path::latency ? "on" : "off",
+                    Path::fpga ? "on" : "off",
+                    Path::publish == PublishMode::NATIVE ? "native" : "gateway",
+                    Path::udp_port != 0 ? "compiled in" : "per queue");
+    });
+
+    // Last: the telemetry clock mirror is attached, one writer from here on
+    if (tsc_sync_) {
+        tsc_sync_->start();
+    }
+    // Follows the TSC mapping: re-fits on TscSync's interval and core
+    nic_clock_.start(config_.tsc_sync.interval_ms, config_.tsc_sync.step_ns,
+                     config_.tsc_sync.core);
+
     dpdk_initialized_ = true;
     return true;
 }
 
 bool DPDKReceiver::init_dpdk_eal(int argc, char** argv) {
-    int ret = rte_eal_init(argc, argv);
+    const RxBackendConfig& backend = config_.backend;
+
+    // AF_XDP: the kernel keeps the NIC; the vdev opens one XSK per queue
+    // from interface queue queue_id on (busy_budget 0 = interrupt mode)
+    std::vector<char*> args(argv, argv + argc);
+    std::string vdev;
+    if (backend.backend == RxBackend::XDP) {
+        vdev = "--vdev=" + std::string(AF_XDP_VDEV) + ",iface=" + backend.iface +
+               ",start_queue=" + std::to_string(config_.queue_id) +
+               ",queue_count=" + std::to_string(config_.num_queues) +
+               ",busy_budget=" + std::to_string(backend.busy_poll_us > 0 ? config_.burst_size : 0);
+        args.push_back(vdev.data());
+    }
+
+    int ret = rte_eal_init(static_cast<int>(args.size()), args.data());
     if (ret < 0) {
         std::fprintf(stderr, "Error: DPDK EAL initialization failed: %s\n",
                      rte_strerror(rte_errno));
         return false;
     }
 
+    if (backend.backend == RxBackend::XDP) {
+        uint16_t port_id;
+        if (rte_eth_dev_get_port_by_name(AF_XDP_VDEV, &port_id) != 0) {
+            std::fprintf(stderr, "Error: AF_XDP vdev on %s did not probe "
+                         "(net_af_xdp PMD built? interface up?)\n", backend.iface.c_str());
+            return false;
+        }
+        // The vdev's queue 0 is interface queue queue_id
+        config_.port_id = port_id;
+        config_.queue_id = 0;
+    }
+
     // Check if the configured port exists
-    if (!rte_eth_dev_is_valid_port(config_.port_id)) {
+    if (has_port() && !rte_eth_dev_is_valid_port(config_.port_id)) {
         std::fprintf(stderr, "Error: Invalid port ID %u\n", config_.port_id);
         return false;
     }
 
-    std::printf("DPDK EAL initialized, using port %u\n", config_.port_id);
+    // Allocate next to the NIC: the vdev and sockets only know it by name
+    if (!backend.iface.empty()) {
+        numa_node_ = iface_numa_node(backend.iface);
+    } else {
+        numa_node_ = has_port() ? rte_eth_dev_socket_id(config_.port_id)
+                                : static_cast<int>(rte_socket_id());
+    }
+    if (numa_node_ < 0) {
+        numa_node_ = NUMA_NODE_ANY;
+    }
+
+    if (config_.replay) {
+        std::printf("DPDK EAL initialized, replay mode (no port)\n");
+    } else if (backend.backend == RxBackend::SOCKET) {
+        std::printf("DPDK EAL initialized, UDP sockets%s%s (SO_BUSY_POLL %u, NUMA node %d)\n",
+                    backend.iface.empty() ? "" : " on ", backend.iface.c_str(),
+                    backend.busy_poll_us, numa_node_);
+    } else if (backend.backend == RxBackend::XDP) {
+        std::printf("DPDK EAL initialized, AF_XDP on %s as port %u (NUMA node %d)\n",
+                    backend.iface.c_str(), config_.port_id, numa_node_);
+    } else {
+        std::printf("DPDK EAL initialized, using port %u (NUMA node %d)\n",
+                    config_.port_id, numa_node_);
+    }
+    return true;
+}
+
+bool DPDKReceiver::check_backend() const {
+    const RxBackend backend = config_.backend.backend;
+    if (backend == RxBackend::DPDK) {
+        return true;
+    }
+    const char* name = rx_backend_name(backend);
+
+    if (config_.replay) {
+        std::fprintf(stderr, "Error: Replay feeds the pipeline itself (no -d %s)\n", name);
+        return false;
+    }
+    if (backend == RxBackend::XDP && config_.backend.iface.empty()) {
+        std::fprintf(stderr, "Error: AF_XDP needs the kernel interface (-i)\n");
+        return false;
+    }
+    // Offloads only an ethdev on the bare NIC has
+    if (config_.hw_filter || config_.flow_mark || config_.hw_timestamps) {
+        std::fprintf(stderr, "Error: The %s backend has no rte_flow or RX timestamps "
+                     "(no -F, -M, -T)\n", name);
+        return false;
+    }
+    if (backend == RxBackend::SOCKET && config_.ab_arbitration) {
+        std::fprintf(stderr, "Error: A/B arbitration polls two ethdev queues "
+                     "(not with -d socket)\n");
+        return false;
+    }
+    if (backend == RxBackend::SOCKET && config_.idle.spin_polls > 0) {
+        std::fprintf(stderr, "Warning: Idle backoff is ignored with sockets "
+                     "(the loop polls through recvmmsg())\n");
+    }
+    return true;
+}
+
+bool DPDKReceiver::init_sockets() {
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        RxQueue& q = *queues_[i];
+        q.socket = std::make_unique<SocketRx>();
+        if (!q.socket->open(config_.backend, q.udp_port, config_.mcast_groups,
+                            config_.num_mcast_groups, mbuf_pool_)) {
+            return false;
+        }
+    }
+    std::printf("UDP sockets: %u on port %u, recvmmsg() burst %u\n",
+                num_queues_, queues_[0]->udp_port, config_.burst_size);
+    return true;
+}
+
+bool DPDKReceiver::init_queues() {
+    if (config_.num_queues == 0 || config_.num_queues > MAX_RX_QUEUES) {
+        std::fprintf(stderr, "Error: num_queues must be 1..%u (got %u)\n",
+                     MAX_RX_QUEUES, config_.num_queues);
+        return false;
+    }
+
+    if (config_.ab_arbitration) {
+        if (config_.num_queues != 2) {
+            std::fprintf(stderr, "Error: A/B arbitration needs exactly 2 queues (got %u)\n",
+                         config_.num_queues);
+            return false;
+        }
+        config_.wire_seq = true;
+    }
+
+    if (!is_supported_burst(config_.burst_size)) {
+        std::fprintf(stderr, "Error: Burst size %u unsupported (power of 2, 1..%u)\n",
+                     config_.burst_size, MAX_BURST_SIZE);
+        return false;
+    }
+    // rte_mempool limits: per-lcore cache <= CACHE_MAX and <= pool / 1.5
+    if (config_.mbuf_cache_size > RTE_MEMPOOL_CACHE_MAX_SIZE ||
+        config_.mbuf_cache_size * 3ULL > config_.mbuf_pool_size * 2ULL) {
+        std::fprintf(stderr, "Error: mbuf cache %u too large for a pool of %u (max %u)\n",
+                     config_.mbuf_cache_size, config_.mbuf_pool_size,
+                     RTE_MEMPOOL_CACHE_MAX_SIZE);
+        return false;
+    }
+
+    const unsigned lcores_needed = config_.ab_arbitration ? 1 : config_.num_queues;
+    if (lcores_needed > rte_lcore_count()) {
+        std::fprintf(stderr, "Error: %u RX queues need %u lcores, EAL has %u (-l option)\n",
+                     config_.num_queues, lcores_needed, rte_lcore_count());
+        return false;
+    }
+
+    // Queue 0 polls on the main lcore, queue N on the N-th worker lcore
+    // (A/B: both lines on the main lcore)
+    unsigned lcore = rte_get_main_lcore();
+    for (uint16_t i = 0; i < config_.num_queues; ++i) {
+        if (i > 0 && !config_.ab_arbitration) {
+            lcore = rte_get_next_lcore(lcore, 1, 0);
+        }
+
+        auto q = std::make_unique<RxQueue>(numa_node_);
+        q->owner = this;
+        q->queue_id = static_cast<uint16_t>(config_.queue_id + i);
+        q->lcore_id = lcore;
+        q->udp_port = config_.udp_port;
+        if (config_.steering == SteeringMode::UDP_PORT && config_.queue_udp_ports[i] != 0) {
+            q->udp_port = config_.queue_udp_ports[i];
+        }
+        // A/B lines publish to one ring: one backlog keeps per-symbol order
+        if (config_.conflate && config_.ab_arbitration && i > 0) {
+            q->conflation = queues_[0]->conflation;
+        } else if (config_.conflate) {
+            q->conflation_storage = std::make_unique<DefaultConflationCache>(numa_node_);
+            q->conflation = q->conflation_storage.get();
+        }
+        // A/B lines carry one order flow: the arbiter hands each packet to
+        // one line only, so both must apply it to queue 0's book
+        if (config_.ab_arbitration && i > 0) {
+            q->itch = queues_[0]->itch;
+            q->sbe = queues_[0]->sbe;
+        } else if (config_.protocol == FeedProtocol::ITCH) {
+            q->itch_storage = std::make_unique<ItchBookBuilder>(numa_node_, config_.msg_prefetch);
+            q->itch_storage->set_filter(filter_.enabled() ? &filter_ : nullptr);
+            q->itch = q->itch_storage.get();
+        } else if (config_.protocol == FeedProtocol::SBE) {
+            q->sbe_storage = std::make_unique<SbeDecoder>();
+            q->sbe_storage->set_filter(filter_.enabled() ? &filter_ : nullptr);
+            q->sbe = q->sbe_storage.get();
+        }
+        // fpga_deltas records the FPGA stages without the host ones
+        if (config_.latency_histograms || config_.fpga_deltas) {
+            q->latency_storage = std::make_unique<LatencyRecorder>();
+            q->latency = q->latency_storage.get();
+        }
+        if (config_.wire_seq) {
+            // A/B lines arbitrate against queue 0's window
+            if (config_.ab_arbitration && i > 0) {
+                q->arbiter = queues_[0]->arbiter;
+            } else {
+                q->arbiter_storage = std::make_unique<FeedArbiter>();
+                q->arbiter = q->arbiter_storage.get();
+            }
+        }
+        queues_[i] = std::move(q);
+    }
+    num_queues_ = config_.num_queues;
+
+    // Both rings are single-producer: every poll lcore needs its own
+    // (A/B lines share one lcore, so they share queue 0's ring)
+    if (num_queues_ > 1 && !config_.ring_per_queue && !config_.ab_arbitration) {
+        std::fprintf(stderr, "Error: %u poll lcores cannot share ring '%s', it has "
+                     "a single producer (drop -R)\n", num_queues_, config_.shm_name.c_str());
+        return false;
+    }
+
+    check_numa_placement();
     return true;
 }
 
+void DPDKReceiver::check_numa_placement() const {
+    if (numa_node_ == NUMA_NODE_ANY) {
+        return;  // Single node, or the PMD does not know
+    }
+
+    // Every cross-node hop on the hot path is a remote cache line transfer
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        const RxQueue& q = *queues_[i];
+        const int lcore_node = static_cast<int>(rte_lcore_to_socket_id(q.lcore_id));
+        if (lcore_node != numa_node_) {
+            std::fprintf(stderr, "Warning: Queue %u polls on lcore %u (node %d), "
+                         "NIC is on node %d\n",
+                         q.queue_id, q.lcore_id, lcore_node, numa_node_);
+        }
+        if (q.bbo_pool.numa_node() != numa_node_) {
+            std::fprintf(stderr, "Warning: Queue %u BBO pool landed on node %d, wanted %d\n",
+                         q.queue_id, q.bbo_pool.numa_node(), numa_node_);
+        }
+    }
+
+    if (config_.consumer_core >= 0) {
+        const int consumer_node = numa_node_of_cpu(config_.consumer_core);
+        if (consumer_node >= 0 && consumer_node != numa_node_) {
+            std::fprintf(stderr, "Warning: Consumer core %d is on node %d, "
+                         "NIC and ring are on node %d\n",
+                         config_.consumer_core, consumer_node, numa_node_);
+        }
+    }
+}
+
 bool DPDKReceiver::init_mempool() {
     mbuf_pool_ = rte_pktmbuf_pool_create(
         "MBUF_POOL",
-        MBUF_POOL_SIZE,
-        MBUF_CACHE_SIZE,
+        config_.mbuf_pool_size,
+        config_.mbuf_cache_size,
         0,
         RTE_MBUF_DEFAULT_BUF_SIZE,
-        rte_socket_id()
+        numa_node_ != NUMA_NODE_ANY ? numa_node_ : static_cast<int>(rte_socket_id())
     );
 
     if (!mbuf_pool_) {
@@ -88,7 +574,8 @@ bool DPDKReceiver::init_mempool() {
         return false;
     }
 
-    std::printf("Created mbuf pool with %u mbufs\n", MBUF_POOL_SIZE);
+    std::printf("Created mbuf pool with %u mbufs (cache %u)\n",
+                config_.mbuf_pool_size, config_.mbuf_cache_size);
     return true;
 }
 
@@ -106,39 +593,115 @@ bool DPDKReceiver::init_port() {
 
     std::printf("Port %u: %s\n", config_.port_id, dev_info.driver_name);
 
+    const uint16_t nb_rx_queues = static_cast<uint16_t>(config_.queue_id + num_queues_);
+    if (nb_rx_queues > dev_info.max_rx_queues) {
+        std::fprintf(stderr, "Error: Port %u supports %u RX queues, %u requested\n",
+                     config_.port_id, dev_info.max_rx_queues, nb_rx_queues);
+        return false;
+    }
+
     // Configure port
     rte_eth_conf port_conf{};
     port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_NONE;
 
+    // RSS spreads feeds by IPv4/UDP hash; UDP_PORT steering uses rte_flow
+    // rules installed after start, so the queues only need to exist.
+    // AF_XDP: each XSK is bound to one interface queue, the NIC's own RSS
+    // (ethtool -X / -N) already decided what lands there
+    const bool af_xdp = config_.backend.backend == RxBackend::XDP;
+    if (num_queues_ > 1 && config_.steering == SteeringMode::RSS && !af_xdp) {
+        port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+        port_conf.rx_adv_conf.rss_conf.rss_key = nullptr;  // PMD default key
+        port_conf.rx_adv_conf.rss_conf.rss_hf =
+            (RTE_ETH_RSS_IP | RTE_ETH_RSS_UDP) & dev_info.flow_type_rss_offloads;
+
+        if (port_conf.rx_adv_conf.rss_conf.rss_hf == 0) {
+            std::fprintf(stderr, "Error: Port %u does not support IPv4/UDP RSS\n",
+                         config_.port_id);
+            return false;
+        }
+    }
+
     // Disable checksum offloads for lower latency
     port_conf.rxmode.offloads = 0;
 
-    ret = rte_eth_dev_configure(config_.port_id, 1, 0, &port_conf);
+    // Wire timestamps are the one offload worth its cost
+    if (config_.hw_timestamps) {
+        if (dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_TIMESTAMP) {
+            port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_TIMESTAMP;
+        } else {
+            std::fprintf(stderr, "Warning: Port %u has no RX timestamp offload, using TSC\n",
+                         config_.port_id);
+            config_.hw_timestamps = false;
+        }
+    }
+
+    // Flow mark delivery must be negotiated before configure
+    if (config_.flow_mark) {
+        uint64_t features = RTE_ETH_RX_METADATA_USER_MARK;
+        ret = rte_eth_rx_metadata_negotiate(config_.port_id, &features);
+        if (ret == 0 && !(features & RTE_ETH_RX_METADATA_USER_MARK)) {
+            std::fprintf(stderr, "Warning: Port %u does not deliver flow marks\n",
+                         config_.port_id);
+            config_.flow_mark = false;
+        }
+        // -ENOTSUP: PMD predates negotiation, marks are delivered unconditionally
+    }
+
+    ret = rte_eth_dev_configure(config_.port_id, nb_rx_queues, 0, &port_conf);
     if (ret < 0) {
         std::fprintf(stderr, "Error: Failed to configure port %u: %s\n",
                      config_.port_id, rte_strerror(-ret));
         return false;
     }
 
-    // Setup RX queue
-    rte_eth_rxconf rxconf = dev_info.default_rxconf;
-    rxconf.offloads = 0;  // Disable offloads for lower latency
-
-    ret = rte_eth_rx_queue_setup(
-        config_.port_id,
-        config_.queue_id,
-        RX_RING_SIZE,
-        rte_eth_dev_socket_id(config_.port_id),
-        &rxconf,
-        mbuf_pool_
-    );
+    // Clamp the ring to the PMD's descriptor limits (min, max, alignment)
+    uint16_t nb_rxd = config_.rx_ring_size;
+    ret = rte_eth_dev_adjust_nb_rx_tx_desc(config_.port_id, &nb_rxd, nullptr);
+    if (ret != 0) {
+        std::fprintf(stderr, "Error: Port %u rejects %u RX descriptors: %s\n",
+                     config_.port_id, config_.rx_ring_size, rte_strerror(-ret));
+        return false;
+    }
+    if (nb_rxd != config_.rx_ring_size) {
+        std::fprintf(stderr, "Warning: Port %u RX ring adjusted from %u to %u descriptors\n",
+                     config_.port_id, config_.rx_ring_size, nb_rxd);
+        config_.rx_ring_size = nb_rxd;
+    }
 
-    if (ret < 0) {
-        std::fprintf(stderr, "Error: Failed to setup RX queue: %s\n",
-                     rte_strerror(-ret));
+    // Every descriptor holds an mbuf: the pool must cover all rings plus
+    // the bursts and per-lcore caches in flight
+    const uint64_t mbufs_needed = static_cast<uint64_t>(nb_rx_queues) * nb_rxd +
+        static_cast<uint64_t>(num_queues_) * (config_.burst_size + config_.mbuf_cache_size);
+    if (mbufs_needed > config_.mbuf_pool_size) {
+        std::fprintf(stderr, "Error: %u mbufs cannot fill %u RX queues x %u descriptors "
+                     "(need >= %lu, -m option)\n", config_.mbuf_pool_size, nb_rx_queues,
+                     nb_rxd, mbufs_needed);
         return false;
     }
 
+    // Setup RX queues
+    rte_eth_rxconf rxconf = dev_info.default_rxconf;
+    rxconf.offloads = port_conf.rxmode.offloads;  // Only the timestamp, if enabled
+
+    // Queues below config_.queue_id are unused but must exist on the port
+    for (uint16_t qid = 0; qid < nb_rx_queues; ++qid) {
+        ret = rte_eth_rx_queue_setup(
+            config_.port_id,
+            qid,
+            nb_rxd,
+            rte_eth_dev_socket_id(config_.port_id),
+            &rxconf,
+            mbuf_pool_
+        );
+
+        if (ret < 0) {
+            std::fprintf(stderr, "Error: Failed to setup RX queue %u: %s\n",
+                         qid, rte_strerror(-ret));
+            return false;
+        }
+    }
+
     // Start port
     ret = rte_eth_dev_start(config_.port_id);
     if (ret < 0) {
@@ -147,10 +710,49 @@ bool DPDKReceiver::init_port() {
         return false;
     }
 
-    // Enable promiscuous mode
-    ret = rte_eth_promiscuous_enable(config_.port_id);
-    if (ret != 0) {
-        std::fprintf(stderr, "Warning: Failed to enable promiscuous mode\n");
+    // The PMD's default table spreads over every configured queue, which
+    // includes the unpolled ones below queue_id
+    if (port_conf.rxmode.mq_mode == RTE_ETH_MQ_RX_RSS && config_.queue_id > 0 &&
+        !init_reta(dev_info.reta_size)) {
+        return false;
+    }
+
+    // PHC is readable now; the first fit may step the epoch, so before the
+    // device clock is correlated against it
+    if (!init_tsc_sync()) {
+        return false;
+    }
+
+    // Correlate the device clock with TSC now that it is running
+    if (config_.hw_timestamps && !nic_clock_.init(config_.port_id, tsc_)) {
+        std::fprintf(stderr, "Warning: Port %u RX timestamps unusable, using TSC\n",
+                     config_.port_id);
+        config_.hw_timestamps = false;
+    }
+
+    if (config_.hw_filter) {
+        // Accept only our multicast groups at the MAC filter (all groups if none given)
+        ret = -ENOTSUP;
+        if (config_.num_mcast_groups > 0) {
+            rte_ether_addr mc_addrs[MAX_MCAST_GROUPS];
+            for (uint8_t g = 0; g < config_.num_mcast_groups; ++g) {
+                mc_addrs[g] = mcast_group_to_mac(config_.mcast_groups[g]);
+            }
+            ret = rte_eth_dev_set_mc_addr_list(config_.port_id, mc_addrs,
+                                               config_.num_mcast_groups);
+        }
+        if (ret != 0) {
+            ret = rte_eth_allmulticast_enable(config_.port_id);
+            if (ret != 0) {
+                std::fprintf(stderr, "Warning: Failed to enable all-multicast mode\n");
+            }
+        }
+    } else {
+        // Enable promiscuous mode
+        ret = rte_eth_promiscuous_enable(config_.port_id);
+        if (ret != 0) {
+            std::fprintf(stderr, "Warning: Failed to enable promiscuous mode\n");
+        }
     }
 
     // Print link status
@@ -169,85 +771,808 @@ bool DPDKReceiver::init_port() {
     return true;
 }
 
+bool DPDKReceiver::init_reta(uint16_t reta_size) {
+    constexpr uint16_t MAX_RETA_GROUPS = 512 / RTE_ETH_RETA_GROUP_SIZE;  // RTE_ETH_RSS_RETA_SIZE_512
+    rte_eth_rss_reta_entry64 reta[MAX_RETA_GROUPS] = {};
+
+    int ret = -ENOTSUP;
+    if (reta_size > 0 && reta_size <= MAX_RETA_GROUPS * RTE_ETH_RETA_GROUP_SIZE) {
+        for (uint16_t i = 0; i < reta_size; ++i) {
+            rte_eth_rss_reta_entry64& group = reta[i / RTE_ETH_RETA_GROUP_SIZE];
+            group.mask |= 1ULL << (i % RTE_ETH_RETA_GROUP_SIZE);
+            group.reta[i % RTE_ETH_RETA_GROUP_SIZE] =
+                static_cast<uint16_t>(config_.queue_id + i % num_queues_);
+        }
+        ret = rte_eth_dev_rss_reta_update(config_.port_id, reta, reta_size);
+    }
+    if (ret == 0) {
+        std::printf("Port %u: RSS table (%u entries) over queues %u..%u\n", config_.port_id,
+                    reta_size, config_.queue_id, config_.queue_id + num_queues_ - 1);
+        return true;
+    }
+
+    // -F / -M install an RSS action over exactly our queues instead
+    if (config_.hw_filter || config_.flow_mark) {
+        std::fprintf(stderr, "Warning: Port %u RSS table not updated (%s), relying on "
+                     "the flow rule's queue set\n", config_.port_id, rte_strerror(-ret));
+        return true;
+    }
+    std::fprintf(stderr, "Error: Port %u cannot limit RSS to queues %u..%u (%s): "
+                 "queues below -q would take part of the feed (use -q 0, -F or -S port)\n",
+                 config_.port_id, config_.queue_id, config_.queue_id + num_queues_ - 1,
+                 rte_strerror(-ret));
+    return false;
+}
+
+bool DPDKReceiver::init_flow_steering() {
+    const bool steer_ports = num_queues_ > 1 && config_.steering == SteeringMode::UDP_PORT;
+    if (!steer_ports && !config_.hw_filter && !config_.flow_mark) {
+        return true;
+    }
+
+    flow_rules_ = std::make_unique<FlowRules>(config_.port_id);
+
+    bool installed = install_flow_rules(config_.flow_mark);
+    if (!installed && config_.flow_mark) {
+        std::fprintf(stderr, "Warning: Port %u cannot mark flows, using header checks\n",
+                     config_.port_id);
+        config_.flow_mark = false;
+        flow_rules_->clear();
+        installed = install_flow_rules(false);
+    }
+
+    if (!installed) {
+        flow_rules_->clear();
+        if (steer_ports) {
+            std::fprintf(stderr, "Error: Failed to install UDP port steering rules\n");
+            return false;
+        }
+        std::fprintf(stderr, "Warning: Port %u has no flow filtering, filtering in software\n",
+                     config_.port_id);
+        return true;
+    }
+
+    // Everything not matched above is dropped in the NIC
+    if (config_.hw_filter) {
+        if (flow_rules_->add_drop_all()) {
+            std::printf("Flow rule: drop unmatched traffic\n");
+        } else {
+            std::fprintf(stderr, "Warning: Port %u cannot drop unmatched traffic, "
+                         "filtering in software\n", config_.port_id);
+        }
+    }
+
+    std::printf("Flow rules: %zu installed%s\n", flow_rules_->size(),
+                config_.flow_mark ? " (marked)" : "");
+    return true;
+}
+
+bool DPDKReceiver::install_flow_rules(bool mark) {
+    const bool rss = num_queues_ > 1 && config_.steering == SteeringMode::RSS;
+    const uint8_t nb_groups = config_.num_mcast_groups ? config_.num_mcast_groups : 1;
+
+    uint16_t rss_queues[MAX_RX_QUEUES];
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        rss_queues[i] = queues_[i]->queue_id;
+    }
+
+    // One rule per (group, queue port); group 0 = any destination
+    for (uint8_t g = 0; g < nb_groups; ++g) {
+        const uint32_t group = config_.num_mcast_groups ? config_.mcast_groups[g] : 0;
+        char group_str[INET_ADDRSTRLEN] = "any";
+        if (group != 0) {
+            inet_ntop(AF_INET, &group, group_str, sizeof(group_str));
+        }
+
+        if (rss) {
+            if (!flow_rules_->add_rss_rule(config_.udp_port, group,
+                                           rss_queues, num_queues_, mark)) {
+                return false;
+            }
+            std::printf("Flow rule: %s UDP port %u -> RSS over %u queues\n",
+                        group_str, config_.udp_port, num_queues_);
+            continue;
+        }
+
+        for (uint16_t i = 0; i < num_queues_; ++i) {
+            const RxQueue& q = *queues_[i];
+            if (!flow_rules_->add_queue_rule(q.udp_port, group, q.queue_id, mark)) {
+                return false;
+            }
+            std::printf("Flow rule: %s UDP port %u -> queue %u\n",
+                        group_str, q.udp_port, q.queue_id);
+        }
+    }
+
+    return true;
+}
+
 bool DPDKReceiver::init_shared_memory() {
-    const std::string shm_name = "/bbo_ring_" + config_.shm_name;
-    constexpr size_t shm_size = sizeof(disruptor::BboRingBuffer);
+    const bool native = (config_.publish_mode == PublishMode::NATIVE);
+
+    // BboRingBuffer only offers per-BBO try_publish - nothing to batch
+    if (config_.batch_publish && !native) {
+        std::fprintf(stderr, "Warning: batched publish needs native mode (-N), disabled\n");
+        config_.batch_publish = false;
+    }
+
+    if (!shm_.init(config_.hugepage_dir)) {
+        return false;
+    }
+
+    // Before the rings: a failure leaves Stats in process memory, not fatal
+    if (config_.enable_stats && config_.telemetry) {
+        telemetry_ = open_telemetry(config_.shm_name);
+        if (telemetry_) {
+            attach_telemetry();
+        } else {
+            std::fprintf(stderr, "Warning: telemetry segment unavailable, stats are in-process only\n");
+        }
+    }
+
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (i > 0 && (!config_.ring_per_queue || config_.ab_arbitration)) {
+            queues_[i]->ring_buffer = queues_[0]->ring_buffer;
+            queues_[i]->fast_ring = queues_[0]->fast_ring;
+            continue;
+        }
+
+        const std::string name = (i == 0)
+            ? config_.shm_name
+            : config_.shm_name + "_q" + std::to_string(i);
+
+        if (native) {
+            queues_[i]->fast_ring = open_fast_ring(name);
+            if (!queues_[i]->fast_ring) {
+                return false;
+            }
+        } else {
+            queues_[i]->ring_buffer = open_ring(name);
+            if (!queues_[i]->ring_buffer) {
+                return false;
+            }
+        }
+    }
+
+    // Routing is keyed by instrument ID: routes imply -j dynamic
+    if (!config_.routes.empty()) {
+        if (!native) {
+            std::fprintf(stderr, "Error: publish routes need native mode (-N)\n");
+            return false;
+        }
+        if (config_.instruments.empty()) {
+            config_.instruments = "dynamic";
+        }
+    }
+
+    // One ID space for all queues; gateway::BBOData has no field for it
+    if (!config_.instruments.empty()) {
+        if (!native) {
+            std::fprintf(stderr, "Warning: instrument IDs need native mode (-N), disabled\n");
+            return true;
+        }
+        std::vector<uint64_t> reference;
+        if (config_.instruments != "dynamic" &&
+            !parse_symbol_spec(config_.instruments, reference)) {
+            return false;
+        }
+        instruments_ = open_instrument_map(config_.shm_name);
+        if (!instruments_) {
+            return false;
+        }
+        // Reference symbols take the low IDs (no-op for IDs already mapped)
+        for (uint64_t key : reference) {
+            instruments_->intern_key(key);
+        }
+        std::printf("Instrument IDs: %u assigned (%zu from reference, capacity %zu)\n",
+                    instruments_->size(), reference.size(), InstrumentMap::capacity() - 1);
+    }
+
+    return config_.routes.empty() || init_routes();
+}
+
+bool DPDKReceiver::init_routes() {
+    for (size_t i = 0; i < config_.routes.size(); ++i) {
+        const std::string& name = config_.routes[i].name;
+        bool clash = (name == config_.shm_name);
+        for (size_t j = 0; j < i; ++j) {
+            clash |= (name == config_.routes[j].name);
+        }
+        if (clash) {
+            std::fprintf(stderr, "Error: Route name '%s' is already in use\n", name.c_str());
+            return false;
+        }
+    }
+
+    routes_ = std::make_unique<RouteTable>();
+    if (!routes_->init(config_.routes, numa_node_)) {
+        return false;
+    }
+
+    // Same ring naming as the primary: "<route>" for queue 0, "<route>_q<N>"
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (i > 0 && config_.ab_arbitration) {
+            queues_[i]->router = queues_[0]->router;
+            continue;
+        }
+        // Owned before any ring opens: the destructor unmaps attached rings
+        queues_[i]->router_storage = std::make_unique<PublishRouter>(*routes_, numa_node_);
+        PublishRouter& router = *queues_[i]->router_storage;
+        for (uint8_t r = 0; r < routes_->size(); ++r) {
+            const std::string name = (i == 0)
+                ? config_.routes[r].name
+                : config_.routes[r].name + "_q" + std::to_string(i);
+            BboFastRing* ring = open_fast_ring(name);
+            if (!ring) {
+                return false;
+            }
+            router.attach(r, ring);
+        }
+        queues_[i]->router = &router;
+    }
+
+    for (uint8_t r = 0; r < routes_->size(); ++r) {
+        const RouteConfig& route = routes_->route(r);
+        std::printf("Route '%s': %s, %s\n", route.name.c_str(), route_policy_name(route.policy),
+                    route.symbols.empty() ? "all symbols" : route.symbols.c_str());
+    }
+    return true;
+}
+
+void* DPDKReceiver::map_shm_segment(const std::string& shm_name, size_t size,
+                                    bool& created) {
     int fd = -1;
     void* ptr = MAP_FAILED;
+    created = false;
+    const size_t bytes = shm_.round(size);
 
     // Try to open existing shared memory first (created by Project 14)
-    fd = shm_open(shm_name.c_str(), O_RDWR, 0666);
+    fd = shm_.open(shm_name, O_RDWR);
     if (fd != -1) {
-        ptr = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
         ::close(fd);
 
         if (ptr != MAP_FAILED) {
-            ring_buffer_ = static_cast<disruptor::BboRingBuffer*>(ptr);
-            std::printf("Connected to existing shared memory '%s'\n",
-                        config_.shm_name.c_str());
-            return true;
+            // Pages already belong to whoever created the segment
+            const int node = numa_node_of(ptr);
+            if (numa_node_ != NUMA_NODE_ANY && node >= 0 && node != numa_node_) {
+                std::fprintf(stderr, "Warning: Shared memory '%s' is on node %d, "
+                             "NIC is on node %d (recreate it from this side)\n",
+                             shm_name.c_str(), node, numa_node_);
+            }
+            if (!ShmBacking::prefault_and_lock(ptr, bytes, shm_.page_size(), false)) {
+                std::fprintf(stderr, "Warning: mlock of '%s' failed: %s\n",
+                             shm_name.c_str(), std::strerror(errno));
+            }
+            return ptr;
         }
         // mmap failed, fall through to create
     }
 
     // Create new shared memory
-    shm_unlink(shm_name.c_str());  // Remove any stale instance
+    shm_.unlink(shm_name);  // Remove any stale instance
 
-    fd = shm_open(shm_name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0666);
+    fd = shm_.open(shm_name, O_CREAT | O_RDWR | O_EXCL);
     if (fd == -1) {
         std::fprintf(stderr, "Error: Failed to create shared memory '%s': %s\n",
-                     shm_name.c_str(), std::strerror(errno));
-        return false;
+                     shm_.path(shm_name).c_str(), std::strerror(errno));
+        return nullptr;
     }
 
-    if (ftruncate(fd, shm_size) == -1) {
+    if (ftruncate(fd, bytes) == -1) {
         std::fprintf(stderr, "Error: Failed to set shared memory size: %s\n",
                      std::strerror(errno));
         ::close(fd);
-        shm_unlink(shm_name.c_str());
-        return false;
+        shm_.unlink(shm_name);
+        return nullptr;
     }
 
-    ptr = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     ::close(fd);
 
     if (ptr == MAP_FAILED) {
         std::fprintf(stderr, "Error: Failed to map shared memory: %s\n",
                      std::strerror(errno));
-        shm_unlink(shm_name.c_str());
-        return false;
+        shm_.unlink(shm_name);
+        return nullptr;
+    }
+
+    // Shared policy on the shm object: pages fault in on the NIC's node
+    if (!numa_prefer(ptr, bytes, numa_node_)) {
+        std::fprintf(stderr, "Warning: mbind of '%s' to node %d failed: %s\n",
+                     shm_name.c_str(), numa_node_, std::strerror(errno));
+    }
+
+    // Fault every page in now, not on the first pass through the ring
+    if (!ShmBacking::prefault_and_lock(ptr, bytes, shm_.page_size(), true)) {
+        std::fprintf(stderr, "Warning: mlock of '%s' failed: %s\n",
+                     shm_name.c_str(), std::strerror(errno));
+    }
+
+    created = true;
+    return ptr;
+}
+
+void DPDKReceiver::unmap_shm_segment(void* ptr, size_t size) const {
+    // hugetlbfs only unmaps whole pages
+    munmap(ptr, shm_.round(size));
+}
+
+disruptor::BboRingBuffer* DPDKReceiver::open_ring(const std::string& name) {
+    bool created = false;
+    void* ptr = map_shm_segment("/bbo_ring_" + name, sizeof(disruptor::BboRingBuffer),
+                                created);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    if (!created) {
+        std::printf("Connected to existing shared memory '%s'\n", name.c_str());
+        return static_cast<disruptor::BboRingBuffer*>(ptr);
     }
 
     // Placement new to initialize the ring buffer
-    ring_buffer_ = new (ptr) disruptor::BboRingBuffer();
-    std::printf("Created new shared memory '%s'\n", config_.shm_name.c_str());
+    std::printf("Created new shared memory '%s'\n", name.c_str());
+    return new (ptr) disruptor::BboRingBuffer();
+}
 
-    return true;
+bool DPDKReceiver::init_journal() {
+    journal_ = std::make_unique<JournalWriter>(config_.journal, config_.shm_name, tsc_.get_ghz());
+
+    // One ring per poll lcore (A/B lines share queue 0's)
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (i > 0 && config_.ab_arbitration) {
+            queues_[i]->journal = queues_[0]->journal;
+            continue;
+        }
+        queues_[i]->journal_storage = std::make_unique<DefaultJournalRing>(numa_node_);
+        queues_[i]->journal = queues_[i]->journal_storage.get();
+        journal_->add_queue(queues_[i]->queue_id, queues_[i]->journal);
+    }
+    return journal_->start();
+}
+
+BboFastRing* DPDKReceiver::open_fast_ring(const std::string& name) {
+    const std::string shm_name = "/bbo_fast_" + name;
+    bool created = false;
+    void* ptr = map_shm_segment(shm_name, sizeof(BboFastRing), created);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    if (!created) {
+        auto* ring = static_cast<BboFastRing*>(ptr);
+        if (ring->is_valid()) {
+            std::printf("Connected to existing native ring '%s'\n", name.c_str());
+            return ring;
+        }
+
+        // Layout mismatch (older build or different capacity) - recreate
+        unmap_shm_segment(ptr, sizeof(BboFastRing));
+        shm_.unlink(shm_name);
+        ptr = map_shm_segment(shm_name, sizeof(BboFastRing), created);
+        if (!ptr) {
+            return nullptr;
+        }
+    }
+
+    std::printf("Created new native ring '%s' (%zu x %zu bytes)\n",
+                name.c_str(), BboFastRing::capacity(), sizeof(BBODataFast));
+    return new (ptr) BboFastRing();
+}
+
+InstrumentMap* DPDKReceiver::open_instrument_map(const std::string& name) {
+    const std::string shm_name = "/bbo_instruments_" + name;
+    bool created = false;
+    void* ptr = map_shm_segment(shm_name, sizeof(InstrumentMap), created);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    if (!created) {
+        auto* map = static_cast<InstrumentMap*>(ptr);
+        if (map->is_valid()) {
+            std::printf("Connected to existing instrument map '%s' (%u IDs)\n",
+                        name.c_str(), map->size());
+            return map;
+        }
+
+        // Layout mismatch (older build or different capacity) - recreate
+        unmap_shm_segment(ptr, sizeof(InstrumentMap));
+        shm_.unlink(shm_name);
+        ptr = map_shm_segment(shm_name, sizeof(InstrumentMap), created);
+        if (!ptr) {
+            return nullptr;
+        }
+    }
+
+    std::printf("Created new instrument map '%s' (%zu IDs)\n",
+                name.c_str(), InstrumentMap::capacity() - 1);
+    return new (ptr) InstrumentMap();
+}
+
+TelemetrySegment* DPDKReceiver::open_telemetry(const std::string& name) {
+    const std::string shm_name = "/bbo_telemetry_" + name;
+    bool created = false;
+    void* ptr = map_shm_segment(shm_name, sizeof(TelemetrySegment), created);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    // Counters describe this run: start from zero even when the segment
+    // survived a previous receiver (readers re-check is_valid())
+    std::printf("%s telemetry segment '%s' (%zu KB)\n", created ? "Created" : "Reset",
+                shm_name.c_str(), sizeof(TelemetrySegment) / 1024);
+    std::memset(ptr, 0, sizeof(TelemetrySegment));
+    return new (ptr) TelemetrySegment();
+}
+
+void DPDKReceiver::attach_telemetry() {
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    telemetry_->describe(static_cast<int32_t>(getpid()), config_.port_id, num_queues_,
+                         tsc_.get_ghz(),
+                         static_cast<uint64_t>(now.tv_sec) * 1'000'000'000ULL +
+                             static_cast<uint64_t>(now.tv_nsec),
+                         config_.raw_tsc);
+    tsc_.set_mirror(&telemetry_->clock());
+
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        RxQueue& q = *queues_[i];
+        TelemetryQueue& slot = telemetry_->queue(i);
+        slot.queue_id = q.queue_id;
+        slot.udp_port = q.udp_port;
+        slot.lcore_id = q.lcore_id;
+        slot.has_latency = q.latency != nullptr;
+        slot.active = 1;
+
+        // Writers are not running yet: repoint them at the shared slot
+        q.stats = &slot.stats;
+        if (q.latency) {
+            q.latency = &slot.latency;
+            q.latency_storage.reset();
+        }
+    }
 }
 
 void DPDKReceiver::poll_loop() {
     running_.store(true, std::memory_order_relaxed);
 
-    rte_mbuf* pkts[BURST_SIZE];
+    if (replay_) {
+        replay_loop(*queues_[0]);
+        return;
+    }
+
+    // A/B: the main lcore polls both lines of the feed
+    if (config_.ab_arbitration) {
+        poll_queue_pair(*queues_[0], *queues_[1]);
+        return;
+    }
+
+    // Launch queues 1..N-1 on their worker lcores
+    for (uint16_t i = 1; i < num_queues_; ++i) {
+        int ret = rte_eal_remote_launch(queue_worker_main, queues_[i].get(),
+                                        queues_[i]->lcore_id);
+        if (ret != 0) {
+            std::fprintf(stderr, "Error: Failed to launch queue %u on lcore %u: %s\n",
+                         queues_[i]->queue_id, queues_[i]->lcore_id, rte_strerror(-ret));
+            stop();
+        }
+    }
+
+    // Queue 0 polls on the calling lcore
+    poll_queue(*queues_[0]);
+
+    for (uint16_t i = 1; i < num_queues_; ++i) {
+        rte_eal_wait_lcore(queues_[i]->lcore_id);
+    }
+}
+
+bool DPDKReceiver::init_tsc_sync() {
+    // Timestamps assume one TSC rate on every core in every power state
+    const TscFeatures tsc = detect_tsc_features();
+    if (!tsc.invariant) {
+        std::fprintf(stderr, "Warning: TSC is not invariant (CPUID 80000007h EDX[8])%s: "
+                     "timestamps drift with P/C-states\n",
+                     tsc.constant ? ", only constant_tsc" : "");
+    }
+
+    if (!config_.tsc_sync.enabled) {
+        return true;
+    }
+    if (config_.tsc_sync.reference == TscReference::PHC && !has_port()) {
+        std::fprintf(stderr, "Error: No port PHC for TSC sync (use realtime)\n");
+        return false;
+    }
+    tsc_sync_ = std::make_unique<TscSync>(tsc_, config_.tsc_sync, config_.port_id);
+    return tsc_sync_->sync_once();
+}
+
+bool DPDKReceiver::init_replay() {
+    // A journal is one queue's output: it replays into one queue
+    if (num_queues_ != 1 || config_.ab_arbitration) {
+        std::fprintf(stderr, "Error: Replay feeds a single queue (no -Q, no -A)\n");
+        return false;
+    }
+    if (config_.replay_speed < 0) {
+        std::fprintf(stderr, "Error: Replay speed must be >= 0 (0 = unpaced)\n");
+        return false;
+    }
+
+    replay_ = std::make_unique<ReplaySource>();
+    if (!replay_->open(config_.replay_file, queues_[0]->udp_port, config_.wire_seq)) {
+        return false;
+    }
+
+    // Recorded timestamps ride in the NIC timestamp field, so
+    // rx_timestamp_ns() hands them to the parser unchanged
+    ReplaySource::Frame first;
+    if (!replay_->next(first)) {
+        std::fprintf(stderr, "Error: '%s' holds no frames\n", config_.replay_file.c_str());
+        return false;
+    }
+    replay_->rewind();
+    if (!config_.replay_live_ts && !nic_clock_.init_replay(first.ts_ns)) {
+        return false;
+    }
+
+    if (config_.replay_speed == REPLAY_MAX_SPEED) {
+        std::printf("Replay pacing: unpaced (full %u-frame bursts)\n", config_.burst_size);
+    } else {
+        std::printf("Replay pacing: %.2fx recorded rate\n", config_.replay_speed);
+    }
+    return true;
+}
+
+// Stand-in for poll_queue_burst(): frames become due at their recorded
+// offset from the first one (scaled), and a burst takes every frame that
+// is already due - what rte_eth_rx_burst() would have returned
+void DPDKReceiver::replay_loop(RxQueue& q) {
+    ReplaySource& src = *replay_;
+    const uint16_t burst = config_.burst_size;
+    const bool paced = config_.replay_speed != REPLAY_MAX_SPEED;
+    const double cycles_per_ns = paced ? tsc_.get_ghz() / config_.replay_speed : 0.0;
+
+    std::printf("Starting replay of %s into queue %u, burst %u\n",
+                src.path().c_str(), q.queue_id, burst);
+
+    if (q.latency) {
+        q.latency->attach_writer();
+    }
+
+    ReplaySource::Frame frame{};
+    bool have = src.next(frame);
+    const uint64_t first_ns = frame.ts_ns;
+    const uint64_t start = rdtsc();
+    auto due = [&](const ReplaySource::Frame& f) {
+        const uint64_t offset_ns = f.ts_ns > first_ns ? f.ts_ns - first_ns : 0;
+        return start + static_cast<uint64_t>(static_cast<double>(offset_ns) * cycles_per_ns);
+    };
+
+    rte_mbuf* pkts[MAX_BURST_SIZE];
+    uint64_t oversized = 0;
+    while (have && likely(running_.load(std::memory_order_relaxed))) {
+        if (paced) {
+            const uint64_t at = due(frame);
+            while (rdtsc() < at && running_.load(std::memory_order_relaxed)) {
+                rte_pause();
+            }
+        }
+        const uint64_t now = rdtsc();
+
+        uint16_t n = 0;
+        do {
+            rte_mbuf* m = rte_pktmbuf_alloc(mbuf_pool_);
+            if (unlikely(m == nullptr)) {
+                break;      // Hot path frees as it goes: retry next burst
+            }
+            if (unlikely(frame.len > rte_pktmbuf_tailroom(m))) {
+                rte_pktmbuf_free(m);
+                ++oversized;
+            } else {
+                std::memcpy(rte_pktmbuf_mtod(m, uint8_t*), frame.data, frame.len);
+                m->data_len = static_cast<uint16_t>(frame.len);
+                m->pkt_len = frame.len;
+                if (nic_clock_.enabled()) {
+                    nic_clock_.stamp(m, frame.ts_ns);
+                }
+                pkts[n++] = m;
+            }
+            have = src.next(frame);
+        } while (have && n < burst && (!paced || due(frame) <= now));
+
+        if (n > 0) {
+            inject_burst(q.queue_id, pkts, n);
+        }
+    }
+
+    if (q.latency) {
+        q.latency->detach_writer();
+    }
+
+    std::printf("Replay %s after %lu frames (%.3f s)\n", have ? "stopped" : "complete",
+                src.position(), tsc_.cycles_to_ns(rdtsc() - start) / 1e9);
+    if (oversized > 0) {
+        std::fprintf(stderr, "Warning: %lu frames exceed the mbuf data room, skipped\n",
+                     oversized);
+    }
+    stop();
+}
+
+int DPDKReceiver::queue_worker_main(void* arg) {
+    auto* q = static_cast<RxQueue*>(arg);
+    q->owner->poll_queue(*q);
+    return 0;
+}
+
+void DPDKReceiver::poll_queue(RxQueue& q) {
+    dispatch_hot_path([this, &q](auto path) {
+        with_burst_size(config_.burst_size, [this, &q](auto burst) {
+            if (q.socket) {
+                poll_socket_burst<decltype(path), decltype(burst)::value>(q);
+            } else {
+                poll_queue_burst<decltype(path), decltype(burst)::value>(q);
+            }
+        });
+    });
+}
+
+void DPDKReceiver::poll_queue_pair(RxQueue& a, RxQueue& b) {
+    dispatch_hot_path([this, &a, &b](auto path) {
+        with_burst_size(config_.burst_size, [this, &a, &b](auto burst) {
+            poll_queue_pair_burst<decltype(path), decltype(burst)::value>(a, b);
+        });
+    });
+}
 
-    std::printf("Starting poll loop on port %u, queue %u, UDP port %u\n",
-                config_.port_id, config_.queue_id, config_.udp_port);
+template<typename Path, uint16_t BURST>
+void DPDKReceiver::poll_queue_burst(RxQueue& q) {
+    rte_mbuf* pkts[BURST];
+
+    std::printf("Starting poll loop on port %u, queue %u, lcore %u, UDP port %u, burst %u\n",
+                config_.port_id, q.queue_id, q.lcore_id, q.udp_port, BURST);
+
+    if (q.latency) {
+        q.latency->attach_writer();
+    }
+
+    // Spin hot, back off only after config_.idle.spin_polls empty polls
+    q.idle.init(config_.idle, config_.port_id, q.queue_id, tsc_);
+    if (q.idle.enabled()) {
+        std::printf("Queue %u: idle backoff after %u empty polls (%s)\n", q.queue_id,
+                    config_.idle.spin_polls,
+                    q.idle.can_monitor() ? "pause, then power monitor" : "pause");
+    }
 
     while (likely(running_.load(std::memory_order_relaxed))) {
-        uint16_t nb_rx = rte_eth_rx_burst(
-            config_.port_id,
-            config_.queue_id,
-            pkts,
-            BURST_SIZE
-        );
+        const uint16_t nb_rx = poll_once<Path, BURST>(q, pkts, q.idle);
+        if (unlikely(nb_rx == 0)) {
+            q.idle.on_empty();
+        }
+    }
+
+    if (q.latency) {
+        q.latency->detach_writer();
+    }
+
+    std::printf("Poll loop stopped (queue %u)\n", q.queue_id);
+}
+
+template<typename Path, uint16_t BURST>
+void DPDKReceiver::poll_socket_burst(RxQueue& q) {
+    rte_mbuf* pkts[BURST];
+
+    std::printf("Starting socket poll loop on queue %u, lcore %u, UDP port %u, burst %u\n",
+                q.queue_id, q.lcore_id, q.udp_port, BURST);
+
+    if (q.latency) {
+        q.latency->attach_writer();
+    }
+
+    // Busy-spin: every empty recvmmsg() also runs one NAPI poll (SO_BUSY_POLL)
+    while (likely(running_.load(std::memory_order_relaxed))) {
+        const uint16_t nb_rx = q.socket->receive(pkts, BURST);
+        if (nb_rx > 0) {
+            inject_burst_path<Path>(q, pkts, nb_rx);
+        }
+    }
+
+    if (q.latency) {
+        q.latency->detach_writer();
+    }
+
+    if (q.socket->truncated() > 0) {
+        std::fprintf(stderr, "Warning: Queue %u: %lu datagrams cut to the mbuf data room\n",
+                     q.queue_id, q.socket->truncated());
+    }
+    std::printf("Socket poll loop stopped (queue %u)\n", q.queue_id);
+}
+
+// First burst after a backoff: how late did the loop see it?
+// NIC stamp -> now when stamped, else end of the last wait -> now
+void DPDKReceiver::record_wakeup(RxQueue& q, IdleBackoff& idle, const rte_mbuf* first) {
+    const uint64_t now = rdtsc();
+    uint64_t cycles;
+    if (nic_clock_.has_timestamp(first)) {
+        const uint64_t now_ns = tsc_.tsc_to_ns(now);
+        const uint64_t wire_ns = nic_clock_.to_ns(first);
+        cycles = now_ns > wire_ns ? tsc_.ns_to_cycles(now_ns - wire_ns) : 0;
+    } else {
+        cycles = now - idle.wait_end();
+    }
+
+    idle.record_wakeup(cycles);
+    if (q.latency) {
+        q.latency->record(LatencyStage::WAKE_UP, cycles);
+    }
+}
+
+template<typename Path, uint16_t BURST>
+void DPDKReceiver::poll_queue_pair_burst(RxQueue& a, RxQueue& b) {
+    rte_mbuf* pkts[BURST];
+
+    std::printf("Starting A/B poll loop on port %u, queues %u + %u, lcore %u\n",
+                config_.port_id, a.queue_id, b.queue_id, a.lcore_id);
+
+    for (RxQueue* q : {&a, &b}) {
+        if (q->latency) {
+            q->latency->attach_writer();
+        }
+    }
 
-        if (likely(nb_rx > 0)) {
-            process_burst(pkts, nb_rx);
+    // One backoff for the pair, pause only: UMWAIT watches a single
+    // descriptor and would sleep through the other line
+    IdleConfig idle_cfg = config_.idle;
+    idle_cfg.monitor_us = 0;
+    a.idle.init(idle_cfg, config_.port_id, a.queue_id, tsc_);
+
+    // Alternate lines so neither waits behind the other's burst
+    while (likely(running_.load(std::memory_order_relaxed))) {
+        const uint16_t nb_rx = poll_once<Path, BURST>(a, pkts, a.idle) +
+                               poll_once<Path, BURST>(b, pkts, a.idle);
+        if (unlikely(nb_rx == 0)) {
+            a.idle.on_empty();
+        }
+    }
+
+    for (RxQueue* q : {&a, &b}) {
+        if (q->latency) {
+            q->latency->detach_writer();
         }
-        // No pause/yield - busy poll for minimum latency
     }
 
-    std::printf("Poll loop stopped\n");
+    std::printf("A/B poll loop stopped (queues %u + %u)\n", a.queue_id, b.queue_id);
+}
+
+void DPDKReceiver::flush_conflation(RxQueue& q) {
+    uint32_t flushed;
+    if (config_.publish_mode == PublishMode::NATIVE) {
+        flushed = q.conflation->flush([this, &q](const BBODataFast& bbo) {
+            return try_publish_native(q, bbo);
+        });
+    } else {
+        flushed = q.conflation->flush([this, &q](const BBODataFast& bbo) {
+            return try_convert_and_publish(q, bbo);
+        });
+    }
+
+    if (config_.enable_stats && flushed > 0) {
+        q.stats->conflation_flushed.add(flushed);
+    }
+}
+
+bool DPDKReceiver::fan_out_payload(RxQueue& q, const uint8_t* payload, size_t payload_len,
+                                   uint64_t ts_ns, uint32_t sequence) {
+    BBODataFast bbo;
+    if (unlikely(!BBOParserFast::parse_into(payload, payload_len, bbo, ts_ns, sequence))) {
+        return false;
+    }
+    if (config_.fpga_deltas) {
+        BBOParserFast::pack_fpga_deltas(payload, payload_len, bbo);
+    }
+    stamp_instrument(bbo);
+    fan_out(q, bbo, payload, payload_len);
+    return true;
 }
 
 void DPDKReceiver::warm_up(int synthetic_packets) {
@@ -257,15 +1582,80 @@ void DPDKReceiver::warm_up(int synthetic_packets) {
     warm_cache();
 
     // Stage 2: Send synthetic packets through the processing path
+    // (without interning: "WARMUP" must not take an instrument ID, and
+    // must not reach the route consumers or the journal)
+    InstrumentMap* instruments = instruments_;
+    instruments_ = nullptr;
+    PublishRouter* routers[MAX_RX_QUEUES];
+    DefaultJournalRing* journals[MAX_RX_QUEUES];
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        routers[i] = queues_[i]->router;
+        journals[i] = queues_[i]->journal;
+        queues_[i]->router = nullptr;
+        queues_[i]->journal = nullptr;
+    }
     warm_dpdk_path(synthetic_packets);
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        queues_[i]->router = routers[i];
+        queues_[i]->journal = journals[i];
+    }
+    instruments_ = instruments;
+
+    // Synthetic samples would skew the live percentiles
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (queues_[i]->latency) {
+            queues_[i]->latency->reset();
+        }
+        // Drop the synthetic orders / WARMUP book and their counts
+        if (ItchBookBuilder* itch = queues_[i]->itch_storage.get()) {
+            itch->reset();
+            itch->reset_counters();
+        }
+        if (SbeDecoder* sbe = queues_[i]->sbe_storage.get()) {
+            sbe->reset_counters();
+        }
+        // Live feed starts its own sequence
+        if (queues_[i]->arbiter_storage) {
+            queues_[i]->arbiter_storage->reset();
+            queues_[i]->arbiter_storage->reset_counters();
+        }
+    }
 
     std::printf("Warm-up complete (%d synthetic packets processed)\n",
                 synthetic_packets);
 }
 
 void DPDKReceiver::warm_cache() {
-    // Touch all entries in BBO pool to bring into cache
-    bbo_pool_.warm_cache();
+    // Touch all entries in each queue's BBO pool to bring into cache
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        queues_[i]->bbo_pool.warm_cache();
+        if (queues_[i]->conflation_storage) {
+            queues_[i]->conflation_storage->warm_cache();
+        }
+
+        // Ring pages: TLB entries for the publishing path
+        if (i == 0 || queues_[i]->fast_ring != queues_[0]->fast_ring ||
+            queues_[i]->ring_buffer != queues_[0]->ring_buffer) {
+            if (queues_[i]->fast_ring) {
+                ShmBacking::touch(queues_[i]->fast_ring, sizeof(BboFastRing), shm_.page_size());
+            }
+            if (queues_[i]->ring_buffer) {
+                ShmBacking::touch(queues_[i]->ring_buffer, sizeof(disruptor::BboRingBuffer),
+                                  shm_.page_size());
+            }
+        }
+
+        if (PublishRouter* router = queues_[i]->router_storage.get()) {
+            router->warm_cache();
+            for (uint8_t r = 0; r < router->size(); ++r) {
+                ShmBacking::touch(router->lane(r).ring, sizeof(BboFastRing), shm_.page_size());
+            }
+        }
+    }
+
+    if (instruments_) {
+        ShmBacking::touch(instruments_, sizeof(InstrumentMap), shm_.page_size());
+    }
 
     // Touch TSC calibrator to ensure it's in cache
     volatile uint64_t sink = tsc_.cycles_to_ns(rdtsc());
@@ -275,27 +1665,43 @@ void DPDKReceiver::warm_cache() {
 }
 
 void DPDKReceiver::warm_dpdk_path(int count) {
-    for (int i = 0; i < count; ++i) {
-        rte_mbuf* dummy = create_dummy_packet();
-        if (dummy) {
-            process_packet(dummy);
-            rte_pktmbuf_free(dummy);
+    // Runs on the main lcore before the workers start; trains the shared
+    // code path and faults in every queue's pool and ring pages
+    dispatch_hot_path([this, count](auto path) {
+        uint64_t seq = 1;
+        for (uint16_t q = 0; q < num_queues_; ++q) {
+            RxQueue& rxq = *queues_[q];
+            for (int i = 0; i < count; ++i) {
+                rte_mbuf* dummy = create_dummy_packet(rxq.udp_port, seq++);
+                if (!dummy) {
+                    continue;
+                }
+                rxq.rx_tsc = rdtsc();
+                if (rxq.itch || rxq.sbe) {
+                    // Decoder burst loop (frees the mbuf)
+                    process_burst<decltype(path)>(rxq, &dummy, 1);
+                } else {
+                    process_packet<decltype(path)>(rxq, dummy);
+                    rte_pktmbuf_free(dummy);
+                }
+            }
         }
-    }
+    });
 }
 
-rte_mbuf* DPDKReceiver::create_dummy_packet() {
+rte_mbuf* DPDKReceiver::create_dummy_packet(uint16_t udp_port, uint64_t seq) {
     rte_mbuf* pkt = rte_pktmbuf_alloc(mbuf_pool_);
     if (!pkt) {
         return nullptr;
     }
 
-    // Minimum packet: Ethernet + IP + UDP + BBO data
+    // Minimum packet: Ethernet + IP + UDP + one datagram of the feed protocol
     constexpr size_t ETH_SIZE = sizeof(rte_ether_hdr);
     constexpr size_t IP_SIZE = sizeof(rte_ipv4_hdr);
     constexpr size_t UDP_SIZE = sizeof(rte_udp_hdr);
-    constexpr size_t BBO_SIZE = 44;  // Full BBO with timestamps
-    constexpr size_t TOTAL_SIZE = ETH_SIZE + IP_SIZE + UDP_SIZE + BBO_SIZE;
+    const size_t PAYLOAD_SIZE = warmup_payload_size(config_.protocol);
+    const size_t SEQ_SIZE = config_.wire_seq ? WIRE_SEQ_SIZE : 0;
+    const size_t TOTAL_SIZE = ETH_SIZE + IP_SIZE + UDP_SIZE + SEQ_SIZE + PAYLOAD_SIZE;
 
     char* data = rte_pktmbuf_append(pkt, TOTAL_SIZE);
     if (!data) {
@@ -312,56 +1718,227 @@ rte_mbuf* DPDKReceiver::create_dummy_packet() {
     // IP header
     auto* ip = reinterpret_cast<rte_ipv4_hdr*>(data + ETH_SIZE);
     ip->version_ihl = 0x45;  // IPv4, 20 bytes header
-    ip->total_length = rte_cpu_to_be_16(IP_SIZE + UDP_SIZE + BBO_SIZE);
+    ip->total_length = rte_cpu_to_be_16(IP_SIZE + UDP_SIZE + SEQ_SIZE + PAYLOAD_SIZE);
     ip->next_proto_id = IPPROTO_UDP;
 
     // UDP header
     auto* udp = reinterpret_cast<rte_udp_hdr*>(data + ETH_SIZE + IP_SIZE);
-    udp->dst_port = rte_cpu_to_be_16(config_.udp_port);
-    udp->dgram_len = rte_cpu_to_be_16(UDP_SIZE + BBO_SIZE);
-
-    // BBO payload (synthetic)
-    uint8_t* bbo = reinterpret_cast<uint8_t*>(data + ETH_SIZE + IP_SIZE + UDP_SIZE);
-
-    // Symbol: "WARMUP  "
-    std::memcpy(bbo, "WARMUP  ", 8);
-
-    // Set valid prices (network byte order)
-    uint32_t price = __builtin_bswap32(1500000);  // $150.00
-    uint32_t shares = __builtin_bswap32(100);
-    uint32_t spread = __builtin_bswap32(1000);    // $0.10
+    udp->dst_port = rte_cpu_to_be_16(udp_port);
+    udp->dgram_len = rte_cpu_to_be_16(UDP_SIZE + SEQ_SIZE + PAYLOAD_SIZE);
+
+    // Wire sequence prefix (network byte order)
+    uint8_t* payload = reinterpret_cast<uint8_t*>(data + ETH_SIZE + IP_SIZE + UDP_SIZE);
+    if (SEQ_SIZE) {
+        put_be64(payload, seq);
+        payload += SEQ_SIZE;
+    }
 
-    std::memcpy(bbo + 8, &price, 4);   // bid_price
-    std::memcpy(bbo + 12, &shares, 4); // bid_shares
-    std::memcpy(bbo + 16, &price, 4);  // ask_price
-    std::memcpy(bbo + 20, &shares, 4); // ask_shares
-    std::memcpy(bbo + 24, &spread, 4); // spread
+    switch (config_.protocol) {
+    case FeedProtocol::ITCH:
+        write_itch_warmup(payload, seq);
+        break;
+    case FeedProtocol::SBE:
+        write_sbe_warmup(payload, seq);
+        break;
+    default:
+        write_bbo_warmup(payload);
+        break;
+    }
 
     return pkt;
 }
 
 void DPDKReceiver::print_stats() const {
+    uint64_t received = 0, processed = 0, errors = 0, full = 0;
+    uint64_t conflated = 0, flushed = 0;
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        const Stats& st = *queues_[i]->stats;
+        received += st.packets_received.load();
+        processed += st.packets_processed.load();
+        errors += st.parse_errors.load();
+        full += st.ring_buffer_full.load();
+        conflated += st.conflated.load();
+        flushed += st.conflation_flushed.load();
+    }
+
     std::printf("=== DPDKReceiver Statistics ===\n");
-    std::printf("  Packets received:  %lu\n",
-                stats_.packets_received.load(std::memory_order_relaxed));
-    std::printf("  Packets processed: %lu\n",
-                stats_.packets_processed.load(std::memory_order_relaxed));
-    std::printf("  Parse errors:      %lu\n",
-                stats_.parse_errors.load(std::memory_order_relaxed));
-    std::printf("  Ring buffer full:  %lu\n",
-                stats_.ring_buffer_full.load(std::memory_order_relaxed));
+    std::printf("  Packets received:  %lu\n", received);
+    std::printf("  Packets processed: %lu\n", processed);
+    std::printf("  Parse errors:      %lu\n", errors);
+    std::printf("  Ring buffer full:  %lu\n", full);
+    if (config_.conflate) {
+        std::printf("  Conflated:         %lu (flushed %lu)\n", conflated, flushed);
+    }
+    if (instruments_) {
+        std::printf("  Instrument IDs:    %u assigned, %lu lookups with the map full\n",
+                    instruments_->size(), instruments_->overflow());
+    }
+    if (journal_) {
+        std::printf("  Journal:           %lu records in %lu files (%s)\n",
+                    journal_->records(), journal_->files(), config_.journal.dir.c_str());
+    }
     std::printf("  TSC calibration:   %.3f GHz\n", tsc_.get_ghz());
-    std::printf("  BBO pool head:     %u\n", bbo_pool_.current_head());
-    std::printf("  Using hugepages:   %s\n",
-                bbo_pool_.is_using_hugepages() ? "yes" : "no");
+    if (tsc_sync_) {
+        std::printf("  TSC sync:          %s, %lu updates (%lu steps), offset %+ld ns, "
+                    "rate %+.3f ppm\n",
+                    tsc_reference_name(config_.tsc_sync.reference), tsc_sync_->updates(),
+                    tsc_sync_->steps(), tsc_sync_->last_offset_ns(), tsc_sync_->rate_ppm());
+    }
+    if (telemetry_) {
+        std::printf("  Telemetry:         /bbo_telemetry_%s (bbo_stat -s %s)\n",
+                    config_.shm_name.c_str(), config_.shm_name.c_str());
+    }
+
+    NicClockDrift drift;
+    if (nic_clock_.measure(drift)) {
+        std::printf("  NIC clock:         %.3f MHz, %+ld ns vs TSC (%lu re-fits, %lu steps)\n",
+                    1000.0 / nic_clock_.ns_per_tick(), drift.nic_error_ns,
+                    nic_clock_.refits(), nic_clock_.steps());
+        if (drift.has_phc) {
+            std::printf("  PHC - TSC:         %+ld ns (drift %+ld ns)\n",
+                        drift.phc_offset_ns, drift.phc_drift_ns);
+        }
+    }
+
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        const RxQueue& q = *queues_[i];
+        std::printf("  Queue %u (lcore %u): rx=%lu processed=%lu errors=%lu full=%lu "
+                    "pool_head=%u hugepages=%s node=%d\n",
+                    q.queue_id, q.lcore_id,
+                    q.stats->packets_received.load(),
+                    q.stats->packets_processed.load(),
+                    q.stats->parse_errors.load(),
+                    q.stats->ring_buffer_full.load(),
+                    q.bbo_pool.current_head(),
+                    q.bbo_pool.is_using_hugepages() ? "yes" : "no",
+                    q.bbo_pool.numa_node());
+        if (const DefaultConflationCache* conflation = q.conflation_storage.get()) {
+            std::printf("    Conflation: %u symbols, %u dirty\n",
+                        conflation->symbols(), conflation->dirty_count());
+        }
+        if (q.journal_storage) {
+            std::printf("    Journal: %lu captured, %lu dropped (writer behind), %lu pending\n",
+                        q.journal_storage->written(), q.journal_storage->dropped(),
+                        q.journal_storage->pending());
+        }
+        if (const PublishRouter* router = q.router_storage.get()) {
+            for (uint8_t r = 0; r < router->size(); ++r) {
+                const RouteLane& lane = router->lane(r);
+                std::printf("    Route %s: published=%lu dropped=%lu",
+                            router->table().route(r).name.c_str(),
+                            lane.published.load(), lane.dropped.load());
+                if (lane.conflation) {
+                    std::printf(" conflated=%lu (flushed %lu, %u dirty)",
+                                lane.conflated.load(), lane.flushed.load(),
+                                lane.conflation->dirty_count());
+                }
+                std::printf("\n");
+            }
+        }
+        if (q.itch_storage) {
+            const ItchBookBuilder& itch = *q.itch_storage;
+            std::printf("    ITCH: %lu messages, %lu top-of-book updates (%lu coalesced), %u books, "
+                        "unknown orders=%lu truncated=%lu book overflow=%lu order overflow=%lu\n",
+                        itch.messages(), itch.updates(), itch.coalesced(), itch.books(),
+                        itch.unknown_orders(), itch.truncated(), itch.book_overflow(),
+                        itch.order_overflow());
+        }
+        if (const SbeDecoder* sbe = q.sbe_storage.get()) {
+            std::printf("    SBE: %lu messages, %lu top-of-book updates, %lu skipped, "
+                        "%lu bad prices, %lu not subscribed\n",
+                        sbe->messages(), sbe->updates(), sbe->skipped(),
+                        sbe->bad_prices(), sbe->filtered());
+        }
+        if (filter_.enabled() && config_.protocol == FeedProtocol::BBO) {
+            std::printf("    Symbol filter: %lu packets not subscribed\n",
+                        q.stats->packets_filtered.load());
+        }
+        if (q.idle.enabled()) {
+            const uint64_t wakeups = q.idle.wakeups();
+            std::printf("    Idle: %lu pauses, %lu monitor waits, %lu wake-ups "
+                        "(avg %lu ns, max %lu ns)\n",
+                        q.idle.pauses(), q.idle.monitors(), wakeups,
+                        wakeups ? tsc_.cycles_to_ns(q.idle.wake_cycles() / wakeups) : 0,
+                        tsc_.cycles_to_ns(q.idle.wake_max()));
+        }
+        if (q.arbiter) {
+            std::printf("    Wire sequence: %lu duplicate/stale dropped\n",
+                        q.stats->packets_dropped.load());
+        }
+        if (q.arbiter_storage) {
+            const FeedArbiter& arb = *q.arbiter_storage;
+            std::printf("    %s: gaps=%lu filled=%lu missing=%lu stale=%lu resyncs=%lu\n",
+                        config_.ab_arbitration ? "A/B arbitration" : "Sequence",
+                        arb.gaps(), arb.filled(), arb.missing(),
+                        arb.stale(), arb.resyncs());
+        }
+        if (q.latency) {
+            print_latency(q);
+        }
+    }
+}
+
+void DPDKReceiver::print_latency(const RxQueue& q) const {
+    if (!q.latency->collect()) {
+        std::printf("    Latency: queue %u did not hand over its histograms\n", q.queue_id);
+        return;
+    }
+
+    std::printf("    Latency (ns)       count      p50      p90      p99    p99.9      max\n");
+    for (size_t s = 0; s < LATENCY_STAGES; ++s) {
+        const auto stage = static_cast<LatencyStage>(s);
+        const LatencyHistogram& h = q.latency->cumulative(stage);
+        if (h.count() == 0) {
+            continue;
+        }
+
+        auto ns = [this, stage](uint64_t ticks) -> uint64_t {
+            return latency_stage_is_fpga(stage)
+                ? static_cast<uint64_t>(ticks * FPGA_NS_PER_CYCLE)
+                : tsc_.cycles_to_ns(ticks);
+        };
+        std::printf("    %-15s %9lu %8lu %8lu %8lu %8lu %8lu\n",
+                    latency_stage_name(stage), h.count(),
+                    ns(h.value_at_percentile(50.0)), ns(h.value_at_percentile(90.0)),
+                    ns(h.value_at_percentile(99.0)), ns(h.value_at_percentile(99.9)),
+                    ns(h.max()));
+    }
+
+    // Tail target is P99/P50 < 2.5x end to end; report the last interval too
+    const LatencyHistogram& total = q.latency->cumulative(LatencyStage::RX_TO_PUBLISH);
+    const LatencyHistogram& last = q.latency->interval(LatencyStage::RX_TO_PUBLISH);
+    if (total.count() > 0 && total.value_at_percentile(50.0) > 0) {
+        const double ratio = static_cast<double>(total.value_at_percentile(99.0)) /
+                             static_cast<double>(total.value_at_percentile(50.0));
+        std::printf("    P99/P50 rx->publish: %.2fx (target < 2.5x)", ratio);
+        if (last.count() > 0 && last.value_at_percentile(50.0) > 0) {
+            std::printf(", last interval %.2fx",
+                        static_cast<double>(last.value_at_percentile(99.0)) /
+                        static_cast<double>(last.value_at_percentile(50.0)));
+        }
+        std::printf("\n");
+    }
 }
 
 void DPDKReceiver::reset_stats() {
-    stats_.packets_received.store(0, std::memory_order_relaxed);
-    stats_.packets_processed.store(0, std::memory_order_relaxed);
-    stats_.packets_dropped.store(0, std::memory_order_relaxed);
-    stats_.parse_errors.store(0, std::memory_order_relaxed);
-    stats_.ring_buffer_full.store(0, std::memory_order_relaxed);
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        Stats& st = *queues_[i]->stats;
+        st.packets_received.reset();
+        st.packets_processed.reset();
+        st.packets_dropped.reset();
+        st.packets_filtered.reset();
+        st.parse_errors.reset();
+        st.ring_buffer_full.reset();
+        st.conflated.reset();
+        st.conflation_flushed.reset();
+        if (queues_[i]->arbiter_storage) {
+            queues_[i]->arbiter_storage->reset_counters();
+        }
+        if (queues_[i]->router_storage) {
+            queues_[i]->router_storage->reset_stats();
+        }
+        queues_[i]->idle.reset_counters();
+    }
 }
 
 }  // namespace ultra_ll
@@ -0,0 +1,144 @@
+#include "flow_rules.h"
+#include <cstdio>
+#include <netinet/in.h>
+
+namespace ultra_ll {
+
+namespace {
+
+// ETH / IPV4 / UDP / END with dst port, optional dst group, and IHL=5 when
+// marking (the mark promises a fixed payload offset)
+struct BboPattern {
+    rte_flow_item_ipv4 ip_spec{};
+    rte_flow_item_ipv4 ip_mask{};
+    rte_flow_item_udp udp_spec{};
+    rte_flow_item_udp udp_mask{};
+    rte_flow_item items[4]{};
+
+    BboPattern(uint16_t udp_port, uint32_t dst_group_be, bool mark) {
+        ip_spec.hdr.next_proto_id = IPPROTO_UDP;
+        ip_mask.hdr.next_proto_id = 0xFF;
+        if (dst_group_be != 0) {
+            ip_spec.hdr.dst_addr = dst_group_be;
+            ip_mask.hdr.dst_addr = 0xFFFFFFFF;
+        }
+        if (mark) {
+            ip_spec.hdr.version_ihl = 0x45;
+            ip_mask.hdr.version_ihl = 0xFF;
+        }
+
+        udp_spec.hdr.dst_port = rte_cpu_to_be_16(udp_port);
+        udp_mask.hdr.dst_port = 0xFFFF;
+
+        items[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+        items[1].type = RTE_FLOW_ITEM_TYPE_IPV4;
+        items[1].spec = &ip_spec;
+        items[1].mask = &ip_mask;
+        items[2].type = RTE_FLOW_ITEM_TYPE_UDP;
+        items[2].spec = &udp_spec;
+        items[2].mask = &udp_mask;
+        items[3].type = RTE_FLOW_ITEM_TYPE_END;
+    }
+};
+
+}  // namespace
+
+bool FlowRules::add_queue_rule(uint16_t udp_port, uint32_t dst_group_be,
+                               uint16_t queue, bool mark) {
+    BboPattern pattern(udp_port, dst_group_be, mark);
+
+    rte_flow_action_mark mark_conf{};
+    mark_conf.id = BBO_FLOW_MARK;
+    rte_flow_action_queue queue_conf{};
+    queue_conf.index = queue;
+
+    rte_flow_action actions[3]{};
+    size_t n = 0;
+    if (mark) {
+        actions[n].type = RTE_FLOW_ACTION_TYPE_MARK;
+        actions[n++].conf = &mark_conf;
+    }
+    actions[n].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+    actions[n++].conf = &queue_conf;
+    actions[n].type = RTE_FLOW_ACTION_TYPE_END;
+
+    return create(0, pattern.items, actions, "queue");
+}
+
+bool FlowRules::add_rss_rule(uint16_t udp_port, uint32_t dst_group_be,
+                             const uint16_t* queues, uint16_t nb_queues, bool mark) {
+    BboPattern pattern(udp_port, dst_group_be, mark);
+
+    rte_flow_action_mark mark_conf{};
+    mark_conf.id = BBO_FLOW_MARK;
+
+    rte_flow_action_rss rss_conf{};
+    rss_conf.func = RTE_ETH_HASH_FUNCTION_DEFAULT;
+    rss_conf.types = RTE_ETH_RSS_IP | RTE_ETH_RSS_UDP;
+    rss_conf.queue_num = nb_queues;
+    rss_conf.queue = queues;
+
+    rte_flow_action actions[3]{};
+    size_t n = 0;
+    if (mark) {
+        actions[n].type = RTE_FLOW_ACTION_TYPE_MARK;
+        actions[n++].conf = &mark_conf;
+    }
+    actions[n].type = RTE_FLOW_ACTION_TYPE_RSS;
+    actions[n++].conf = &rss_conf;
+    actions[n].type = RTE_FLOW_ACTION_TYPE_END;
+
+    return create(0, pattern.items, actions, "RSS");
+}
+
+bool FlowRules::add_drop_all() {
+    rte_flow_item pattern[2]{};
+    pattern[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+    pattern[1].type = RTE_FLOW_ITEM_TYPE_END;
+
+    rte_flow_action actions[2]{};
+    actions[0].type = RTE_FLOW_ACTION_TYPE_DROP;
+    actions[1].type = RTE_FLOW_ACTION_TYPE_END;
+
+    return create(1, pattern, actions, "drop-all");
+}
+
+void FlowRules::clear() {
+    for (size_t i = 0; i < count_; ++i) {
+        rte_flow_error error{};
+        rte_flow_destroy(port_id_, rules_[i], &error);
+        rules_[i] = nullptr;
+    }
+    count_ = 0;
+}
+
+bool FlowRules::create(uint32_t priority, const rte_flow_item* pattern,
+                       const rte_flow_action* actions, const char* what) {
+    if (count_ >= MAX_FLOW_RULES) {
+        std::fprintf(stderr, "Error: Flow rule limit (%zu) reached\n", MAX_FLOW_RULES);
+        return false;
+    }
+
+    rte_flow_attr attr{};
+    attr.ingress = 1;
+    attr.priority = priority;
+
+    rte_flow_error error{};
+    if (rte_flow_validate(port_id_, &attr, pattern, actions, &error) != 0) {
+        std::fprintf(stderr, "Warning: Port %u rejects %s flow rule: %s\n",
+                     port_id_, what, error.message ? error.message : "unknown");
+        return false;
+    }
+
+    rte_flow* flow = rte_flow_create(port_id_, &attr, pattern, actions, &error);
+    if (!flow) {
+        std::fprintf(stderr, "Warning: Failed to create %s flow rule on port %u: %s\n",
+                     what, port_id_, error.message ? error.message : "unknown");
+        return false;
+    }
+
+    rules_[count_++] = flow;
+    return true;
+}
+
+}  // namespace ultra_ll
@@ -10,11 +10,14 @@
 #include "dpdk_receiver.h"
 #include "likely.h"
 
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <csignal>
 #include <cstring>
+#include <thread>
 #include <getopt.h>
+#include <arpa/inet.h>
 #include <sys/mman.h>
 #include <sched.h>
 
@@ -82,6 +85,76 @@ void pin_to_core(int core_id)
     }
 }
 
+// Parse comma-separated UDP ports for per-queue steering ("5000,5001,...")
+int parse_queue_ports(const char *arg, uint16_t *ports, int max_ports)
+{
+    int count = 0;
+    const char *p = arg;
+    while (*p && count < max_ports)
+    {
+        char *end = nullptr;
+        long v = std::strtol(p, &end, 10);
+        if (end == p || v <= 0 || v > 65535)
+        {
+            return -1;
+        }
+        ports[count++] = static_cast<uint16_t>(v);
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+// Parse comma-separated IPv4 multicast groups ("239.1.1.1,239.1.1.2,...")
+// Groups are stored in network byte order
+int parse_mcast_groups(const char *arg, uint32_t *groups, int max_groups)
+{
+    int count = 0;
+    const char *p = arg;
+    while (*p && count < max_groups)
+    {
+        char addr[INET_ADDRSTRLEN];
+        size_t len = std::strcspn(p, ",");
+        if (len == 0 || len >= sizeof(addr))
+        {
+            return -1;
+        }
+        std::memcpy(addr, p, len);
+        addr[len] = '\0';
+
+        in_addr group;
+        if (inet_pton(AF_INET, addr, &group) != 1 || !IN_MULTICAST(ntohl(group.s_addr)))
+        {
+            return -1;
+        }
+        groups[count++] = group.s_addr;
+        p += (p[len] == ',') ? len + 1 : len;
+    }
+    return count;
+}
+
+// Parse idle policy "spin[,pause[,monitor_us]]" (missing fields keep defaults)
+bool parse_idle_policy(const char *arg, ultra_ll::IdleConfig &idle)
+{
+    uint32_t *fields[] = {&idle.spin_polls, &idle.pause_polls, &idle.monitor_us};
+    const char *p = arg;
+    for (uint32_t *field : fields)
+    {
+        char *end = nullptr;
+        long v = std::strtol(p, &end, 10);
+        if (end == p || v < 0)
+        {
+            return false;
+        }
+        *field = static_cast<uint32_t>(v);
+        if (*end != ',')
+        {
+            return *end == '\0';
+        }
+        p = end + 1;
+    }
+    return false;
+}
+
 // Print usage
 void print_usage(const char *prog)
 {
@@ -92,19 +165,75 @@ void print_usage(const char *prog)
         "\n"
         "Options:\n"
         "  -p, --port <id>        DPDK port ID (default: 0)\n"
-        "  -q, --queue <id>       RX queue ID (default: 0)\n"
+        "  -q, --queue <id>       RX queue ID (default: 0; af_xdp: first interface queue)\n"
+        "  -d, --backend <b>      RX from dpdk (bound NIC) | af_xdp (kernel NIC, XSK) |\n"
+        "                         socket (recvmmsg + SO_BUSY_POLL) (default: dpdk)\n"
+        "  -i, --iface <if>       Kernel interface for af_xdp (required) / socket (bind)\n"
+        "  -o, --busy-poll <us>   Busy polling, 0 = off (default: %u). socket: SO_BUSY_POLL,\n"
+        "                         one NAPI poll per recvmmsg(); af_xdp: preferred busy poll\n"
         "  -u, --udp-port <port>  UDP port to listen on (default: 12345)\n"
         "  -c, --core <id>        CPU core to pin to (default: auto)\n"
         "  -s, --shm <name>       Shared memory name (default: gateway)\n"
+        "  -Q, --queues <n>       RX queues, one poll lcore each (default: 1)\n"
+        "  -S, --steer <mode>     Multi-queue steering: rss | port (default: rss)\n"
+        "  -P, --queue-ports <l>  Per-queue UDP ports for --steer port (e.g. 5000,5001)\n"
+        "  -R, --shared-ring      One ring for every queue: single-producer, so -Q 1 only\n"
+        "  -F, --hw-filter        Filter in the NIC (rte_flow), drop the rest, no promiscuous\n"
+        "  -M, --flow-mark        Mark matched frames so the fast path skips header checks\n"
+        "  -G, --mcast-groups <l> Multicast groups to accept (e.g. 239.1.1.1,239.1.1.2)\n"
+        "  -N, --native           Publish BBODataFast to /bbo_fast_<shm> (default: gateway)\n"
+        "  -B, --batch            With -N: one ring commit per rx burst\n"
+        "  -C, --conflate         Keep latest BBO per symbol while the ring is full\n"
+        "  -T, --hw-timestamps    Stamp BBOs with NIC RX time (falls back to TSC)\n"
+        "  -U, --raw-tsc          Stamp BBOs with raw TSC; consumers convert with the\n"
+        "                         telemetry segment's clock (no per-packet conversion)\n"
+        "  -L, --latency          Per-stage latency histograms (printed with stats)\n"
+        "  -x, --no-stats         Drop the per-packet counters from the poll loop\n"
+        "  -f, --fpga-deltas      Pack FPGA T1-T4 stage deltas into each BBO's padding and\n"
+        "                         record FPGA stage histograms (bbo_stat)\n"
+        "  -W, --wire-seq         Payload carries an 8-byte sequence: drop duplicates, count gaps\n"
+        "  -H, --hugepage-dir <d> Back the rings with hugetlbfs (e.g. /dev/hugepages)\n"
+        "  -K, --consumer-core <n> CPU of the ring consumer (warn if off the NIC's node)\n"
+        "  -z, --burst <n>        RX burst size: 1, 2, 4, ... 64 (default: %u)\n"
+        "  -r, --rx-ring <n>      RX descriptors per queue (default: %u)\n"
+        "  -m, --mbufs <n[,c]>    Mbuf pool size and per-lcore cache (default: %u,%u)\n"
+        "                         (bbo_bench --sweep reports the burst/ring frontier)\n"
+        "  -I, --idle <s[,p[,us]]> Back off after s empty polls: p rte_pause polls, then\n"
+        "                         UMWAIT up to us per wait (0 = pause only; default: spin)\n"
+        "  -A, --ab-feeds         Queues 0/1 are lines A/B of one feed (implies -W, -Q 2)\n"
+        "  -X, --protocol <p>     Payload format: bbo | itch | sbe (default: bbo)\n"
+        "                         itch/sbe build the top of book in software\n"
+        "  -D, --msg-prefetch <n> ITCH: prefetch order slots n messages ahead (default: 0)\n"
+        "  -Y, --symbols <list>   Subscribe only to these symbols: A,B,... or @file\n"
+        "  -j, --instruments <l>  With -N: stamp instrument IDs, reference A,B,... / @file\n"
+        "                         (or 'dynamic'); map exported as /bbo_instruments_<shm>\n"
+        "  -O, --route <spec>     With -N: also publish to ring <name>, repeatable (max %u):\n"
+        "                         name[:drop|conflate[:A,B,...|:@file]] (default: drop, all)\n"
+        "  -J, --journal <d[,n]>  Capture every BBO + FPGA T1-T4 to <d>/<shm>_q<N>_*.bbj\n"
+        "                         (n records per file, default: %lu)\n"
+        "  -k, --journal-core <n> CPU of the journal writer thread (a non-isolated core)\n"
+        "  -Z, --journal-compress <cmd> Run '<cmd> <file>' on each closed journal file\n"
+        "  -t, --tsc-sync <r[,n]> Re-fit TSC to r = realtime | phc (port's PTP clock) every\n"
+        "                         second, thread on CPU n (default: 10 ms startup fit only)\n"
+        "  -y, --replay <file>    No NIC: play a journal (.bbj) or pcap into the ring, then exit\n"
+        "  -e, --replay-speed <x> x recorded rate: 1 = original timing, 0 = unpaced (default: 1)\n"
+        "  -E, --replay-live-ts   Stamp BBOs with TSC at injection (default: recorded time)\n"
+        "  -V, --simd [isa]       Vectorized burst parser, optional cap:\n"
+        "                         scalar | sse4 | avx2 | avx512 (default: best available)\n"
         "  -w, --warmup <count>   Warm-up packet count (default: 1000)\n"
         "  -n, --no-warmup        Skip warm-up phase\n"
-        "  -b, --benchmark        Enable benchmark mode (stats every 5s)\n"
+        "  -b, --benchmark        Enable benchmark mode (stats every 5s, in-process;\n"
+        "                         live stats without this: bbo_stat -s <shm>)\n"
         "  -h, --help             Show this help\n"
         "\n"
         "Example:\n"
         "  sudo %s -l 14 -a 0000:09:00.0 -- -p 0 -u 5000 -c 14\n"
+        "  sudo %s -l 14-17 -a 0000:09:00.0 -- -Q 4 -S port -P 5000,5001,5002,5003\n"
+        "  sudo %s -l 14 --no-pci --no-huge -m 512 -- -d af_xdp -i eth1 -q 3 -u 5000\n"
         "\n",
-        prog, prog);
+        prog, ultra_ll::RxBackendConfig{}.busy_poll_us, ultra_ll::BURST_SIZE, ultra_ll::RX_RING_SIZE, ultra_ll::MBUF_POOL_SIZE,
+        ultra_ll::MBUF_CACHE_SIZE, ultra_ll::MAX_ROUTES,
+        ultra_ll::JournalConfig{}.file_records, prog, prog, prog);
 }
 
 int main(int argc, char *argv[])
@@ -142,9 +271,48 @@ int main(int argc, char *argv[])
         static struct option long_options[] = {
             {"port", required_argument, 0, 'p'},
             {"queue", required_argument, 0, 'q'},
+            {"backend", required_argument, 0, 'd'},
+            {"iface", required_argument, 0, 'i'},
+            {"busy-poll", required_argument, 0, 'o'},
             {"udp-port", required_argument, 0, 'u'},
             {"core", required_argument, 0, 'c'},
             {"shm", required_argument, 0, 's'},
+            {"queues", required_argument, 0, 'Q'},
+            {"steer", required_argument, 0, 'S'},
+            {"queue-ports", required_argument, 0, 'P'},
+            {"shared-ring", no_argument, 0, 'R'},
+            {"hw-filter", no_argument, 0, 'F'},
+            {"flow-mark", no_argument, 0, 'M'},
+            {"mcast-groups", required_argument, 0, 'G'},
+            {"native", no_argument, 0, 'N'},
+            {"batch", no_argument, 0, 'B'},
+            {"simd", optional_argument, 0, 'V'},
+            {"conflate", no_argument, 0, 'C'},
+            {"latency", no_argument, 0, 'L'},
+            {"no-stats", no_argument, 0, 'x'},
+            {"fpga-deltas", no_argument, 0, 'f'},
+            {"hw-timestamps", no_argument, 0, 'T'},
+            {"raw-tsc", no_argument, 0, 'U'},
+            {"wire-seq", no_argument, 0, 'W'},
+            {"ab-feeds", no_argument, 0, 'A'},
+            {"protocol", required_argument, 0, 'X'},
+            {"msg-prefetch", required_argument, 0, 'D'},
+            {"symbols", required_argument, 0, 'Y'},
+            {"instruments", required_argument, 0, 'j'},
+            {"route", required_argument, 0, 'O'},
+            {"journal", required_argument, 0, 'J'},
+            {"journal-core", required_argument, 0, 'k'},
+            {"journal-compress", required_argument, 0, 'Z'},
+            {"tsc-sync", required_argument, 0, 't'},
+            {"replay", required_argument, 0, 'y'},
+            {"replay-speed", required_argument, 0, 'e'},
+            {"replay-live-ts", no_argument, 0, 'E'},
+            {"idle", required_argument, 0, 'I'},
+            {"consumer-core", required_argument, 0, 'K'},
+            {"burst", required_argument, 0, 'z'},
+            {"rx-ring", required_argument, 0, 'r'},
+            {"mbufs", required_argument, 0, 'm'},
+            {"hugepage-dir", required_argument, 0, 'H'},
             {"warmup", required_argument, 0, 'w'},
             {"no-warmup", no_argument, 0, 'n'},
             {"benchmark", no_argument, 0, 'b'},
@@ -153,7 +321,7 @@ int main(int argc, char *argv[])
 
         int opt;
         optind = 1; // Reset getopt
-        while ((opt = getopt_long(opt_argc, opt_argv, "p:q:u:c:s:w:nbh",
+        while ((opt = getopt_long(opt_argc, opt_argv, "p:q:d:i:o:u:c:s:Q:S:P:RFMG:NBV::CLxfTUWAX:D:Y:j:O:J:k:Z:t:y:e:EI:K:z:r:m:H:w:nbh",
                                   long_options, nullptr)) != -1)
         {
             switch (opt)
@@ -173,6 +341,242 @@ int main(int argc, char *argv[])
             case 's':
                 config.shm_name = optarg;
                 break;
+            case 'Q':
+                config.num_queues = static_cast<uint16_t>(std::atoi(optarg));
+                break;
+            case 'd':
+                if (std::strcmp(optarg, "dpdk") == 0)
+                {
+                    config.backend.backend = ultra_ll::RxBackend::DPDK;
+                }
+                else if (std::strcmp(optarg, "af_xdp") == 0)
+                {
+                    config.backend.backend = ultra_ll::RxBackend::XDP;
+                }
+                else if (std::strcmp(optarg, "socket") == 0)
+                {
+                    config.backend.backend = ultra_ll::RxBackend::SOCKET;
+                }
+                else
+                {
+                    std::fprintf(stderr, "Error: Unknown RX backend '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'i':
+                config.backend.iface = optarg;
+                break;
+            case 'o':
+                config.backend.busy_poll_us = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'S':
+                if (std::strcmp(optarg, "rss") == 0)
+                {
+                    config.steering = ultra_ll::SteeringMode::RSS;
+                }
+                else if (std::strcmp(optarg, "port") == 0)
+                {
+                    config.steering = ultra_ll::SteeringMode::UDP_PORT;
+                }
+                else
+                {
+                    std::fprintf(stderr, "Error: Unknown steering mode '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'P':
+                if (parse_queue_ports(optarg, config.queue_udp_ports,
+                                      ultra_ll::MAX_RX_QUEUES) < 0)
+                {
+                    std::fprintf(stderr, "Error: Invalid queue port list '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'R':
+                config.ring_per_queue = false;
+                break;
+            case 'F':
+                config.hw_filter = true;
+                break;
+            case 'M':
+                config.flow_mark = true;
+                break;
+            case 'G':
+            {
+                int n = parse_mcast_groups(optarg, config.mcast_groups,
+                                           ultra_ll::MAX_MCAST_GROUPS);
+                if (n < 0)
+                {
+                    std::fprintf(stderr, "Error: Invalid multicast group list '%s'\n", optarg);
+                    return 1;
+                }
+                config.num_mcast_groups = static_cast<uint8_t>(n);
+                break;
+            }
+            case 'N':
+                config.publish_mode = ultra_ll::PublishMode::NATIVE;
+                break;
+            case 'B':
+                config.batch_publish = true;
+                break;
+            case 'C':
+                config.conflate = true;
+                break;
+            case 'L':
+                config.latency_histograms = true;
+                break;
+            case 'x':
+                config.enable_stats = false;
+                break;
+            case 'f':
+                config.fpga_deltas = true;
+                break;
+            case 'T':
+                config.hw_timestamps = true;
+                break;
+            case 'U':
+                config.raw_tsc = true;
+                break;
+            case 'W':
+                config.wire_seq = true;
+                break;
+            case 'A':
+                config.ab_arbitration = true;
+                config.wire_seq = true;
+                config.num_queues = 2;
+                break;
+            case 'X':
+                if (std::strcmp(optarg, "bbo") == 0)
+                    config.protocol = ultra_ll::FeedProtocol::BBO;
+                else if (std::strcmp(optarg, "itch") == 0)
+                    config.protocol = ultra_ll::FeedProtocol::ITCH;
+                else if (std::strcmp(optarg, "sbe") == 0)
+                    config.protocol = ultra_ll::FeedProtocol::SBE;
+                else
+                {
+                    std::fprintf(stderr, "Error: Unknown protocol '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'D':
+                config.msg_prefetch = static_cast<uint32_t>(std::atoi(optarg));
+                break;
+            case 'Y':
+                config.symbols = optarg;
+                break;
+            case 'j':
+                config.instruments = optarg;
+                break;
+            case 'O':
+            {
+                ultra_ll::RouteConfig route;
+                if (!ultra_ll::parse_route_spec(optarg, route))
+                {
+                    return 1;
+                }
+                config.routes.push_back(route);
+                break;
+            }
+            case 'J':
+            {
+                // <dir>[,<records per file>]
+                config.journal.dir = optarg;
+                const size_t comma = config.journal.dir.find(',');
+                if (comma != std::string::npos)
+                {
+                    config.journal.file_records =
+                        std::strtoull(config.journal.dir.c_str() + comma + 1, nullptr, 10);
+                    config.journal.dir.resize(comma);
+                }
+                break;
+            }
+            case 'k':
+                config.journal.core = std::atoi(optarg);
+                break;
+            case 'Z':
+                config.journal.compress = optarg;
+                break;
+            case 't':
+            {
+                // realtime|phc[,<core>]
+                std::string spec = optarg;
+                const size_t comma = spec.find(',');
+                if (comma != std::string::npos)
+                {
+                    config.tsc_sync.core = std::atoi(spec.c_str() + comma + 1);
+                    spec.resize(comma);
+                }
+                if (spec == "realtime")
+                    config.tsc_sync.reference = ultra_ll::TscReference::REALTIME;
+                else if (spec == "phc")
+                    config.tsc_sync.reference = ultra_ll::TscReference::PHC;
+                else
+                {
+                    std::fprintf(stderr, "Error: Unknown TSC sync reference '%s'\n", spec.c_str());
+                    return 1;
+                }
+                config.tsc_sync.enabled = true;
+                break;
+            }
+            case 'y':
+                config.replay = true;
+                config.replay_file = optarg;
+                break;
+            case 'e':
+                config.replay_speed = std::strtod(optarg, nullptr);
+                break;
+            case 'E':
+                config.replay_live_ts = true;
+                break;
+            case 'H':
+                config.hugepage_dir = optarg;
+                break;
+            case 'K':
+                config.consumer_core = std::atoi(optarg);
+                break;
+            case 'z':
+                config.burst_size = static_cast<uint16_t>(std::atoi(optarg));
+                break;
+            case 'r':
+                config.rx_ring_size = static_cast<uint16_t>(std::atoi(optarg));
+                break;
+            case 'm':
+            {
+                // <pool>[,<cache>]
+                char *end = nullptr;
+                config.mbuf_pool_size = static_cast<uint32_t>(std::strtoul(optarg, &end, 10));
+                if (end && *end == ',')
+                {
+                    config.mbuf_cache_size = static_cast<uint16_t>(std::atoi(end + 1));
+                }
+                break;
+            }
+            case 'I':
+                if (!parse_idle_policy(optarg, config.idle))
+                {
+                    std::fprintf(stderr, "Error: Invalid idle policy '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'V':
+                config.simd_parse = true;
+                if (optarg)
+                {
+                    if (std::strcmp(optarg, "scalar") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::SCALAR;
+                    else if (std::strcmp(optarg, "sse4") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::SSE4;
+                    else if (std::strcmp(optarg, "avx2") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::AVX2;
+                    else if (std::strcmp(optarg, "avx512") == 0)
+                        config.max_simd_isa = ultra_ll::SimdIsa::AVX512;
+                    else
+                    {
+                        std::fprintf(stderr, "Error: Unknown SIMD ISA '%s'\n", optarg);
+                        return 1;
+                    }
+                }
+                break;
             case 'w':
                 warmup_count = std::atoi(optarg);
                 break;
@@ -192,10 +596,88 @@ int main(int argc, char *argv[])
 
     std::printf("=== Ultra Low Latency RX - Project 36 ===\n");
     std::printf("Configuration:\n");
-    std::printf("  DPDK port:    %u\n", config.port_id);
+    if (config.replay)
+    {
+        std::printf("  Replay:       %s (%.2fx%s, %s timestamps)\n", config.replay_file.c_str(),
+                    config.replay_speed,
+                    config.replay_speed == ultra_ll::REPLAY_MAX_SPEED ? " = unpaced" : "",
+                    config.replay_live_ts ? "TSC" : "recorded");
+    }
+    else if (config.backend.backend == ultra_ll::RxBackend::DPDK)
+    {
+        std::printf("  DPDK port:    %u\n", config.port_id);
+    }
+    else
+    {
+        std::printf("  RX backend:   %s on %s (busy poll %u)\n",
+                    ultra_ll::rx_backend_name(config.backend.backend),
+                    config.backend.iface.empty() ? "any interface" : config.backend.iface.c_str(),
+                    config.backend.busy_poll_us);
+    }
     std::printf("  RX queue:     %u\n", config.queue_id);
     std::printf("  UDP port:     %u\n", config.udp_port);
-    std::printf("  Shared mem:   %s\n", config.shm_name.c_str());
+    if (config.protocol == ultra_ll::FeedProtocol::ITCH && config.msg_prefetch)
+    {
+        std::printf("  Protocol:     itch (prefetch %u messages ahead)\n", config.msg_prefetch);
+    }
+    else
+    {
+        std::printf("  Protocol:     %s\n", ultra_ll::feed_protocol_name(config.protocol));
+    }
+    std::printf("  Shared mem:   %s (%s, %s)\n", config.shm_name.c_str(),
+                config.hugepage_dir.empty() ? "/dev/shm" : config.hugepage_dir.c_str(),
+                config.publish_mode == ultra_ll::PublishMode::NATIVE
+                    ? "native BBODataFast" : "gateway::BBOData");
+    std::printf("  RX queues:    %u (%s steering, %s)\n", config.num_queues,
+                config.steering == ultra_ll::SteeringMode::RSS ? "RSS" : "UDP port",
+                config.ring_per_queue ? "ring per queue" : "shared ring");
+    std::printf("  NIC filter:   %s%s (%u multicast groups)\n",
+                config.hw_filter ? "rte_flow" : "software",
+                config.flow_mark ? ", flow mark" : "", config.num_mcast_groups);
+    std::printf("  RX sizing:    burst %u, %u descriptors, %u mbufs (cache %u)\n",
+                config.burst_size, config.rx_ring_size, config.mbuf_pool_size,
+                config.mbuf_cache_size);
+    std::printf("  Latency hist: %s\n", config.latency_histograms ? "enabled" : "disabled");
+    std::printf("  FPGA deltas:  %s\n", config.fpga_deltas ? "enabled" : "disabled");
+    std::printf("  Timestamps:   %s (TSC epoch: %s)\n",
+                config.raw_tsc ? "raw TSC cycles"
+                : config.hw_timestamps ? "NIC RX (TSC fallback)" : "TSC",
+                config.tsc_sync.enabled
+                    ? ultra_ll::tsc_reference_name(config.tsc_sync.reference)
+                    : "startup fit");
+    if (config.idle.spin_polls)
+    {
+        std::printf("  Idle:         backoff after %u polls, %u pause, %u us monitor\n",
+                    config.idle.spin_polls, config.idle.pause_polls, config.idle.monitor_us);
+    }
+    else
+    {
+        std::printf("  Idle:         busy-spin\n");
+    }
+    std::printf("  Symbols:      %s\n", config.symbols.empty() ? "all" : config.symbols.c_str());
+    std::printf("  Instruments:  %s\n",
+                config.instruments.empty()
+                    ? (config.routes.empty() ? "disabled" : "dynamic (routes)")
+                    : config.instruments.c_str());
+    for (const auto &route : config.routes)
+    {
+        std::printf("  Route:        %s (%s, %s)\n", route.name.c_str(),
+                    ultra_ll::route_policy_name(route.policy),
+                    route.symbols.empty() ? "all symbols" : route.symbols.c_str());
+    }
+    if (config.journal.dir.empty())
+    {
+        std::printf("  Journal:      disabled\n");
+    }
+    else
+    {
+        std::printf("  Journal:      %s (%lu records per file, writer core %d%s%s)\n",
+                    config.journal.dir.c_str(), config.journal.file_records, config.journal.core,
+                    config.journal.compress.empty() ? "" : ", compress: ",
+                    config.journal.compress.c_str());
+    }
+    std::printf("  Wire seq:     %s\n", config.ab_arbitration ? "A/B arbitration (queues 0/1)"
+                                         : config.wire_seq ? "gap detection" : "disabled");
     std::printf("  Warm-up:      %s (%d packets)\n",
                 skip_warmup ? "disabled" : "enabled", warmup_count);
     std::printf("  Benchmark:    %s\n", benchmark_mode ? "enabled" : "disabled");
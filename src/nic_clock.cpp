@@ -0,0 +1,228 @@
+#include "nic_clock.h"
+#include <rte_ethdev.h>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace ultra_ll {
+
+namespace {
+
+constexpr int SAMPLE_TRIES = 16;                // Keep the tightest bracket
+constexpr int CALIBRATION_US = 10000;           // 10ms, same as TSCCalibrator
+constexpr uint32_t SLEEP_SLICE_MS = 10;         // stop() latency, TSC epoch check
+
+bool same_epoch(const TscEpoch& a, const TscEpoch& b) {
+    return a.tsc_base == b.tsc_base && a.ns_base == b.ns_base && a.scale.mult == b.scale.mult;
+}
+
+}  // namespace
+
+NicClock::~NicClock() {
+    stop();
+}
+
+bool NicClock::init(uint16_t port_id, const TSCCalibrator& tsc) {
+    port_id_ = port_id;
+    tsc_ = &tsc;
+
+    int offset = -1;
+    uint64_t flag = 0;
+    if (rte_mbuf_dyn_rx_timestamp_register(&offset, &flag) != 0) {
+        std::fprintf(stderr, "Warning: Failed to register RX timestamp mbuf field\n");
+        return false;
+    }
+
+    // Two clock pairs 10ms apart give the device clock rate against TSC
+    uint64_t ticks0, ns0, ticks1, ns1;
+    if (!sample(ticks0, ns0)) {
+        std::fprintf(stderr, "Warning: Port %u cannot read its device clock\n", port_id);
+        return false;
+    }
+    usleep(CALIBRATION_US);
+    if (!sample(ticks1, ns1) || ticks1 <= ticks0) {
+        std::fprintf(stderr, "Warning: Port %u device clock is not running\n", port_id);
+        return false;
+    }
+
+    field_offset_ = offset;
+    const double ns_per_tick =
+        static_cast<double>(ns1 - ns0) / static_cast<double>(ticks1 - ticks0);
+    shift_ = TscScale::from_rate(ns_per_tick).shift;
+    publish(ticks1, ns1, ns_per_tick);
+    last_ticks_ = ticks1;
+    last_ns_ = ns1;
+
+    // PTP hardware clock, if the PMD has one (comparison only)
+    if (rte_eth_timesync_enable(port_id) == 0) {
+        has_phc_ = read_phc_offset(phc_offset_ns_);
+    }
+
+    rx_flag_ = flag;
+
+    std::printf("Port %u: RX hardware timestamps, device clock %.3f MHz%s\n",
+                port_id, 1000.0 / ns_per_tick, has_phc_ ? ", PHC correlated" : "");
+    return true;
+}
+
+bool NicClock::init_replay(uint64_t base_ns) {
+    int offset = -1;
+    uint64_t flag = 0;
+    if (rte_mbuf_dyn_rx_timestamp_register(&offset, &flag) != 0) {
+        std::fprintf(stderr, "Error: Failed to register RX timestamp mbuf field\n");
+        return false;
+    }
+
+    field_offset_ = offset;
+    shift_ = TscScale::from_rate(1.0).shift;    // mult = 2^shift: exactly 1:1
+    publish(base_ns, base_ns, 1.0);
+    replay_ = true;
+    rx_flag_ = flag;
+    return true;
+}
+
+void NicClock::start(uint32_t interval_ms, int64_t step_ns, int core) {
+    if (!enabled() || replay_ || interval_ms == 0) {
+        return;
+    }
+    interval_ms_ = interval_ms;
+    step_ns_ = step_ns;
+    core_ = core;
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+    std::printf("Port %u: device clock re-fit every %u ms and on each TSC epoch\n",
+                port_id_, interval_ms_);
+}
+
+void NicClock::stop() {
+    if (running_.exchange(false, std::memory_order_relaxed)) {
+        thread_.join();
+    }
+}
+
+void NicClock::run() {
+    // Off the isolated poll cores: wakes once per slice
+    if (core_ >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(core_, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            std::fprintf(stderr, "Warning: Failed to pin the NIC clock re-fit to core %d\n",
+                         core_);
+        }
+    }
+
+    TscEpoch seen = tsc_->epoch();
+    while (running_.load(std::memory_order_relaxed)) {
+        // Every interval, or as soon as TscSync moved the TSC mapping
+        for (uint32_t slept = 0; slept < interval_ms_ &&
+                                 running_.load(std::memory_order_relaxed);
+             slept += SLEEP_SLICE_MS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_SLICE_MS));
+            if (!same_epoch(seen, tsc_->epoch())) {
+                break;
+            }
+        }
+        seen = tsc_->epoch();
+        if (running_.load(std::memory_order_relaxed)) {
+            refit();
+        }
+    }
+}
+
+void NicClock::refit() {
+    uint64_t ticks, ns;
+    if (!sample(ticks, ns) || ticks <= last_ticks_) {
+        return;
+    }
+
+    const TscEpoch current = map_.load();
+    double ns_per_tick = current.scale.rate();
+    const uint64_t mapped = map(ticks);
+    const int64_t offset = static_cast<int64_t>(ns - mapped);
+
+    const uint64_t base_ticks = last_ticks_;
+    const uint64_t base_ns = last_ns_;
+    last_ticks_ = ticks;
+    last_ns_ = ns;
+
+    if (offset > step_ns_ || offset < -step_ns_) {
+        // TSC epoch stepped (or the device clock was set): re-anchor here,
+        // keep the rate (the baseline spans the step)
+        publish(ticks, ns, ns_per_tick);
+        steps_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // Rate over the last baseline, if long enough to beat the bracket
+        // jitter (epoch-triggered re-fits can follow a periodic one closely)
+        const double baseline_ns = static_cast<double>(ticks - base_ticks) * ns_per_tick;
+        if (baseline_ns >= interval_ms_ * 1e6 / 2) {
+            ns_per_tick = static_cast<double>(static_cast<int64_t>(ns - base_ns)) /
+                          static_cast<double>(ticks - base_ticks);
+        }
+
+        // Continuous at ticks, on the TSC-domain line one interval later
+        const double interval_ticks = interval_ms_ * 1e6 / ns_per_tick;
+        publish(ticks, mapped, ns_per_tick + static_cast<double>(offset) / interval_ticks);
+    }
+    refits_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool NicClock::measure(NicClockDrift& out) const {
+    out = NicClockDrift{};
+    if (!enabled() || replay_) {
+        return false;
+    }
+
+    uint64_t ticks, ns;
+    if (!sample(ticks, ns)) {
+        return false;
+    }
+    out.nic_error_ns = static_cast<int64_t>(map(ticks) - ns);
+
+    int64_t phc_offset;
+    if (has_phc_ && read_phc_offset(phc_offset)) {
+        out.has_phc = true;
+        out.phc_offset_ns = phc_offset;
+        out.phc_drift_ns = phc_offset - phc_offset_ns_;
+    }
+    return true;
+}
+
+bool NicClock::sample(uint64_t& ticks, uint64_t& tsc_ns) const {
+    uint64_t best_width = ~uint64_t{0};
+
+    // Bracket the register read with rdtscp; the narrowest window wins
+    for (int i = 0; i < SAMPLE_TRIES; ++i) {
+        uint64_t clock;
+        const uint64_t before = rdtscp();
+        if (rte_eth_read_clock(port_id_, &clock) != 0) {
+            return false;
+        }
+        const uint64_t after = rdtscp();
+
+        if (after - before < best_width) {
+            best_width = after - before;
+            ticks = clock;
+            tsc_ns = tsc_->tsc_to_ns(before + (after - before) / 2);
+        }
+    }
+    return true;
+}
+
+bool NicClock::read_phc_offset(int64_t& offset_ns) const {
+    timespec ts;
+    const uint64_t before = rdtscp();
+    if (rte_eth_timesync_read_time(port_id_, &ts) != 0) {
+        return false;
+    }
+    const uint64_t after = rdtscp();
+
+    const int64_t phc_ns = static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    offset_ns = phc_ns - static_cast<int64_t>(tsc_->tsc_to_ns(before + (after - before) / 2));
+    return true;
+}
+
+}  // namespace ultra_ll
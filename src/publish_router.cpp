@@ -0,0 +1,121 @@
+#include "publish_router.h"
+#include <cstdio>
+
+namespace ultra_ll {
+
+bool parse_route_spec(const std::string& spec, RouteConfig& route) {
+    const size_t name_end = spec.find(':');
+    route.name = spec.substr(0, name_end);
+    route.policy = RoutePolicy::DROP;
+    route.symbols.clear();
+
+    if (route.name.empty()) {
+        std::fprintf(stderr, "Error: Route '%s' has no name\n", spec.c_str());
+        return false;
+    }
+    if (name_end == std::string::npos) {
+        return true;
+    }
+
+    const size_t policy_end = spec.find(':', name_end + 1);
+    const std::string policy = spec.substr(name_end + 1, policy_end - name_end - 1);
+    if (policy == "conflate") {
+        route.policy = RoutePolicy::CONFLATE;
+    } else if (!policy.empty() && policy != "drop") {
+        std::fprintf(stderr, "Error: Unknown route policy '%s' (drop | conflate)\n",
+                     policy.c_str());
+        return false;
+    }
+    if (policy_end != std::string::npos) {
+        route.symbols = spec.substr(policy_end + 1);
+    }
+    return true;
+}
+
+bool RouteTable::init(const std::vector<RouteConfig>& routes, int numa_node) {
+    if (routes.size() > MAX_ROUTES) {
+        std::fprintf(stderr, "Error: %zu routes exceed the limit (%u)\n",
+                     routes.size(), MAX_ROUTES);
+        return false;
+    }
+    routes_ = routes;
+    for (uint8_t i = 0; i < size(); ++i) {
+        if (!filters_[i].load(routes_[i].symbols, numa_node)) {
+            std::fprintf(stderr, "Error: Bad symbol list for route '%s'\n",
+                         routes_[i].name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t RouteTable::resolve(const BBODataFast& bbo) noexcept {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < size(); ++i) {
+        if (!filters_[i].enabled() || filters_[i].contains(bbo.symbol)) {
+            mask |= 1u << i;
+        }
+    }
+    if (bbo.instrument_id != InstrumentMap::NONE) {
+        masks_[bbo.instrument_id].store(static_cast<uint16_t>(mask | RESOLVED),
+                                        std::memory_order_relaxed);
+    }
+    return mask;
+}
+
+PublishRouter::PublishRouter(RouteTable& table, int numa_node)
+    : table_(table), numa_node_(numa_node) {
+}
+
+void PublishRouter::attach(uint8_t route, BboFastRing* ring) {
+    lanes_[route].ring = ring;
+    if (table_.route(route).policy == RoutePolicy::CONFLATE && !conflation_storage_[route]) {
+        conflation_storage_[route] = std::make_unique<DefaultConflationCache>(numa_node_);
+        lanes_[route].conflation = conflation_storage_[route].get();
+    }
+}
+
+void PublishRouter::flush() noexcept {
+    uint32_t pending = backlog_;
+    while (pending != 0) {
+        const unsigned i = static_cast<unsigned>(__builtin_ctz(pending));
+        pending &= pending - 1;
+
+        RouteLane& lane = lanes_[i];
+        BboFastRing& ring = *lane.ring;
+        const uint32_t flushed = lane.conflation->flush([&ring](const BBODataFast& bbo) {
+            BBODataFast* slot = ring.claim();
+            if (slot == nullptr) {
+                return false;
+            }
+            *slot = bbo;
+            ring.commit();
+            return true;
+        });
+        if (flushed > 0) {
+            lane.flushed.add(flushed);
+        }
+        if (!lane.conflation->has_dirty()) {
+            backlog_ &= ~(1u << i);
+        }
+    }
+}
+
+void PublishRouter::warm_cache() noexcept {
+    for (uint8_t i = 0; i < size(); ++i) {
+        if (lanes_[i].conflation) {
+            lanes_[i].conflation->warm_cache();
+        }
+    }
+}
+
+void PublishRouter::reset_stats() noexcept {
+    for (uint8_t i = 0; i < size(); ++i) {
+        lanes_[i].published.reset();
+        lanes_[i].dropped.reset();
+        lanes_[i].conflated.reset();
+        lanes_[i].flushed.reset();
+    }
+}
+
+}  // namespace ultra_ll
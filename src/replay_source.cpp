@@ -0,0 +1,255 @@
+#include "replay_source.h"
+#include "feed_arbiter.h"
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ultra_ll {
+
+namespace {
+
+struct PcapFileHeader {
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+};
+
+struct PcapRecordHeader {
+    uint32_t ts_sec;
+    uint32_t ts_frac;
+    uint32_t incl_len;
+    uint32_t orig_len;
+};
+
+constexpr uint32_t PCAP_MAGIC_US = 0xA1B2C3D4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xA1B23C4D;
+constexpr uint32_t PCAP_LINKTYPE_ETHERNET = 1;
+
+constexpr size_t HEADERS_SIZE = sizeof(rte_ether_hdr) + sizeof(rte_ipv4_hdr) + sizeof(rte_udp_hdr);
+
+// Journal price back to wire ticks (exact: the parser multiplied a u32)
+uint32_t to_raw(FloatPrice::type price) noexcept {
+    return static_cast<uint32_t>(std::llround(price / PRICE_MULTIPLIER));
+}
+uint32_t to_raw(TickPrice::type price) noexcept {
+    return price;
+}
+
+void put_be32(uint8_t* p, uint32_t v) noexcept {
+    const uint32_t be = __builtin_bswap32(v);
+    std::memcpy(p, &be, sizeof(be));
+}
+
+}  // namespace
+
+ReplaySource::~ReplaySource() {
+    if (map_ != nullptr) {
+        munmap(const_cast<uint8_t*>(map_), size_);
+    }
+}
+
+bool ReplaySource::open(const std::string& path, uint16_t udp_port, bool wire_seq) {
+    path_ = path;
+    udp_port_ = udp_port;
+    wire_seq_ = wire_seq;
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::fprintf(stderr, "Error: Cannot open replay file '%s': %s\n",
+                     path.c_str(), std::strerror(errno));
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(PcapFileHeader))) {
+        std::fprintf(stderr, "Error: Replay file '%s' is empty or unreadable\n", path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    void* ptr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        std::fprintf(stderr, "Error: Cannot map replay file '%s': %s\n",
+                     path.c_str(), std::strerror(errno));
+        return false;
+    }
+    // One forward pass: aggressive readahead, pages dropped behind us
+    madvise(ptr, size_, MADV_SEQUENTIAL);
+    map_ = static_cast<const uint8_t*>(ptr);
+
+    uint64_t magic;
+    std::memcpy(&magic, map_, sizeof(magic));
+    if (magic == JournalFileHeader::MAGIC) {
+        format_ = Format::JOURNAL;
+        return open_journal();
+    }
+    format_ = Format::PCAP;
+    return open_pcap();
+}
+
+bool ReplaySource::open_pcap() {
+    PcapFileHeader fh;
+    std::memcpy(&fh, map_, sizeof(fh));
+
+    swapped_ = (fh.magic == __builtin_bswap32(PCAP_MAGIC_US) ||
+                fh.magic == __builtin_bswap32(PCAP_MAGIC_NS));
+    const uint32_t magic = swapped_ ? __builtin_bswap32(fh.magic) : fh.magic;
+    const uint32_t linktype = swapped_ ? __builtin_bswap32(fh.linktype) : fh.linktype;
+    if (magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS) {
+        std::fprintf(stderr, "Error: '%s' is neither a tick journal nor a classic pcap "
+                     "(pcapng and compressed journals unsupported)\n", path_.c_str());
+        return false;
+    }
+    if (linktype != PCAP_LINKTYPE_ETHERNET) {
+        std::fprintf(stderr, "Error: '%s' link type %u is not Ethernet\n", path_.c_str(), linktype);
+        return false;
+    }
+
+    ts_scale_ = (magic == PCAP_MAGIC_NS) ? 1 : 1000;
+    offset_ = sizeof(PcapFileHeader);
+    std::printf("Replay: %s (pcap, %s timestamps, %zu MB)\n", path_.c_str(),
+                ts_scale_ == 1 ? "ns" : "us", size_ >> 20);
+    return true;
+}
+
+bool ReplaySource::open_journal() {
+    JournalFileHeader fh;
+    if (size_ < sizeof(fh)) {
+        std::fprintf(stderr, "Error: Journal '%s' is truncated\n", path_.c_str());
+        return false;
+    }
+    std::memcpy(&fh, map_, sizeof(fh));
+    if (!fh.is_valid()) {
+        std::fprintf(stderr, "Error: Journal '%s' was written with %s prices "
+                     "(rebuild with the same BBO_TICK_PRICES)\n", path_.c_str(),
+                     fh.tick_prices ? "tick" : "float");
+        return false;
+    }
+
+    // The header count lags by up to one sync period if the writer died:
+    // take every valid record the file holds past it
+    const uint64_t in_file = (size_ - sizeof(fh)) / sizeof(JournalRecord);
+    const auto* records = reinterpret_cast<const JournalRecord*>(map_ + sizeof(fh));
+    records_ = fh.records < in_file ? fh.records : in_file;
+    while (records_ < in_file && records[records_].valid) {
+        ++records_;
+    }
+
+    offset_ = sizeof(fh);
+    std::printf("Replay: %s (journal, queue %u, file %u, %lu records)\n", path_.c_str(),
+                fh.queue_id, fh.file_index, records_);
+    return true;
+}
+
+void ReplaySource::rewind() noexcept {
+    offset_ = (format_ == Format::JOURNAL) ? sizeof(JournalFileHeader) : sizeof(PcapFileHeader);
+    position_ = 0;
+}
+
+bool ReplaySource::next(Frame& out) noexcept {
+    const bool ok = (format_ == Format::JOURNAL) ? next_journal(out) : next_pcap(out);
+    if (ok) {
+        ++position_;
+    }
+    return ok;
+}
+
+bool ReplaySource::next_pcap(Frame& out) noexcept {
+    if (size_ - offset_ < sizeof(PcapRecordHeader)) {
+        return false;
+    }
+    PcapRecordHeader rh;
+    std::memcpy(&rh, map_ + offset_, sizeof(rh));
+    if (swapped_) {
+        rh.ts_sec = __builtin_bswap32(rh.ts_sec);
+        rh.ts_frac = __builtin_bswap32(rh.ts_frac);
+        rh.incl_len = __builtin_bswap32(rh.incl_len);
+    }
+    const size_t begin = offset_ + sizeof(rh);
+    if (size_ - begin < rh.incl_len) {
+        std::fprintf(stderr, "Warning: '%s' ends in a truncated record\n", path_.c_str());
+        offset_ = size_;
+        return false;
+    }
+
+    out.data = map_ + begin;
+    out.len = rh.incl_len;
+    out.ts_ns = static_cast<uint64_t>(rh.ts_sec) * 1000000000ULL +
+                static_cast<uint64_t>(rh.ts_frac) * ts_scale_;
+    offset_ = begin + rh.incl_len;
+    return true;
+}
+
+bool ReplaySource::next_journal(Frame& out) noexcept {
+    if (position_ >= records_) {
+        return false;
+    }
+    JournalRecord rec;
+    std::memcpy(&rec, map_ + offset_, sizeof(rec));
+    offset_ += sizeof(rec);
+
+    const size_t prefix = wire_seq_ ? WIRE_SEQ_SIZE : 0;
+    const size_t bbo_len = (rec.flags & BboFlags::HAS_FPGA_TIMESTAMPS) ? BBO_FULL_SIZE
+                                                                      : BBO_MIN_SIZE;
+    const size_t udp_len = sizeof(rte_udp_hdr) + prefix + bbo_len;
+    static_assert(HEADERS_SIZE + WIRE_SEQ_SIZE + BBO_FULL_SIZE <= sizeof(frame_),
+                  "frame_ too small for a rebuilt BBO frame");
+
+    // Headers are rewritten in full: the length fields vary per record
+    std::memset(frame_, 0, HEADERS_SIZE);
+    auto* eth = reinterpret_cast<rte_ether_hdr*>(frame_);
+    eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+    auto* ip = reinterpret_cast<rte_ipv4_hdr*>(frame_ + sizeof(rte_ether_hdr));
+    ip->version_ihl = 0x45;
+    ip->time_to_live = 64;
+    ip->total_length = rte_cpu_to_be_16(static_cast<uint16_t>(sizeof(rte_ipv4_hdr) + udp_len));
+    ip->next_proto_id = IPPROTO_UDP;
+
+    auto* udp = reinterpret_cast<rte_udp_hdr*>(frame_ + sizeof(rte_ether_hdr) +
+                                               sizeof(rte_ipv4_hdr));
+    udp->dst_port = rte_cpu_to_be_16(udp_port_);
+    udp->dgram_len = rte_cpu_to_be_16(static_cast<uint16_t>(udp_len));
+
+    uint8_t* payload = frame_ + HEADERS_SIZE;
+    if (wire_seq_) {
+        // Recorded sequence was the wire sequence: arbitration sees it again
+        const uint64_t be = __builtin_bswap64(static_cast<uint64_t>(rec.sequence));
+        std::memcpy(payload, &be, sizeof(be));
+        payload += WIRE_SEQ_SIZE;
+    }
+
+    const uint32_t bid = to_raw(rec.bid_price);
+    const uint32_t ask = to_raw(rec.ask_price);
+    std::memcpy(payload + SYMBOL_OFFSET, rec.symbol, sizeof(rec.symbol));
+    put_be32(payload + BID_PRICE_OFFSET, bid);
+    put_be32(payload + BID_SHARES_OFFSET, rec.bid_shares);
+    put_be32(payload + ASK_PRICE_OFFSET, ask);
+    put_be32(payload + ASK_SHARES_OFFSET, rec.ask_shares);
+    put_be32(payload + SPREAD_OFFSET, ask - bid);
+    if (bbo_len == BBO_FULL_SIZE) {
+        for (int i = 0; i < 4; ++i) {
+            put_be32(payload + T1_OFFSET + 4 * i, rec.fpga_t[i]);
+        }
+    }
+
+    out.data = frame_;
+    out.len = static_cast<uint32_t>(HEADERS_SIZE + prefix + bbo_len);
+    out.ts_ns = rec.timestamp_ns;
+    return true;
+}
+
+}  // namespace ultra_ll
@@ -0,0 +1,168 @@
+#include "rx_backend.h"
+#include "numa_util.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+namespace ultra_ll {
+
+namespace {
+
+#ifndef SO_PREFER_BUSY_POLL
+constexpr int SO_PREFER_BUSY_POLL = 69;     // Linux 5.11
+#endif
+
+bool set_int_option(int fd, int level, int name, int value) {
+    return setsockopt(fd, level, name, &value, sizeof(value)) == 0;
+}
+
+}  // namespace
+
+int iface_numa_node(const std::string& iface) {
+    const std::string path = "/sys/class/net/" + iface + "/device/numa_node";
+    FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) {
+        return NUMA_NODE_ANY;       // Virtual interface (veth, lo): no device
+    }
+    int node = NUMA_NODE_ANY;
+    if (std::fscanf(f, "%d", &node) != 1) {
+        node = NUMA_NODE_ANY;
+    }
+    std::fclose(f);
+    return node;
+}
+
+SocketRx::~SocketRx() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    for (uint16_t i = 0; i < available_; ++i) {
+        rte_pktmbuf_free(reserve_[i]);
+    }
+}
+
+bool SocketRx::open(const RxBackendConfig& config, uint16_t udp_port,
+                    const uint32_t* mcast_groups, uint8_t num_mcast_groups,
+                    rte_mempool* pool) {
+    pool_ = pool;
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd_ < 0) {
+        std::fprintf(stderr, "Error: Cannot create UDP socket: %s\n", std::strerror(errno));
+        return false;
+    }
+
+    // Queues on one port share it through the kernel's flow hash
+    if (!set_int_option(fd_, SOL_SOCKET, SO_REUSEPORT, 1)) {
+        std::fprintf(stderr, "Error: SO_REUSEPORT failed: %s\n", std::strerror(errno));
+        return false;
+    }
+    const int rcvbuf = static_cast<int>(config.rcvbuf);
+    if (!set_int_option(fd_, SOL_SOCKET, SO_RCVBUFFORCE, rcvbuf) &&
+        !set_int_option(fd_, SOL_SOCKET, SO_RCVBUF, rcvbuf)) {
+        std::fprintf(stderr, "Warning: Cannot set a %u-byte receive buffer\n", config.rcvbuf);
+    }
+    if (config.busy_poll_us > 0) {
+        if (!set_int_option(fd_, SOL_SOCKET, SO_BUSY_POLL,
+                            static_cast<int>(config.busy_poll_us))) {
+            std::fprintf(stderr, "Warning: SO_BUSY_POLL %u us refused (%s): "
+                         "recvmmsg() will not poll the driver\n",
+                         config.busy_poll_us, std::strerror(errno));
+        }
+        // Best effort: keeps NAPI off the softirq while the loop polls
+        set_int_option(fd_, SOL_SOCKET, SO_PREFER_BUSY_POLL, 1);
+    }
+
+    unsigned ifindex = 0;
+    if (!config.iface.empty()) {
+        ifindex = if_nametoindex(config.iface.c_str());
+        if (ifindex == 0) {
+            std::fprintf(stderr, "Error: Unknown interface '%s'\n", config.iface.c_str());
+            return false;
+        }
+        if (setsockopt(fd_, SOL_SOCKET, SO_BINDTODEVICE, config.iface.c_str(),
+                       static_cast<socklen_t>(config.iface.size())) != 0) {
+            std::fprintf(stderr, "Warning: Cannot bind the socket to %s (%s), "
+                         "receiving on every interface\n",
+                         config.iface.c_str(), std::strerror(errno));
+        }
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(udp_port);
+    if (bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::fprintf(stderr, "Error: Cannot bind UDP port %u: %s\n", udp_port,
+                     std::strerror(errno));
+        return false;
+    }
+
+    for (uint8_t g = 0; g < num_mcast_groups; ++g) {
+        ip_mreqn mreq{};
+        mreq.imr_multiaddr.s_addr = mcast_groups[g];
+        mreq.imr_ifindex = static_cast<int>(ifindex);
+        if (setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            char group[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &mcast_groups[g], group, sizeof(group));
+            std::fprintf(stderr, "Error: Cannot join multicast group %s: %s\n", group,
+                         std::strerror(errno));
+            return false;
+        }
+    }
+
+    // What extract_payload() checks; MACs and addresses stay zero
+    auto* eth = reinterpret_cast<rte_ether_hdr*>(header_);
+    eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+    auto* ip = reinterpret_cast<rte_ipv4_hdr*>(eth + 1);
+    ip->version_ihl = 0x45;
+    ip->time_to_live = 64;
+    ip->next_proto_id = IPPROTO_UDP;
+    auto* udp = reinterpret_cast<rte_udp_hdr*>(ip + 1);
+    udp->dst_port = rte_cpu_to_be_16(udp_port);
+
+    refill(0);
+    if (available_ == 0) {
+        std::fprintf(stderr, "Error: No mbufs for the socket receive reserve\n");
+        return false;
+    }
+    return true;
+}
+
+void SocketRx::attach(uint16_t slot, rte_mbuf* m) noexcept {
+    reserve_[slot] = m;
+    iov_[slot].iov_base = rte_pktmbuf_mtod_offset(m, uint8_t*, HEADERS_SIZE);
+    iov_[slot].iov_len = rte_pktmbuf_tailroom(m) - HEADERS_SIZE;
+    msgs_[slot].msg_hdr = {};
+    msgs_[slot].msg_hdr.msg_iov = &iov_[slot];
+    msgs_[slot].msg_hdr.msg_iovlen = 1;
+}
+
+void SocketRx::refill(uint16_t used) noexcept {
+    // Slots [used, available_) still hold mbufs; [0, used) and the tail need new ones
+    const uint16_t missing = static_cast<uint16_t>(used + (MAX_BURST - available_));
+    rte_mbuf* fresh[MAX_BURST];
+    if (likely(rte_pktmbuf_alloc_bulk(pool_, fresh, missing) == 0)) {
+        uint16_t f = 0;
+        for (uint16_t i = 0; i < used; ++i) {
+            attach(i, fresh[f++]);
+        }
+        for (uint16_t i = available_; i < MAX_BURST; ++i) {
+            attach(i, fresh[f++]);
+        }
+        available_ = MAX_BURST;
+        return;
+    }
+
+    // Pool dry (mbufs held downstream): keep the filled slots contiguous
+    for (uint16_t i = used; i < available_; ++i) {
+        attach(static_cast<uint16_t>(i - used), reserve_[i]);
+    }
+    available_ = static_cast<uint16_t>(available_ - used);
+}
+
+}  // namespace ultra_ll
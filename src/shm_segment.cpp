@@ -0,0 +1,87 @@
+#include "shm_segment.h"
+#include "likely.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+namespace ultra_ll {
+
+namespace {
+
+constexpr long HUGETLBFS_MAGIC_NUM = 0x958458f6;
+
+}  // namespace
+
+bool ShmBacking::init(const std::string& hugepage_dir) {
+    dir_.clear();
+    page_size_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (hugepage_dir.empty()) {
+        return true;
+    }
+
+    struct statfs fs;
+    if (statfs(hugepage_dir.c_str(), &fs) != 0) {
+        std::fprintf(stderr, "Error: Cannot stat hugepage dir '%s': %s\n",
+                     hugepage_dir.c_str(), std::strerror(errno));
+        return false;
+    }
+    if (fs.f_type != HUGETLBFS_MAGIC_NUM) {
+        std::fprintf(stderr, "Error: '%s' is not a hugetlbfs mount\n", hugepage_dir.c_str());
+        return false;
+    }
+
+    // hugetlbfs reports its page size (2M or 1G, per mount) as block size
+    dir_ = hugepage_dir;
+    page_size_ = static_cast<size_t>(fs.f_bsize);
+    std::printf("Shared memory rings on %s (%zu KB pages)\n",
+                dir_.c_str(), page_size_ / 1024);
+    return true;
+}
+
+std::string ShmBacking::path(const std::string& shm_name) const {
+    return hugepages() ? dir_ + shm_name : "/dev/shm" + shm_name;
+}
+
+int ShmBacking::open(const std::string& shm_name, int flags) const {
+    if (!hugepages()) {
+        return shm_open(shm_name.c_str(), flags, 0666);
+    }
+    return ::open(path(shm_name).c_str(), flags, 0666);
+}
+
+void ShmBacking::unlink(const std::string& shm_name) const {
+    if (!hugepages()) {
+        shm_unlink(shm_name.c_str());
+        return;
+    }
+    ::unlink(path(shm_name).c_str());
+}
+
+bool ShmBacking::prefault_and_lock(void* addr, size_t bytes, size_t page_size, bool write) {
+    auto* p = static_cast<volatile uint8_t*>(addr);
+    for (size_t off = 0; off < bytes; off += page_size) {
+        if (write) {
+            p[off] = 0;
+        } else {
+            (void)p[off];
+        }
+    }
+
+    // Keep the pages resident even without mlockall()
+    return mlock(addr, bytes) == 0;
+}
+
+void ShmBacking::touch(const void* addr, size_t bytes, size_t page_size) {
+    auto* p = static_cast<const volatile uint8_t*>(addr);
+    for (size_t off = 0; off < bytes; off += page_size) {
+        (void)p[off];
+    }
+    compiler_barrier();
+}
+
+}  // namespace ultra_ll
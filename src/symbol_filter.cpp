@@ -0,0 +1,174 @@
+#include "symbol_filter.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace ultra_ll {
+
+namespace {
+
+constexpr int SEEDS_PER_SIZE = 64;
+
+// splitmix64: multiplier candidates, deterministic across runs
+uint64_t next_multiplier(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (z ^ (z >> 31)) | 1;
+}
+
+bool is_separator(char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool parse_list(const char* p, const char* end, std::vector<uint64_t>& keys) {
+    while (p < end) {
+        if (*p == '#') {
+            while (p < end && *p != '\n') {
+                ++p;
+            }
+            continue;
+        }
+        if (is_separator(*p)) {
+            ++p;
+            continue;
+        }
+        const char* start = p;
+        while (p < end && !is_separator(*p) && *p != '#') {
+            ++p;
+        }
+        const size_t len = static_cast<size_t>(p - start);
+        if (len > 8) {
+            std::fprintf(stderr, "Error: Invalid symbol '%.*s' (1-8 characters)\n",
+                         static_cast<int>(len), start);
+            return false;
+        }
+        keys.push_back(SymbolFilter::key_of(start, len));
+    }
+    return true;
+}
+
+}  // namespace
+
+bool parse_symbol_spec(const std::string& spec, std::vector<uint64_t>& keys) {
+    if (spec.empty() || spec[0] != '@') {
+        return parse_list(spec.data(), spec.data() + spec.size(), keys);
+    }
+
+    const char* path = spec.c_str() + 1;
+    FILE* f = std::fopen(path, "r");
+    if (!f) {
+        std::fprintf(stderr, "Error: Cannot open symbol file '%s'\n", path);
+        return false;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+        text.append(buf, n);
+    }
+    std::fclose(f);
+
+    return parse_list(text.data(), text.data() + text.size(), keys);
+}
+
+SymbolFilter::~SymbolFilter() {
+    release();
+}
+
+void SymbolFilter::release() {
+    std::free(buckets_);
+    buckets_ = nullptr;
+    mask_ = 0;
+    size_ = 0;
+}
+
+bool SymbolFilter::add(const char* name, size_t len) {
+    if (len == 0 || len > 8) {
+        std::fprintf(stderr, "Error: Invalid symbol '%.*s' (1-8 characters)\n",
+                     static_cast<int>(len), name);
+        return false;
+    }
+    staged_.push_back(key_of(name, len));
+    return true;
+}
+
+bool SymbolFilter::load(const std::string& spec, int numa_node) {
+    if (spec.empty()) {
+        return true;
+    }
+    return parse_symbol_spec(spec, staged_) && build(numa_node);
+}
+
+bool SymbolFilter::place(uint64_t* table, size_t buckets, uint64_t multiplier,
+                         int shift) const {
+    std::memset(table, 0, buckets * 64);
+    for (uint64_t key : staged_) {
+        uint64_t* slot = table + bucket_of(key, multiplier, shift) * BUCKET_SLOTS;
+        size_t i = 0;
+        while (i < BUCKET_SLOTS && slot[i] != 0) {
+            ++i;
+        }
+        if (i == BUCKET_SLOTS) {
+            return false;       // Bucket overflow: try another multiplier
+        }
+        slot[i] = key;
+    }
+    return true;
+}
+
+bool SymbolFilter::build(int numa_node) {
+    release();
+
+    std::sort(staged_.begin(), staged_.end());
+    staged_.erase(std::unique(staged_.begin(), staged_.end()), staged_.end());
+    if (staged_.empty()) {
+        std::fprintf(stderr, "Error: Empty symbol subscription list\n");
+        return false;
+    }
+    if (staged_.size() > MAX_SYMBOLS) {
+        std::fprintf(stderr, "Error: %zu symbols exceed the filter limit (%zu)\n",
+                     staged_.size(), MAX_SYMBOLS);
+        return false;
+    }
+
+    // Start at ~50% slot load (>= 2 buckets keeps the shift below 64)
+    size_t buckets = 2;
+    while (buckets * BUCKET_SLOTS < staged_.size() * 2) {
+        buckets *= 2;
+    }
+
+    uint64_t state = 0x5EED;
+    for (;;) {
+        // Page aligned for mbind (numa_prefer)
+        const size_t bytes = (buckets * 64 + NUMA_PAGE_SIZE - 1) & ~(NUMA_PAGE_SIZE - 1);
+        auto* table = static_cast<uint64_t*>(std::aligned_alloc(NUMA_PAGE_SIZE, bytes));
+        if (!table) {
+            std::fprintf(stderr, "Error: Failed to allocate symbol filter (%zu buckets)\n",
+                         buckets);
+            return false;
+        }
+        numa_prefer(table, bytes, numa_node);     // Before place() first-touches it
+        const int shift = 64 - __builtin_ctzll(buckets);
+        for (int attempt = 0; attempt < SEEDS_PER_SIZE; ++attempt) {
+            const uint64_t multiplier = next_multiplier(state);
+            if (place(table, buckets, multiplier, shift)) {
+                buckets_ = table;
+                multiplier_ = multiplier;
+                shift_ = shift;
+                mask_ = buckets - 1;
+                size_ = staged_.size();
+                staged_.clear();
+                staged_.shrink_to_fit();
+                std::printf("Symbol filter: %zu symbols, %zu buckets (%zu KB, %d multiplier tries)\n",
+                            size_, buckets, table_bytes() / 1024, attempt + 1);
+                return true;
+            }
+        }
+        std::free(table);
+        buckets *= 2;
+    }
+}
+
+}  // namespace ultra_ll
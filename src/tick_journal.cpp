@@ -0,0 +1,265 @@
+#include "tick_journal.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace ultra_ll {
+
+namespace {
+
+constexpr size_t HEADER_BYTES = sizeof(JournalFileHeader);
+
+uint64_t monotonic_ms() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+}
+
+uint64_t unix_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+size_t file_bytes(uint64_t records) {
+    return HEADER_BYTES + static_cast<size_t>(records) * sizeof(JournalRecord);
+}
+
+}  // namespace
+
+JournalWriter::JournalWriter(const JournalConfig& config, std::string shm_name, double tsc_ghz)
+    : config_(config), shm_name_(std::move(shm_name)), tsc_ghz_(tsc_ghz) {
+}
+
+JournalWriter::~JournalWriter() {
+    stop();
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        close_file(queues_[i], false);      // start() failed part way
+    }
+}
+
+void JournalWriter::add_queue(uint16_t queue_id, DefaultJournalRing* ring) {
+    // A/B lines share one ring: journal it once
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (queues_[i].ring == ring) {
+            return;
+        }
+    }
+    queues_[num_queues_].queue_id = queue_id;
+    queues_[num_queues_].ring = ring;
+    ++num_queues_;
+}
+
+bool JournalWriter::start() {
+    if (config_.file_records == 0) {
+        std::fprintf(stderr, "Error: Journal files need at least one record\n");
+        return false;
+    }
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        if (!open_file(queues_[i])) {
+            return false;
+        }
+    }
+
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+    std::printf("Journal: %u queue(s) -> %s (%lu records per file%s%s)\n", num_queues_,
+                config_.dir.c_str(), config_.file_records,
+                config_.compress.empty() ? "" : ", compress: ",
+                config_.compress.c_str());
+    return true;
+}
+
+void JournalWriter::stop() {
+    if (running_.exchange(false, std::memory_order_relaxed)) {
+        thread_.join();
+    }
+}
+
+void JournalWriter::run() {
+    // Off the isolated poll cores: page cache, msync and fsync run here
+    if (config_.core >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(config_.core, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            std::fprintf(stderr, "Warning: Failed to pin journal writer to core %d\n",
+                         config_.core);
+        }
+    }
+
+    uint64_t last_sync = monotonic_ms();
+    while (running_.load(std::memory_order_relaxed)) {
+        size_t drained = 0;
+        for (uint16_t i = 0; i < num_queues_; ++i) {
+            drained += drain(queues_[i]);
+        }
+
+        const uint64_t now = monotonic_ms();
+        if (now - last_sync >= config_.sync_ms) {
+            for (uint16_t i = 0; i < num_queues_; ++i) {
+                sync_file(queues_[i], false);
+            }
+            reap_children(false);
+            last_sync = now;
+        }
+
+        if (drained == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    // Poll loops have stopped: whatever is published is final
+    for (uint16_t i = 0; i < num_queues_; ++i) {
+        while (drain(queues_[i]) > 0) {
+        }
+        close_file(queues_[i], false);
+    }
+    reap_children(true);
+}
+
+size_t JournalWriter::drain(QueueFile& f) {
+    if (f.records == nullptr) {
+        return 0;       // Rotation failed: the ring fills and counts drops
+    }
+
+    // Straight from the ring into the file mapping
+    const size_t n = f.ring->drain(f.records + f.count,
+                                   static_cast<size_t>(config_.file_records - f.count));
+    f.count += n;
+    records_.fetch_add(n, std::memory_order_relaxed);
+
+    if (f.count == config_.file_records) {
+        close_file(f, true);
+        ++f.index;
+        open_file(f);
+    }
+    return n;
+}
+
+bool JournalWriter::open_file(QueueFile& f) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "_q%u_%06u.bbj", f.queue_id, f.index);
+    f.path = config_.dir + "/" + shm_name_ + name;
+
+    f.fd = ::open(f.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (f.fd < 0) {
+        std::fprintf(stderr, "Error: Cannot create journal '%s': %s\n",
+                     f.path.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    // Reserve the blocks up front: no allocation while ticks stream in
+    const size_t bytes = file_bytes(config_.file_records);
+    const int err = posix_fallocate(f.fd, 0, static_cast<off_t>(bytes));
+    if (err != 0) {
+        std::fprintf(stderr, "Error: Cannot preallocate %zu MB for '%s': %s\n",
+                     bytes >> 20, f.path.c_str(), std::strerror(err));
+        ::close(f.fd);
+        f.fd = -1;
+        return false;
+    }
+
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, f.fd, 0);
+    if (ptr == MAP_FAILED) {
+        std::fprintf(stderr, "Error: Cannot map journal '%s': %s\n",
+                     f.path.c_str(), std::strerror(errno));
+        ::close(f.fd);
+        f.fd = -1;
+        return false;
+    }
+    madvise(ptr, bytes, MADV_SEQUENTIAL);
+
+    f.header = static_cast<JournalFileHeader*>(ptr);
+    std::memset(f.header, 0, HEADER_BYTES);
+    f.header->magic = JournalFileHeader::MAGIC;
+    f.header->record_size = sizeof(JournalRecord);
+    f.header->tick_prices = std::is_same_v<BBOPrice, TickPrice> ? 1 : 0;
+    f.header->queue_id = f.queue_id;
+    f.header->capacity = config_.file_records;
+    f.header->created_unix_ns = unix_ns();
+    f.header->tsc_ghz = tsc_ghz_;
+    f.header->file_index = f.index;
+
+    f.records = reinterpret_cast<JournalRecord*>(static_cast<char*>(ptr) + HEADER_BYTES);
+    f.count = 0;
+    files_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void JournalWriter::sync_file(QueueFile& f, bool wait) {
+    if (f.header == nullptr) {
+        return;
+    }
+    f.header->records = f.count;
+    msync(f.header, file_bytes(f.count), wait ? MS_SYNC : MS_ASYNC);
+}
+
+void JournalWriter::close_file(QueueFile& f, bool rotated) {
+    if (f.header == nullptr) {
+        return;
+    }
+    sync_file(f, true);
+    munmap(f.header, file_bytes(config_.file_records));
+    f.header = nullptr;
+    f.records = nullptr;
+
+    // Drop the unused preallocation, make the size durable
+    if (ftruncate(f.fd, static_cast<off_t>(file_bytes(f.count))) != 0 || fsync(f.fd) != 0) {
+        std::fprintf(stderr, "Warning: journal '%s' may be incomplete: %s\n",
+                     f.path.c_str(), std::strerror(errno));
+    }
+    ::close(f.fd);
+    f.fd = -1;
+
+    if (f.count == 0 && !rotated) {
+        ::unlink(f.path.c_str());
+        return;
+    }
+    std::printf("Journal: closed %s (%lu records)\n", f.path.c_str(), f.count);
+    if (!config_.compress.empty()) {
+        compress(f.path);
+    }
+}
+
+void JournalWriter::compress(const std::string& path) {
+    // "<compress> <file>" through the shell, so the option can carry flags
+    const std::string script = "exec " + config_.compress + " \"$0\"";
+    char* const argv[] = {const_cast<char*>("/bin/sh"), const_cast<char*>("-c"),
+                          const_cast<char*>(script.c_str()), const_cast<char*>(path.c_str()),
+                          nullptr};
+    pid_t pid;
+    const int err = posix_spawn(&pid, "/bin/sh", nullptr, nullptr, argv, environ);
+    if (err != 0) {
+        std::fprintf(stderr, "Warning: Cannot run '%s' on %s: %s\n",
+                     config_.compress.c_str(), path.c_str(), std::strerror(err));
+        return;
+    }
+    ++children_;
+}
+
+void JournalWriter::reap_children(bool wait) {
+    while (children_ > 0) {
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, wait ? 0 : WNOHANG);
+        if (pid <= 0) {
+            return;
+        }
+        --children_;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::fprintf(stderr, "Warning: journal compression (pid %d) failed\n", pid);
+        }
+    }
+}
+
+}  // namespace ultra_ll
@@ -0,0 +1,224 @@
+#include "tsc_sync.h"
+#include <rte_ethdev.h>
+#include <chrono>
+#include <cpuid.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+namespace ultra_ll {
+
+namespace {
+
+constexpr int SAMPLE_TRIES = 8;                 // Keep the tightest bracket
+constexpr uint32_t SLEEP_SLICE_MS = 10;         // stop() latency
+
+bool cpuinfo_has_flag(const char* flag) {
+    FILE* f = std::fopen("/proc/cpuinfo", "r");
+    if (!f) {
+        return false;
+    }
+    char line[4096];
+    bool found = false;
+    while (!found && std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "flags", 5) != 0) {
+            continue;
+        }
+        // Space-delimited: match whole words only
+        const size_t len = std::strlen(flag);
+        for (const char* p = std::strstr(line, flag); p; p = std::strstr(p + 1, flag)) {
+            if (p[-1] == ' ' && (p[len] == ' ' || p[len] == '\n' || p[len] == '\0')) {
+                found = true;
+                break;
+            }
+        }
+        break;      // Every CPU lists the same flags
+    }
+    std::fclose(f);
+    return found;
+}
+
+}  // namespace
+
+TscFeatures detect_tsc_features() {
+    TscFeatures f{};
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        f.invariant = (edx & (1u << 8)) != 0;
+    }
+    if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)) {
+        f.rdtscp = (edx & (1u << 27)) != 0;
+    }
+    // Not a CPUID bit: the kernel derives it from family/model (and invariant)
+    f.constant = f.invariant || cpuinfo_has_flag("constant_tsc");
+    return f;
+}
+
+TscSync::TscSync(TSCCalibrator& tsc, const TscSyncConfig& config, uint16_t phc_port)
+    : tsc_(tsc), config_(config), phc_port_(phc_port) {
+    window_.reserve(config_.window);
+}
+
+TscSync::~TscSync() {
+    stop();
+}
+
+bool TscSync::sync_once() {
+    if (config_.window < 2 || config_.interval_ms == 0) {
+        std::fprintf(stderr, "Error: TSC sync needs a window of at least 2 samples "
+                     "and a non-zero interval\n");
+        return false;
+    }
+    if (config_.reference == TscReference::PHC && rte_eth_timesync_enable(phc_port_) != 0) {
+        std::fprintf(stderr, "Error: Port %u has no PTP hardware clock for TSC sync\n",
+                     phc_port_);
+        return false;
+    }
+
+    Sample first;
+    if (!sample(first)) {
+        std::fprintf(stderr, "Error: Cannot read the %s clock for TSC sync\n",
+                     tsc_reference_name(config_.reference));
+        return false;
+    }
+    update(first);      // PHC (TAI) vs the CLOCK_REALTIME anchor: steps here
+    return true;
+}
+
+void TscSync::start() {
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+    std::printf("TSC sync: following %s, %u ms interval, %u-sample window\n",
+                tsc_reference_name(config_.reference), config_.interval_ms, config_.window);
+}
+
+void TscSync::stop() {
+    if (running_.exchange(false, std::memory_order_relaxed)) {
+        thread_.join();
+    }
+}
+
+void TscSync::run() {
+    // Off the isolated poll cores: wakes once per interval
+    if (config_.core >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(config_.core, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            std::fprintf(stderr, "Warning: Failed to pin TSC sync to core %d\n", config_.core);
+        }
+    }
+
+    while (running_.load(std::memory_order_relaxed)) {
+        for (uint32_t slept = 0; slept < config_.interval_ms &&
+                                 running_.load(std::memory_order_relaxed);
+             slept += SLEEP_SLICE_MS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_SLICE_MS));
+        }
+
+        Sample s;
+        if (running_.load(std::memory_order_relaxed) && sample(s)) {
+            update(s);
+        }
+    }
+}
+
+bool TscSync::sample(Sample& out) const {
+    if (config_.reference == TscReference::REALTIME) {
+        TSCCalibrator::sample_realtime(out.tsc, out.ns);
+        return true;
+    }
+
+    uint64_t best_width = ~uint64_t{0};
+    for (int i = 0; i < SAMPLE_TRIES; ++i) {
+        timespec ts;
+        const uint64_t before = rdtscp();
+        if (rte_eth_timesync_read_time(phc_port_, &ts) != 0) {
+            return false;
+        }
+        const uint64_t after = rdtscp();
+        if (after - before < best_width) {
+            best_width = after - before;
+            out.tsc = before + (after - before) / 2;
+            out.ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+                     static_cast<uint64_t>(ts.tv_nsec);
+        }
+    }
+    return true;
+}
+
+void TscSync::update(const Sample& s) {
+    const TscEpoch current = tsc_.epoch();
+    const uint64_t mapped = tsc_.tsc_to_ns(s.tsc);
+    const int64_t offset = static_cast<int64_t>(s.ns - mapped);
+    offset_ns_.store(offset, std::memory_order_relaxed);
+
+    if (offset > config_.step_ns || offset < -config_.step_ns) {
+        // Reference was set (or first PHC fit): jump, refit from here
+        window_.clear();
+        window_.push_back(s);
+        next_ = 0;
+        tsc_.publish_epoch(s.tsc, s.ns, current.scale.rate());
+        steps_.fetch_add(1, std::memory_order_relaxed);
+        updates_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (window_.size() < config_.window) {
+        window_.push_back(s);
+    } else {
+        window_[next_] = s;
+        next_ = (next_ + 1) % config_.window;
+    }
+
+    double ns_per_cycle, error_ns;
+    if (!fit(s.tsc, mapped, ns_per_cycle, error_ns)) {
+        return;     // One sample: no rate yet
+    }
+
+    // Continuous at s.tsc, on the fitted line one interval later
+    const double interval_cycles = config_.interval_ms * 1e6 / ns_per_cycle;
+    tsc_.publish_epoch(s.tsc, mapped, ns_per_cycle + error_ns / interval_cycles);
+
+    rate_ppm_.store((ns_per_cycle / tsc_.get_ns_per_cycle() - 1.0) * 1e6,
+                    std::memory_order_relaxed);
+    updates_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TscSync::fit(uint64_t tsc, uint64_t mapped, double& ns_per_cycle, double& error_ns) const {
+    const size_t n = window_.size();
+    if (n < 2) {
+        return false;
+    }
+
+    // Relative to one sample: epoch ns do not fit a double's mantissa
+    const Sample& origin = window_[next_ % n];
+    double sx = 0, sy = 0;
+    for (const Sample& s : window_) {
+        sx += static_cast<double>(static_cast<int64_t>(s.tsc - origin.tsc));
+        sy += static_cast<double>(static_cast<int64_t>(s.ns - origin.ns));
+    }
+    const double mx = sx / n;
+    const double my = sy / n;
+
+    double sxx = 0, sxy = 0;
+    for (const Sample& s : window_) {
+        const double dx = static_cast<double>(static_cast<int64_t>(s.tsc - origin.tsc)) - mx;
+        const double dy = static_cast<double>(static_cast<int64_t>(s.ns - origin.ns)) - my;
+        sxx += dx * dx;
+        sxy += dx * dy;
+    }
+    if (sxx <= 0) {
+        return false;
+    }
+
+    ns_per_cycle = sxy / sxx;
+    const double dx = static_cast<double>(static_cast<int64_t>(tsc - origin.tsc)) - mx;
+    error_ns = static_cast<double>(static_cast<int64_t>(origin.ns - mapped)) +
+               my + ns_per_cycle * dx;
+    return true;
+}
+
+}  // namespace ultra_ll